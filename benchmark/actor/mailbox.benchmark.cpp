@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Two actors sending a message back and forth, like a tile and its worker.
+class Pong;
+
+class Ping {
+public:
+    Ping(ActorRef<Ping>) {}
+
+    void start(ActorRef<Pong> pong_, int64_t count_, std::promise<void>* done_) {
+        pong.emplace(std::move(pong_));
+        remaining = count_;
+        done = done_;
+        send();
+    }
+
+    void receive(int64_t) {
+        if (--remaining == 0) {
+            done->set_value();
+        } else {
+            send();
+        }
+    }
+
+private:
+    void send();
+
+    optional<ActorRef<Pong>> pong;
+    int64_t remaining = 0;
+    std::promise<void>* done = nullptr;
+};
+
+class Pong {
+public:
+    Pong(ActorRef<Pong>, ActorRef<Ping> ping_) : ping(std::move(ping_)) {}
+
+    void receive(int64_t value) {
+        ping.invoke(&Ping::receive, value);
+    }
+
+private:
+    ActorRef<Ping> ping;
+};
+
+void Ping::send() {
+    pong->invoke(&Pong::receive, remaining);
+}
+
+// A single actor receiving messages from several threads at once.
+class Sink {
+public:
+    Sink(ActorRef<Sink>, std::atomic<int64_t>& remaining_, std::promise<void>& done_)
+        : remaining(remaining_), done(done_) {
+    }
+
+    void receive(std::unique_ptr<int64_t>) {
+        if (--remaining == 0) {
+            done.set_value();
+        }
+    }
+
+private:
+    std::atomic<int64_t>& remaining;
+    std::promise<void>& done;
+};
+
+} // end namespace
+
+static void Actor_MailboxRoundTrip(::benchmark::State& state) {
+    const int64_t roundTrips = 1000;
+
+    ThreadPool pool { 2 };
+    Actor<Ping> ping(pool);
+    Actor<Pong> pong(pool, ping.self());
+
+    while (state.KeepRunning()) {
+        std::promise<void> done;
+        ping.invoke(&Ping::start, pong.self(), roundTrips, &done);
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * roundTrips);
+}
+
+static void Actor_MailboxContention(::benchmark::State& state) {
+    const auto producerCount = state.range_x();
+    const int64_t messageCount = 10000;
+
+    ThreadPool pool { 1 };
+
+    while (state.KeepRunning()) {
+        std::atomic<int64_t> remaining { producerCount * messageCount };
+        std::promise<void> done;
+        Actor<Sink> sink(pool, std::ref(remaining), std::ref(done));
+
+        std::vector<std::thread> producers;
+        for (int64_t i = 0; i < producerCount; ++i) {
+            producers.emplace_back([&] {
+                ActorRef<Sink> ref = sink.self();
+                for (int64_t m = 0; m < messageCount; ++m) {
+                    ref.invoke(&Sink::receive, std::make_unique<int64_t>(m));
+                }
+            });
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * producerCount * messageCount);
+}
+
+BENCHMARK(Actor_MailboxRoundTrip);
+BENCHMARK(Actor_MailboxContention)->Arg(1)->Arg(4)->Arg(8);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Mimics many tile workers receiving small messages at once: each actor counts the
+// messages it received and signals once all actors are done.
+class Counter {
+public:
+    Counter(ActorRef<Counter>, std::atomic<int64_t>& remaining_, std::promise<void>& done_)
+        : remaining(remaining_), done(done_) {
+    }
+
+    void receive(int64_t) {
+        if (--remaining == 0) {
+            done.set_value();
+        }
+    }
+
+private:
+    std::atomic<int64_t>& remaining;
+    std::promise<void>& done;
+};
+
+template <class Pool>
+void mailboxThroughput(::benchmark::State& state) {
+    const auto actorCount = state.range_x();
+    const int64_t messageCount = 100;
+
+    Pool pool { 4 };
+
+    while (state.KeepRunning()) {
+        std::atomic<int64_t> remaining { actorCount * messageCount };
+        std::promise<void> done;
+
+        std::vector<std::unique_ptr<Actor<Counter>>> actors;
+        actors.reserve(actorCount);
+        for (int64_t i = 0; i < actorCount; ++i) {
+            actors.push_back(std::make_unique<Actor<Counter>>(pool, std::ref(remaining), std::ref(done)));
+        }
+
+        for (int64_t m = 0; m < messageCount; ++m) {
+            for (auto& actor : actors) {
+                actor->invoke(&Counter::receive, m);
+            }
+        }
+
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * actorCount * messageCount);
+}
+
+} // end namespace
+
+static void Actor_ThreadPool(::benchmark::State& state) {
+    mailboxThroughput<ThreadPool>(state);
+}
+
+static void Actor_WorkStealingThreadPool(::benchmark::State& state) {
+    mailboxThroughput<WorkStealingThreadPool>(state);
+}
+
+BENCHMARK(Actor_ThreadPool)->Arg(16)->Arg(256);
+BENCHMARK(Actor_WorkStealingThreadPool)->Arg(16)->Arg(256);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+class RenderBenchmark {
+public:
+    RenderBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        fileSource.setAccessToken("foobar");
+
+        map.setStyleJSON(util::read_file("benchmark/fixtures/api/query_style.json"));
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 15); // Manhattan
+
+        // Load everything up front, so that the benchmarks only measure rendering.
+        mbgl::benchmark::render(map, view);
+    }
+
+    // Renders a still and starts reading it back, without waiting for the readback.
+    void renderStill(std::size_t& images) {
+        bool rendered = false;
+        map.renderStill(view, [&](std::exception_ptr) {
+            view.readStillImage([&](PremultipliedImage) {
+                images++;
+            });
+            rendered = true;
+        });
+
+        while (!rendered) {
+            util::RunLoop::Get()->runOnce();
+        }
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.size, 1, fileSource, threadPool, MapMode::Still };
+};
+
+} // end namespace
+
+static void API_renderStill(::benchmark::State& state) {
+    RenderBenchmark bench;
+
+    while (state.KeepRunning()) {
+        mbgl::benchmark::render(bench.map, bench.view);
+    }
+}
+
+static void API_renderStillAsyncReadback(::benchmark::State& state) {
+    RenderBenchmark bench;
+
+    std::size_t images = 0;
+    while (state.KeepRunning()) {
+        bench.renderStill(images);
+    }
+    bench.view.flushStillImages();
+}
+
+BENCHMARK(API_renderStill);
+BENCHMARK(API_renderStillAsyncReadback);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/gl.hpp>
+#include <mbgl/programs/fill_program.hpp>
+#include <mbgl/util/color.hpp>
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// A grid of quads, split into segments of equal size, drawn with the fill program.
+class DrawBenchmark {
+public:
+    DrawBenchmark(std::size_t segmentCount) {
+        view.bind();
+
+        gl::VertexVector<FillVertex> vertices;
+        gl::IndexVector<gl::Triangles> triangles;
+
+        for (std::size_t s = 0; s < segmentCount; ++s) {
+            segments.emplace_back(vertices.vertexSize(), triangles.indexSize());
+            auto& segment = segments.back();
+
+            for (uint16_t q = 0; q < quadsPerSegment; ++q) {
+                const int16_t x = q * 8;
+                const int16_t y = s * 8;
+                const uint16_t index = segment.vertexLength;
+                vertices.emplace_back(FillAttributes::vertex({ x, y }));
+                vertices.emplace_back(FillAttributes::vertex({ int16_t(x + 4), y }));
+                vertices.emplace_back(FillAttributes::vertex({ x, int16_t(y + 4) }));
+                vertices.emplace_back(FillAttributes::vertex({ int16_t(x + 4), int16_t(y + 4) }));
+                triangles.emplace_back(index, index + 1, index + 2);
+                triangles.emplace_back(index + 1, index + 2, index + 3);
+                segment.vertexLength += 4;
+                segment.indexLength += 6;
+            }
+        }
+
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+
+        matrix::ortho(matrix, 0, view.size.width, view.size.height, 0, 0, 1);
+    }
+
+    void draw(float opacity) {
+        program.draw(
+            context,
+            gl::Triangles(),
+            gl::DepthMode::disabled(),
+            gl::StencilMode::disabled(),
+            gl::ColorMode::alphaBlended(),
+            FillUniforms::Values {
+                uniforms::u_matrix::Value{ matrix },
+                uniforms::u_opacity::Value{ opacity },
+                uniforms::u_color::Value{ Color::red() },
+                uniforms::u_outline_color::Value{ Color::black() },
+                uniforms::u_world::Value{ view.size },
+            },
+            *vertexBuffer,
+            *indexBuffer,
+            segments
+        );
+    }
+
+    static constexpr uint16_t quadsPerSegment = 64;
+
+    HeadlessBackend backend;
+    gl::Context& context = backend.getContext();
+    OffscreenView view{ context, { 512, 512 } };
+    FillProgram program{ context, ProgramParameters() };
+
+    mat4 matrix;
+    optional<gl::VertexBuffer<FillVertex>> vertexBuffer;
+    optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
+    gl::SegmentVector<FillAttributes> segments;
+};
+
+} // end namespace
+
+// Submits draws with range_x() segments each. When range_y() is set, the opacity changes with
+// every draw, so that one uniform is uploaded per draw; otherwise no uniforms are uploaded
+// after the first draw.
+static void GL_drawSegments(::benchmark::State& state) {
+    DrawBenchmark bench(state.range_x());
+    const bool changeUniforms = state.range_y();
+
+    std::size_t draws = 0;
+    while (state.KeepRunning()) {
+        bench.draw(changeUniforms && draws % 2 ? 0.5f : 1.0f);
+        draws++;
+    }
+
+    // Don't let queued GPU work spill into the next benchmark.
+    MBGL_CHECK_ERROR(glFinish());
+
+    state.SetItemsProcessed(state.iterations() * state.range_x());
+}
+
+BENCHMARK(GL_drawSegments)
+    ->ArgPair(1, 0)
+    ->ArgPair(1, 1)
+    ->ArgPair(16, 0)
+    ->ArgPair(16, 1)
+    ->ArgPair(256, 0)
+    ->ArgPair(256, 1);
@@ -2,6 +2,7 @@
 
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
@@ -39,3 +40,128 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
 
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+
+namespace {
+
+// Filters modeled after the road, landuse and POI layers of a streets style.
+const char* streetsFilters[] = {
+    R"FILTER(["all", ["==", "$type", "LineString"], ["all", ["!in", "structure", "bridge", "tunnel"], ["in", "class", "motorway", "trunk", "primary"]]])FILTER",
+    R"FILTER(["all", ["==", "$type", "LineString"], ["all", ["==", "structure", "tunnel"], ["in", "class", "street", "street_limited", "service", "track"]]])FILTER",
+    R"FILTER(["all", ["==", "$type", "Polygon"], ["in", "class", "park", "cemetery", "hospital", "school", "pitch", "industrial", "parking", "grass", "wood", "scrub", "sand", "glacier", "rock"]])FILTER",
+    R"FILTER(["all", ["==", "$type", "Point"], ["<=", "scalerank", 2], ["!in", "maki", "campsite", "cemetery", "dog-park", "garden", "golf", "park", "picnic-site", "playground", "zoo"]])FILTER",
+    R"FILTER(["any", ["has", "oneway"], ["in", "class", "ferry", "path", "pedestrian"]])FILTER",
+};
+
+// A layer of synthetic road/landuse/POI features with an interned key table, like a
+// decoded vector tile layer.
+class StreetsFeature : public GeometryTileFeature {
+public:
+    FeatureType type;
+    std::vector<std::pair<uint32_t, Value>> properties;
+    const std::unordered_map<std::string, uint32_t>* keysMap;
+
+    FeatureType getType() const override { return type; }
+    GeometryCollection getGeometries() const override { return {}; }
+
+    optional<Value> getValue(const std::string& key) const override {
+        auto it = keysMap->find(key);
+        if (it == keysMap->end()) {
+            return {};
+        }
+        return getIndexedValue(it->second);
+    }
+
+    optional<Value> getIndexedValue(uint32_t key) const override {
+        for (const auto& property : properties) {
+            if (property.first == key) {
+                return property.second;
+            }
+        }
+        return {};
+    }
+};
+
+class StreetsLayer : public GeometryTileLayer {
+public:
+    StreetsLayer() {
+        const char* classes[] = { "motorway", "trunk", "primary", "street", "service", "path", "park", "wood", "parking" };
+        const char* structures[] = { "none", "bridge", "tunnel" };
+        const char* makis[] = { "cafe", "park", "bank", "zoo", "restaurant" };
+        for (const char* key : { "class", "structure", "oneway", "scalerank", "maki", "name", "ref", "type" }) {
+            keysMap.emplace(key, keysMap.size());
+        }
+
+        for (uint32_t i = 0; i < 1000; ++i) {
+            StreetsFeature feature;
+            feature.type = static_cast<FeatureType>(1 + i % 3);
+            feature.keysMap = &keysMap;
+            feature.properties = {
+                { 0, std::string(classes[i % 9]) },
+                { 1, std::string(structures[i % 3]) },
+                { 3, uint64_t(i % 6) },
+                { 4, std::string(makis[i % 5]) },
+                { 5, std::string("Name") },
+                { 6, std::string("A1") },
+            };
+            if (i % 7 == 0) {
+                feature.properties.emplace_back(2, true);
+            }
+            features.push_back(std::move(feature));
+        }
+    }
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StreetsFeature>(features[i]);
+    }
+    std::string getName() const override { return "streets"; }
+    const std::unordered_map<std::string, uint32_t>* getKeysMap() const override { return &keysMap; }
+
+    std::vector<StreetsFeature> features;
+    std::unordered_map<std::string, uint32_t> keysMap;
+};
+
+} // end namespace
+
+static void Parse_EvaluateStreetsFilters(benchmark::State& state) {
+    const StreetsLayer layer;
+    std::vector<style::Filter> filters;
+    for (const char* expression : streetsFilters) {
+        filters.push_back(parse(expression));
+    }
+
+    while (state.KeepRunning()) {
+        std::size_t matches = 0;
+        for (const auto& filter : filters) {
+            for (const auto& feature : layer.features) {
+                matches += filter(feature.getType(), feature.getID(), [&] (const std::string& key) {
+                    return feature.getValue(key);
+                });
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+
+static void Parse_EvaluateCompiledStreetsFilters(benchmark::State& state) {
+    const StreetsLayer layer;
+    std::vector<style::Filter> filters;
+    for (const char* expression : streetsFilters) {
+        filters.push_back(parse(expression));
+    }
+
+    while (state.KeepRunning()) {
+        std::size_t matches = 0;
+        for (const auto& filter : filters) {
+            // Filters are compiled once per tile layer, so include compilation in the timing.
+            const style::CompiledFilter compiled(filter, layer);
+            for (const auto& feature : layer.features) {
+                matches += compiled(feature);
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+
+BENCHMARK(Parse_EvaluateStreetsFilters);
+BENCHMARK(Parse_EvaluateCompiledStreetsFilters);
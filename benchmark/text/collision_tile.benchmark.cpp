@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/text/get_anchors.hpp>
+#include <mbgl/layout/clip_lines.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/style/types.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Boxes are sized the way SymbolLayout sizes them for 16px text: in 24px glyph units, scaled
+// to tile units by the box scale.
+const float tilePixelRatio = float(util::EXTENT) / util::tileSize;
+const float glyphSize = 24.0f;
+const float boxScale = tilePixelRatio * 16 / glyphSize;
+const float padding = 2 * tilePixelRatio;
+const float glyphAdvance = 12.0f;
+
+// Length of the text labelling a feature, in glyphs.
+std::size_t labelLength(const GeometryTileFeature& feature) {
+    auto name = feature.getValue("name");
+    if (name && name->is<std::string>()) {
+        return name->get<std::string>().size();
+    }
+    return 10;
+}
+
+// The labels of a street tile: a label for every point in the label layers, and labels
+// repeated every `spacing` pixels along the roads.
+std::vector<CollisionFeature> labels(const GeometryTileData& data, float spacing) {
+    std::vector<CollisionFeature> features;
+
+    for (const char* name : { "place_label", "poi_label", "water_label", "road_label" }) {
+        const GeometryTileLayer* layer = data.getLayer(name);
+        for (std::size_t i = 0; layer && i < layer->featureCount(); ++i) {
+            auto feature = layer->getFeature(i);
+            const float halfWidth = labelLength(*feature) * glyphAdvance / 2;
+            const IndexedSubfeature indexedFeature { i, name, name, features.size() };
+
+            for (const auto& points : feature->getGeometries()) {
+                for (const auto& point : points) {
+                    const Anchor anchor(point.x, point.y, 0, 0.5f);
+                    features.emplace_back(GeometryCoordinates { point }, anchor,
+                                          -glyphSize / 2, glyphSize / 2, -halfWidth, halfWidth,
+                                          boxScale, padding, style::SymbolPlacementType::Point,
+                                          indexedFeature, false);
+                }
+            }
+        }
+    }
+
+    const GeometryTileLayer* roads = data.getLayer("road");
+    for (std::size_t i = 0; roads && i < roads->featureCount(); ++i) {
+        auto feature = roads->getFeature(i);
+        const float halfWidth = labelLength(*feature) * glyphAdvance / 2;
+        const IndexedSubfeature indexedFeature { i, "road", "road", features.size() };
+
+        for (const auto& line : util::clipLines(feature->getGeometries(), 0, 0, util::EXTENT, util::EXTENT)) {
+            for (const auto& anchor : getAnchors(line, spacing * tilePixelRatio, 45 * util::DEG2RAD,
+                                                 -halfWidth, halfWidth, 0, 0, glyphSize, boxScale, 1)) {
+                features.emplace_back(line, anchor, -glyphSize / 2, glyphSize / 2, -halfWidth, halfWidth,
+                                      boxScale, padding, style::SymbolPlacementType::Line,
+                                      indexedFeature, false);
+            }
+        }
+    }
+
+    return features;
+}
+
+} // end namespace
+
+// Places the labels of a street tile, as GeometryTileWorker::attemptPlacement does, with road
+// labels every range_x() pixels, on a map rotated by range_y() degrees.
+static void Text_placeLabels(::benchmark::State& state) {
+    const VectorTileData data(std::make_shared<const std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    const std::vector<CollisionFeature> features = labels(data, state.range_x());
+    const PlacementConfig config(state.range_y() * M_PI / 180);
+
+    std::size_t placed = 0;
+    while (state.KeepRunning()) {
+        CollisionTile tile(config);
+        std::vector<CollisionFeature> batch = features;
+
+        for (auto& feature : batch) {
+            const float scale = tile.placeFeature(feature, false, false);
+            if (scale < tile.maxScale) {
+                placed++;
+            }
+            tile.insertFeature(feature, scale, false);
+        }
+
+        ::benchmark::DoNotOptimize(tile);
+    }
+
+    state.SetItemsProcessed(state.iterations() * features.size());
+    state.SetLabel(std::to_string(placed / state.iterations()) + " of " +
+                   std::to_string(features.size()) + " placed");
+}
+
+BENCHMARK(Text_placeLabels)
+    ->ArgPair(250, 0)
+    ->ArgPair(250, 30)
+    ->ArgPair(50, 0)
+    ->ArgPair(50, 30);
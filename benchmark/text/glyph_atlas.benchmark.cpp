@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/glyph_set.hpp>
+#include <mbgl/storage/file_source.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class NullFileSource : public FileSource {
+public:
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override {
+        return nullptr;
+    }
+};
+
+const FontStack fontStack { "Open Sans Regular" };
+
+// An atlas with printable ASCII already loaded, shared by all benchmark threads.
+GlyphAtlas& atlas() {
+    static NullFileSource fileSource;
+    static GlyphAtlas* glyphAtlas = [] {
+        auto result = new GlyphAtlas({ 1024, 1024 }, fileSource);
+
+        std::vector<SDFGlyph> glyphs;
+        for (uint32_t id = 32; id < 127; ++id) {
+            SDFGlyph glyph;
+            glyph.id = id;
+            glyph.metrics.width = 10;
+            glyph.metrics.height = 14;
+            glyph.metrics.top = -4;
+            glyph.metrics.advance = 12;
+            glyph.bitmap = std::string((10 + 2 * SDFGlyph::borderSize) * (14 + 2 * SDFGlyph::borderSize), 'x');
+            glyphs.push_back(std::move(glyph));
+        }
+        result->insertGlyphs(fontStack, { 0, 255 }, std::move(glyphs));
+
+        return result;
+    }();
+    return *glyphAtlas;
+}
+
+// The glyphs of a range, e.g. of a CJK font that has all of them.
+std::vector<SDFGlyph> glyphRange(const GlyphRange& range) {
+    std::vector<SDFGlyph> glyphs;
+    for (uint32_t id = range.first; id <= range.second; ++id) {
+        SDFGlyph glyph;
+        glyph.id = id;
+        glyph.metrics.width = 20;
+        glyph.metrics.height = 20;
+        glyph.metrics.top = -4;
+        glyph.metrics.advance = 24;
+        glyph.bitmap = std::string((20 + 2 * SDFGlyph::borderSize) * (20 + 2 * SDFGlyph::borderSize), 'x');
+        glyphs.push_back(std::move(glyph));
+    }
+    return glyphs;
+}
+
+const std::u16string labels[] = {
+    u"Main Street",
+    u"Avenue of the Americas",
+    u"Central Park",
+    u"Brooklyn Bridge",
+    u"Washington Square North",
+};
+
+} // end namespace
+
+// Shapes labels and adds their glyphs to the atlas the way SymbolLayout::prepare does, on
+// several threads at once.
+static void Text_shapeLabels(::benchmark::State& state) {
+    GlyphAtlas& glyphAtlas = atlas();
+    const uintptr_t tileUID = state.thread_index + 1;
+    BiDi bidi;
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(glyphAtlas.hasGlyphRanges(fontStack, { { 0, 255 } }));
+
+        auto glyphSet = glyphAtlas.getGlyphSet(fontStack);
+        for (const auto& label : labels) {
+            GlyphPositions face;
+            Shaping shaping = glyphSet->getShaping(label, 10 * 24, 1.2 * 24, 0.5, 0.5, 0.5, 0,
+                                                   { 0, 0 }, bidi);
+            glyphAtlas.addGlyphs(tileUID, label, fontStack, *glyphSet, face);
+            ::benchmark::DoNotOptimize(shaping);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (sizeof(labels) / sizeof(labels[0])));
+}
+
+BENCHMARK(Text_shapeLabels)->ThreadRange(1, 8)->UseRealTime();
+
+// Loads range_x() ranges into a single font stack, the way a CJK font stack's ranges arrive
+// one glyph PBF at a time.
+static void Text_insertGlyphRanges(::benchmark::State& state) {
+    NullFileSource fileSource;
+
+    std::vector<std::pair<GlyphRange, std::vector<SDFGlyph>>> ranges;
+    for (int i = 0; i < state.range_x(); ++i) {
+        const GlyphRange range(0x4E00 + i * 256, 0x4E00 + i * 256 + 255);
+        ranges.emplace_back(range, glyphRange(range));
+    }
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        GlyphAtlas glyphAtlas({ 1024, 1024 }, fileSource);
+        auto batch = ranges;
+        state.ResumeTiming();
+
+        for (auto& range : batch) {
+            glyphAtlas.insertGlyphs(fontStack, range.first, std::move(range.second));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range_x());
+}
+
+BENCHMARK(Text_insertGlyphRanges)->Arg(1)->Arg(16)->Arg(64);
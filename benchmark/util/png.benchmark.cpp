@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Renders from the test suite, which look like what a render service produces.
+const char* fixtures[] = {
+    "test/fixtures/map/offline/expected.png",
+    "test/fixtures/custom_layer/basic/expected.png",
+    "test/fixtures/annotations/debug_sparse/expected.png",
+    "test/fixtures/annotations/update_fill_style/expected.png",
+    "test/fixtures/annotations/antimeridian_annotation_large/expected.png",
+};
+
+std::vector<PremultipliedImage> loadFixtures() {
+    std::vector<PremultipliedImage> images;
+    for (const char* fixture : fixtures) {
+        images.push_back(decodeImage(util::read_file(fixture)));
+    }
+    return images;
+}
+
+// Arguments are the compression level and the number of threads to encode with; zero
+// threads encodes on the calling thread only.
+void encode(::benchmark::State& state) {
+    const auto images = loadFixtures();
+
+    std::unique_ptr<WorkStealingThreadPool> pool;
+    PNGEncodeOptions options;
+    options.compressionLevel = int(state.range_x());
+    if (state.range_y() > 0) {
+        pool = std::make_unique<WorkStealingThreadPool>(state.range_y());
+        options.scheduler = pool.get();
+    }
+
+    std::size_t inputBytes = 0;
+    std::size_t outputBytes = 0;
+    while (state.KeepRunning()) {
+        for (const auto& image : images) {
+            auto png = encodePNG(image, options);
+            inputBytes += image.bytes();
+            outputBytes += png.size();
+            ::benchmark::DoNotOptimize(png);
+        }
+    }
+
+    state.SetBytesProcessed(inputBytes);
+    state.SetLabel(std::to_string(outputBytes / state.iterations()) + " bytes per run");
+}
+
+} // end namespace
+
+static void Util_encodePNG(::benchmark::State& state) {
+    encode(state);
+}
+
+BENCHMARK(Util_encodePNG)
+    ->ArgPair(1, 0)
+    ->ArgPair(6, 0)
+    ->ArgPair(9, 0)
+    ->ArgPair(6, 2)
+    ->ArgPair(6, 4);
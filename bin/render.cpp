@@ -31,9 +31,11 @@ int main(int argc, char *argv[]) {
     uint32_t pixelRatio = 1;
     uint32_t width = 512;
     uint32_t height = 512;
+    uint32_t metatile = 1;
     static std::string output = "out.png";
     std::string cache_file = "cache.sqlite";
     std::string asset_root = ".";
+    std::string program_cache_dir;
     std::vector<std::string> classes;
     std::string token;
     bool debug = false;
@@ -51,9 +53,11 @@ int main(int argc, char *argv[]) {
         ("ratio,r", po::value(&pixelRatio)->value_name("number")->default_value(pixelRatio), "Image scale factor")
         ("class,c", po::value(&classes)->value_name("name"), "Class name")
         ("token,t", po::value(&token)->value_name("key")->default_value(token), "Mapbox access token")
+        ("metatile,m", po::value(&metatile)->value_name("number")->default_value(metatile), "Render a grid of metatile x metatile images at once")
         ("debug", po::bool_switch(&debug)->default_value(debug), "Debug mode")
         ("output,o", po::value(&output)->value_name("file")->default_value(output), "Output file name")
         ("cache,d", po::value(&cache_file)->value_name("file")->default_value(cache_file), "Cache database file name")
+        ("program-cache", po::value(&program_cache_dir)->value_name("dir"), "Directory in which to cache compiled shader programs")
         ("assets,d", po::value(&asset_root)->value_name("file")->default_value(asset_root), "Directory to which asset:// URLs will resolve")
     ;
 
@@ -66,6 +70,11 @@ int main(int argc, char *argv[]) {
         exit(1);
     }
 
+    if (metatile == 0) {
+        std::cout << "Error: metatile must be at least 1" << std::endl << desc;
+        exit(1);
+    }
+
     using namespace mbgl;
 
     util::RunLoop loop;
@@ -85,9 +94,11 @@ int main(int argc, char *argv[]) {
     }
 
     HeadlessBackend backend;
-    OffscreenView view(backend.getContext(), { width * pixelRatio, height * pixelRatio });
-    ThreadPool threadPool(4);
-    Map map(backend, mbgl::Size { width, height }, pixelRatio, fileSource, threadPool, MapMode::Still);
+    OffscreenView view(backend.getContext(), { metatile * width * pixelRatio, metatile * height * pixelRatio });
+    WorkStealingThreadPool threadPool(4);
+    Map map(backend, mbgl::Size { metatile * width, metatile * height }, pixelRatio, fileSource, threadPool, MapMode::Still,
+            GLContextMode::Unique, ConstrainMode::HeightOnly, ViewportMode::Default,
+            program_cache_dir.empty() ? optional<std::string>() : optional<std::string>(program_cache_dir));
 
     if (util::isURL(style_path)) {
         map.setStyleURL(style_path);
@@ -105,7 +116,7 @@ int main(int argc, char *argv[]) {
         map.setDebug(debug ? mbgl::MapDebugOptions::TileBorders | mbgl::MapDebugOptions::ParseStatus : mbgl::MapDebugOptions::NoDebug);
     }
 
-    map.renderStill(view, [&](std::exception_ptr error) {
+    auto checkError = [] (std::exception_ptr error) {
         try {
             if (error) {
                 std::rethrow_exception(error);
@@ -114,10 +125,29 @@ int main(int argc, char *argv[]) {
             std::cout << "Error: " << e.what() << std::endl;
             exit(1);
         }
-
-        util::write_file(output, encodePNG(view.readStillImage()));
-        loop.stop();
-    });
+    };
+
+    if (metatile == 1) {
+        map.renderStill(view, [&](std::exception_ptr error) {
+            checkError(error);
+            util::write_file(output, encodePNG(view.readStillImage()));
+            loop.stop();
+        });
+    } else {
+        // Tiles are written as <output>_<column>_<row>, keeping the extension.
+        const auto dot = output.rfind('.');
+        const std::string stem = dot == std::string::npos ? output : output.substr(0, dot);
+        const std::string extension = dot == std::string::npos ? "" : output.substr(dot);
+
+        map.renderStillTiles(view, { metatile, metatile }, [&, stem, extension](std::exception_ptr error, std::vector<PremultipliedImage> tiles) {
+            checkError(error);
+            for (uint32_t i = 0; i < tiles.size(); ++i) {
+                util::write_file(stem + "_" + std::to_string(i % metatile) + "_" + std::to_string(i / metatile) + extension,
+                                 encodePNG(tiles[i]));
+            }
+            loop.stop();
+        });
+    }
 
     loop.run();
 
@@ -1,8 +1,16 @@
 # Do not edit. Regenerate this with ./scripts/generate-benchmark-files.sh
 
 set(MBGL_BENCHMARK_FILES
+    # actor
+    benchmark/actor/mailbox.benchmark.cpp
+    benchmark/actor/thread_pool.benchmark.cpp
+
     # api
     benchmark/api/query.benchmark.cpp
+    benchmark/api/render.benchmark.cpp
+
+    # gl
+    benchmark/gl/draw.benchmark.cpp
 
     # include/mbgl
     benchmark/include/mbgl/benchmark.hpp
@@ -17,4 +25,11 @@ set(MBGL_BENCHMARK_FILES
     benchmark/src/mbgl/benchmark/benchmark.cpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
+
+    # text
+    benchmark/text/collision_tile.benchmark.cpp
+    benchmark/text/glyph_atlas.benchmark.cpp
+
+    # util
+    benchmark/util/png.benchmark.cpp
 )
@@ -4,8 +4,11 @@ set(MBGL_CORE_FILES
     # actor
     src/mbgl/actor/actor.hpp
     src/mbgl/actor/actor_ref.hpp
+    src/mbgl/actor/fork_join.cpp
+    src/mbgl/actor/fork_join.hpp
     src/mbgl/actor/mailbox.cpp
     src/mbgl/actor/mailbox.hpp
+    src/mbgl/actor/message.cpp
     src/mbgl/actor/message.hpp
     src/mbgl/actor/scheduler.hpp
 
@@ -56,6 +59,8 @@ set(MBGL_CORE_FILES
     include/mbgl/gl/gl.hpp
     src/mbgl/gl/attribute.cpp
     src/mbgl/gl/attribute.hpp
+    src/mbgl/gl/buffer_arena.cpp
+    src/mbgl/gl/buffer_arena.hpp
     src/mbgl/gl/color_mode.cpp
     src/mbgl/gl/color_mode.hpp
     src/mbgl/gl/context.cpp
@@ -72,8 +77,12 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/index_buffer.hpp
     src/mbgl/gl/object.cpp
     src/mbgl/gl/object.hpp
+    src/mbgl/gl/pixel_buffer.cpp
+    src/mbgl/gl/pixel_buffer.hpp
     src/mbgl/gl/primitives.hpp
     src/mbgl/gl/program.hpp
+    src/mbgl/gl/program_binary_extension.cpp
+    src/mbgl/gl/program_binary_extension.hpp
     src/mbgl/gl/renderbuffer.hpp
     src/mbgl/gl/segment.hpp
     src/mbgl/gl/state.hpp
@@ -105,6 +114,7 @@ set(MBGL_CORE_FILES
     include/mbgl/map/camera.hpp
     include/mbgl/map/map.hpp
     include/mbgl/map/mode.hpp
+    include/mbgl/map/render_stats.hpp
     include/mbgl/map/view.hpp
     src/mbgl/map/backend.cpp
     src/mbgl/map/change.hpp
@@ -129,6 +139,8 @@ set(MBGL_CORE_FILES
 
     # programs
     src/mbgl/programs/attributes.hpp
+    src/mbgl/programs/binary_program.cpp
+    src/mbgl/programs/binary_program.hpp
     src/mbgl/programs/circle_program.cpp
     src/mbgl/programs/circle_program.hpp
     src/mbgl/programs/collision_box_program.cpp
@@ -139,6 +151,7 @@ set(MBGL_CORE_FILES
     src/mbgl/programs/line_program.cpp
     src/mbgl/programs/line_program.hpp
     src/mbgl/programs/program.hpp
+    src/mbgl/programs/program_parameters.cpp
     src/mbgl/programs/program_parameters.hpp
     src/mbgl/programs/programs.hpp
     src/mbgl/programs/raster_program.cpp
@@ -218,6 +231,8 @@ set(MBGL_CORE_FILES
     src/mbgl/style/cascade_parameters.hpp
     src/mbgl/style/class_dictionary.cpp
     src/mbgl/style/class_dictionary.hpp
+    src/mbgl/style/compiled_filter.cpp
+    src/mbgl/style/compiled_filter.hpp
     src/mbgl/style/cross_faded_property_evaluator.cpp
     src/mbgl/style/cross_faded_property_evaluator.hpp
     src/mbgl/style/function.cpp
@@ -316,9 +331,13 @@ set(MBGL_CORE_FILES
     include/mbgl/style/sources/geojson_source.hpp
     include/mbgl/style/sources/raster_source.hpp
     include/mbgl/style/sources/vector_source.hpp
+    src/mbgl/style/sources/geojson_reader.cpp
+    src/mbgl/style/sources/geojson_reader.hpp
     src/mbgl/style/sources/geojson_source.cpp
     src/mbgl/style/sources/geojson_source_impl.cpp
     src/mbgl/style/sources/geojson_source_impl.hpp
+    src/mbgl/style/sources/geojson_source_worker.cpp
+    src/mbgl/style/sources/geojson_source_worker.hpp
     src/mbgl/style/sources/raster_source.cpp
     src/mbgl/style/sources/raster_source_impl.cpp
     src/mbgl/style/sources/raster_source_impl.hpp
@@ -332,6 +351,8 @@ set(MBGL_CORE_FILES
     src/mbgl/text/check_max_angle.hpp
     src/mbgl/text/collision_feature.cpp
     src/mbgl/text/collision_feature.hpp
+    src/mbgl/text/collision_grid.cpp
+    src/mbgl/text/collision_grid.hpp
     src/mbgl/text/collision_tile.cpp
     src/mbgl/text/collision_tile.hpp
     src/mbgl/text/get_anchors.cpp
@@ -376,6 +397,7 @@ set(MBGL_CORE_FILES
     src/mbgl/tile/tile_observer.hpp
     src/mbgl/tile/vector_tile.cpp
     src/mbgl/tile/vector_tile.hpp
+    src/mbgl/tile/vector_tile_data.hpp
 
     # util
     include/mbgl/util/async_request.hpp
@@ -405,6 +427,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/string.hpp
     include/mbgl/util/tileset.hpp
     include/mbgl/util/timer.hpp
+    include/mbgl/util/tracing.hpp
     include/mbgl/util/traits.hpp
     include/mbgl/util/unitbezier.hpp
     include/mbgl/util/util.hpp
@@ -469,6 +492,7 @@ set(MBGL_CORE_FILES
     src/mbgl/util/tile_cover.cpp
     src/mbgl/util/tile_cover.hpp
     src/mbgl/util/token.hpp
+    src/mbgl/util/tracing.cpp
     src/mbgl/util/url.cpp
     src/mbgl/util/url.hpp
     src/mbgl/util/utf.hpp
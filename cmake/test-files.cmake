@@ -4,6 +4,7 @@ set(MBGL_TEST_FILES
     # actor
     test/actor/actor.test.cpp
     test/actor/actor_ref.test.cpp
+    test/actor/fork_join.test.cpp
 
     # algorithm
     test/algorithm/covered_by_children.test.cpp
@@ -21,9 +22,11 @@ set(MBGL_TEST_FILES
 
     # geometry
     test/geometry/binpack.test.cpp
+    test/geometry/feature_index.test.cpp
 
     # gl
     test/gl/bucket.test.cpp
+    test/gl/buffer_arena.test.cpp
     test/gl/object.test.cpp
 
     # include/mbgl
@@ -38,6 +41,9 @@ set(MBGL_TEST_FILES
     test/math/minmax.test.cpp
     test/math/wrap.test.cpp
 
+    # programs
+    test/programs/binary_program.test.cpp
+
     # sprite
     test/sprite/sprite_atlas.test.cpp
     test/sprite/sprite_image.test.cpp
@@ -70,6 +76,9 @@ set(MBGL_TEST_FILES
     test/storage/resource.test.cpp
     test/storage/sqlite.test.cpp
 
+    # style
+    test/style/compiled_filter.test.cpp
+
     # style/conversion
     test/style/conversion/function.test.cpp
     test/style/conversion/geojson_options.test.cpp
@@ -78,6 +87,7 @@ set(MBGL_TEST_FILES
     # style
     test/style/filter.test.cpp
     test/style/functions.test.cpp
+    test/style/geojson_reader.test.cpp
     test/style/group_by_layout.test.cpp
     test/style/paint_property.test.cpp
     test/style/source.test.cpp
@@ -87,6 +97,7 @@ set(MBGL_TEST_FILES
     test/style/tile_source.test.cpp
 
     # text
+    test/text/collision_tile.test.cpp
     test/text/glyph_atlas.test.cpp
     test/text/glyph_pbf.test.cpp
     test/text/quads.test.cpp
@@ -95,6 +106,7 @@ set(MBGL_TEST_FILES
     test/tile/geojson_tile.test.cpp
     test/tile/geometry_tile_data.test.cpp
     test/tile/raster_tile.test.cpp
+    test/tile/tile_cache.test.cpp
     test/tile/tile_coordinate.test.cpp
     test/tile/tile_id.test.cpp
     test/tile/vector_tile.test.cpp
@@ -102,6 +114,7 @@ set(MBGL_TEST_FILES
     # util
     test/util/async_task.test.cpp
     test/util/geo.test.cpp
+    test/util/grid_index.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
     test/util/mapbox.test.cpp
@@ -117,6 +130,7 @@ set(MBGL_TEST_FILES
     test/util/tile_cover.test.cpp
     test/util/timer.test.cpp
     test/util/token.test.cpp
+    test/util/tracing.test.cpp
     test/util/url.test.cpp
     test/util/work_queue.test.cpp
 )
@@ -3,10 +3,12 @@
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/render_stats.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/size.hpp>
+#include <mbgl/util/image.hpp>
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/style/transition_options.hpp>
 
@@ -15,6 +17,7 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace mbgl {
 
@@ -33,6 +36,8 @@ class Layer;
 
 class Map : private util::noncopyable {
 public:
+    // When a program cache directory is given, linked shader programs are stored there and
+    // restored on later runs instead of being compiled again.
     explicit Map(Backend&,
                  Size size,
                  float pixelRatio,
@@ -41,7 +46,8 @@ public:
                  MapMode mapMode = MapMode::Continuous,
                  GLContextMode contextMode = GLContextMode::Unique,
                  ConstrainMode constrainMode = ConstrainMode::HeightOnly,
-                 ViewportMode viewportMode = ViewportMode::Default);
+                 ViewportMode viewportMode = ViewportMode::Default,
+                 const optional<std::string>& programCacheDir = {});
     ~Map();
 
     // Register a callback that will get called (on the render thread) when all resources have
@@ -49,6 +55,14 @@ public:
     using StillImageCallback = std::function<void (std::exception_ptr)>;
     void renderStill(View&, StillImageCallback callback);
 
+    // Renders the map as a metatile: the viewport is split into a grid of equally sized
+    // tiles, which are loaded, laid out and labeled once for the whole metatile, so that
+    // labels are consistent across the tiles' shared edges. The map's size times its pixel
+    // ratio must be a multiple of the grid. The callback receives the tiles row by row,
+    // starting at the top left.
+    using StillTilesCallback = std::function<void (std::exception_ptr, std::vector<PremultipliedImage>)>;
+    void renderStillTiles(View&, Size grid, StillTilesCallback callback);
+
     // Triggers a repaint.
     void triggerRepaint();
 
@@ -156,6 +170,11 @@ public:
     void updateAnnotation(AnnotationID, const Annotation&);
     void removeAnnotation(AnnotationID);
 
+    // Like the above, for many annotations at once. The map is updated once for the whole batch.
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&);
+    void updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>&);
+    void removeAnnotations(const AnnotationIDs&);
+
     // Sources
     std::vector<style::Source*> getSources();
     style::Source* getSource(const std::string& sourceID);
@@ -187,6 +206,8 @@ public:
 
     // Memory
     void setSourceTileCacheSize(size_t);
+    // Maximum number of bytes that each source may keep in cached, off-screen tiles.
+    void setSourceTileCacheBudget(size_t);
     void onLowMemory();
 
     // Debug
@@ -194,6 +215,9 @@ public:
     void cycleDebugOptions();
     MapDebugOptions getDebug() const;
 
+    // Statistics about the most recently rendered frame; see also mbgl/util/tracing.hpp.
+    RenderStats getRenderStats() const;
+
     bool isFullyLoaded() const;
     void dumpDebugLogs() const;
 
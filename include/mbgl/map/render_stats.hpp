@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+/** Statistics about the most recently rendered frame. Times are CPU time spent
+    submitting work, not GPU time. */
+struct RenderStats {
+    /** Uploading buckets and atlases that changed since the previous frame. */
+    Duration uploadTime = Duration::zero();
+
+    /** Clearing the framebuffer and drawing the clipping masks. */
+    Duration clipTime = Duration::zero();
+
+    /** Drawing the opaque and translucent passes. */
+    Duration opaqueTime = Duration::zero();
+    Duration translucentTime = Duration::zero();
+
+    /** Drawing per-tile debug overlays and finishing up. */
+    Duration debugTime = Duration::zero();
+
+    /** The whole frame, including the phases above. */
+    Duration totalTime = Duration::zero();
+
+    /** Number of draw calls issued. */
+    std::size_t drawCalls = 0;
+
+    /** Number of OpenGL state changes that weren't skipped as redundant. */
+    std::size_t stateChanges = 0;
+
+    /** Bytes of vertex and index data, and of texture data, sent to the GPU. */
+    std::size_t bufferBytesUploaded = 0;
+    std::size_t textureBytesUploaded = 0;
+
+    /** Bytes of vertex and index data held, and the total size of the pooled buffers they are
+        packed into. */
+    std::size_t bufferBytesAllocated = 0;
+    std::size_t bufferBytesCapacity = 0;
+
+    /** Number of tiles rendered, keyed by source ID. */
+    std::unordered_map<std::string, std::size_t> tilesRendered;
+
+    /** Number of icons and glyphs drawn in symbol layers. */
+    std::size_t iconsRendered = 0;
+    std::size_t glyphsRendered = 0;
+};
+
+} // namespace mbgl
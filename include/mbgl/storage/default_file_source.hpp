@@ -37,6 +37,7 @@ public:
     std::string getAccessToken() const;
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setRequestPriority(AsyncRequest&, Resource::Necessity, float viewportDistance) override;
 
     /*
      * Retrieve all regions in the offline database.
@@ -107,6 +108,29 @@ public:
      */
     void deleteOfflineRegion(OfflineRegion&&, std::function<void (std::exception_ptr)>);
 
+    /*
+     * Add the tiles and resources stored in another offline database to an offline region,
+     * or the tiles of an MBTiles file as tiles of the given URL template, without requesting
+     * them. Entries the database already has are kept as they are. Imported Mapbox tiles
+     * count towards the Mapbox tile count limit; an import that would exceed it fails
+     * as a whole.
+     *
+     * When the import is complete or encounters an error, the given callback will be
+     * executed on the database thread, with the number of tiles and resources added to the
+     * region; it is the responsibility of the SDK bindings to re-execute a user-provided
+     * callback on the main thread.
+     */
+    void importOfflineRegionDatabase(OfflineRegion&,
+                                     const std::string& path,
+                                     std::function<void (std::exception_ptr,
+                                                         optional<uint64_t>)>);
+    void importOfflineRegionMBTiles(OfflineRegion&,
+                                    const std::string& path,
+                                    const std::string& urlTemplate,
+                                    float pixelRatio,
+                                    std::function<void (std::exception_ptr,
+                                                        optional<uint64_t>)>);
+
     /*
      * Changing or bypassing this limit without permission from Mapbox is prohibited
      * by the Mapbox Terms of Service.
@@ -31,6 +31,13 @@ public:
     virtual bool supportsOptionalRequests() const {
         return false;
     }
+
+    // Changes the rank of a request that is still waiting for a network connection, e.g.
+    // because the viewport has moved or the resource has become required. The request must
+    // have been returned by this file source. File sources that don't queue requests
+    // ignore this.
+    virtual void setRequestPriority(AsyncRequest&, Resource::Necessity, float /* viewportDistance */) {
+    }
 };
 
 } // namespace mbgl
@@ -31,6 +31,11 @@ public:
 
     /* Private */
     std::vector<CanonicalTileID> tileCover(SourceType, uint16_t tileSize, const Range<uint8_t>& zoomRange) const;
+    uint64_t tileCount(SourceType, uint16_t tileSize, const Range<uint8_t>& zoomRange) const;
+
+    // The zoom levels a source with the given zoom range contributes tiles at. Empty
+    // (min > max) when the source and the region don't overlap.
+    Range<uint8_t> coveringZoomRange(SourceType, uint16_t tileSize, const Range<uint8_t>& zoomRange) const;
 
     const std::string styleURL;
     const LatLngBounds bounds;
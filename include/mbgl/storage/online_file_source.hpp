@@ -17,6 +17,7 @@ public:
     std::string getAccessToken() const { return accessToken; }
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setRequestPriority(AsyncRequest&, Resource::Necessity, float viewportDistance) override;
 
 private:
     friend class OnlineFileRequest;
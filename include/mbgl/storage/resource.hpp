@@ -63,6 +63,11 @@ public:
     // Includes auxiliary data if this is a tile request.
     optional<TileData> tileData;
 
+    // For tile requests: the distance, in tiles, from the tile to the center of the viewport
+    // at the time of the request. When the number of concurrent requests is limited, tiles
+    // closer to the center are requested first.
+    float viewportDistance = 0;
+
     optional<Timestamp> priorModified = {};
     optional<Timestamp> priorExpires = {};
     optional<std::string> priorEtag = {};
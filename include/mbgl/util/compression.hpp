@@ -6,7 +6,11 @@ namespace mbgl {
 namespace util {
         
 std::string compress(const std::string& raw);
+// Accepts both zlib and gzip streams.
 std::string decompress(const std::string& raw);
+
+// Whether the data starts with the gzip magic bytes.
+bool isGzip(const std::string& data);
     
 } // namespace util
 } // namespace mbgl
@@ -9,6 +9,8 @@
 
 namespace mbgl {
 
+class Scheduler;
+
 enum class ImageAlphaMode {
     Unassociated,
     Premultiplied,
@@ -62,6 +64,18 @@ using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
 // TODO: don't use std::string for binary data.
 PremultipliedImage decodeImage(const std::string&);
+
+struct PNGEncodeOptions {
+    // zlib compression level, from 0 (store only, fastest) to 9 (smallest, slowest).
+    int compressionLevel = 6;
+
+    // When set, horizontal strips of the image are filtered and compressed in parallel
+    // on this scheduler. Platforms that encode PNGs with system libraries ignore both
+    // options.
+    Scheduler* scheduler = nullptr;
+};
+
 std::string encodePNG(const PremultipliedImage&);
+std::string encodePNG(const PremultipliedImage&, const PNGEncodeOptions&);
 
 } // namespace mbgl
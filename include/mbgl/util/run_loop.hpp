@@ -12,6 +12,7 @@
 #include <utility>
 #include <queue>
 #include <mutex>
+#include <vector>
 
 namespace mbgl {
 namespace util {
@@ -81,10 +82,31 @@ private:
 
     void push(std::shared_ptr<WorkTask>);
 
+    // Mailboxes scheduled in a row are received by a single task, rather than each
+    // getting a task of its own.
     void schedule(std::weak_ptr<Mailbox> mailbox) override {
-        invoke([mailbox] () {
-            Mailbox::maybeReceive(mailbox);
-        });
+        bool first;
+        {
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            first = mailboxes.empty();
+            mailboxes.push_back(std::move(mailbox));
+        }
+        if (first) {
+            invoke([this] () {
+                receiveMailboxes();
+            });
+        }
+    }
+
+    void receiveMailboxes() {
+        std::vector<std::weak_ptr<Mailbox>> receiving;
+        {
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            receiving.swap(mailboxes);
+        }
+        for (auto& mailbox : receiving) {
+            Mailbox::maybeReceive(std::move(mailbox));
+        }
     }
 
     void withMutex(std::function<void()>&& fn) {
@@ -105,6 +127,9 @@ private:
     Queue queue;
     std::mutex mutex;
 
+    std::vector<std::weak_ptr<Mailbox>> mailboxes;
+    std::mutex mailboxMutex;
+
     std::unique_ptr<Impl> impl;
 };
 
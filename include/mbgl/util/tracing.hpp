@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <string>
+
+namespace mbgl {
+namespace tracing {
+
+// Starts recording trace events from all threads, discarding any events that were
+// recorded before. Recording is off by default, in which case instrumented code only
+// pays for checking whether it is on.
+void start();
+
+// Stops recording and returns the events recorded since `start()`, in the Chrome trace
+// event format. The result can be loaded into chrome://tracing or a compatible viewer.
+std::string stop();
+
+bool isEnabled();
+
+// Records an event that began and ended at the given times, on the current thread.
+void record(const char* category, std::string name, TimePoint begin, TimePoint end);
+
+// Records an event spanning the lifetime of this object, if recording is on at the time
+// it is constructed.
+class Scope : private util::noncopyable {
+public:
+    Scope(const char* category_, std::string name_)
+        : enabled(isEnabled()), category(category_) {
+        if (enabled) {
+            name = std::move(name_);
+            begin = Clock::now();
+        }
+    }
+
+    ~Scope() {
+        if (enabled) {
+            record(category, std::move(name), begin, Clock::now());
+        }
+    }
+
+private:
+    const bool enabled;
+    const char* category;
+    std::string name;
+    TimePoint begin;
+};
+
+} // namespace tracing
+} // namespace mbgl
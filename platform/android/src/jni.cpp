@@ -654,8 +654,8 @@ jni::jarray<jlong>* nativeAddMarkers(JNIEnv *env, jni::jobject* obj, jlong nativ
     NullCheck(*env, jarray);
     std::size_t len = jni::GetArrayLength(*env, *jarray);
 
-    mbgl::AnnotationIDs ids;
-    ids.reserve(len);
+    std::vector<mbgl::Annotation> annotations;
+    annotations.reserve(len);
 
     for (std::size_t i = 0; i < len; i++) {
         jni::jobject* marker = jni::GetObjectArrayElement(*env, *jarray, i);
@@ -666,10 +666,10 @@ jni::jarray<jlong>* nativeAddMarkers(JNIEnv *env, jni::jobject* obj, jlong nativ
         jdouble latitude = jni::GetField<jdouble>(*env, position, *latLngLatitudeId);
         jdouble longitude = jni::GetField<jdouble>(*env, position, *latLngLongitudeId);
 
-        ids.push_back(nativeMapView->getMap().addAnnotation(mbgl::SymbolAnnotation {
+        annotations.emplace_back(mbgl::SymbolAnnotation {
             mbgl::Point<double>(longitude, latitude),
             std_string_from_jstring(env, jid)
-        }));
+        });
 
         jni::DeleteLocalRef(*env, position);
         jni::DeleteLocalRef(*env, jid);
@@ -677,7 +677,7 @@ jni::jarray<jlong>* nativeAddMarkers(JNIEnv *env, jni::jobject* obj, jlong nativ
         jni::DeleteLocalRef(*env, marker);
     }
 
-    return std_vector_uint_to_jobject(env, ids);
+    return std_vector_uint_to_jobject(env, nativeMapView->getMap().addAnnotations(annotations));
 }
 
 static mbgl::Color toColor(jint color) {
@@ -802,11 +802,16 @@ void nativeRemoveAnnotations(JNIEnv *env, jni::jobject* obj, jlong nativeMapView
     auto elements = jni::GetArrayElements(*env, *jarray);
     jlong* jids = std::get<0>(elements).get();
 
+    mbgl::AnnotationIDs ids;
+    ids.reserve(len);
+
     for (std::size_t i = 0; i < len; i++) {
         if(jids[i] == -1L)
             continue;
-        nativeMapView->getMap().removeAnnotation(jids[i]);
+        ids.push_back(jids[i]);
     }
+
+    nativeMapView->getMap().removeAnnotations(ids);
 }
 
 jni::jarray<jlong>* nativeQueryPointAnnotations(JNIEnv *env, jni::jobject* obj, jlong nativeMapViewPtr, jni::jobject* rect) {
@@ -66,6 +66,10 @@ std::string encodePNG(const PremultipliedImage& src) {
     return result;
 }
 
+std::string encodePNG(const PremultipliedImage& src, const PNGEncodeOptions&) {
+    return encodePNG(src);
+}
+
 PremultipliedImage decodeImage(const std::string &source_data) {
     CFDataRef data = CFDataCreateWithBytesNoCopy(kCFAllocatorDefault, reinterpret_cast<const unsigned char *>(source_data.data()), source_data.size(), kCFAllocatorNull);
     if (!data) {
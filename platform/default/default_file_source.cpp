@@ -8,9 +8,14 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/timer.hpp>
+#include <mbgl/util/tracing.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/work_request.hpp>
 
 #include <cassert>
+#include <vector>
 
 namespace {
 
@@ -20,6 +25,9 @@ bool isAssetURL(const std::string& url) {
     return std::equal(assetProtocol.begin(), assetProtocol.end(), url.begin());
 }
 
+const std::size_t maxPendingWrites = 64;
+const mbgl::Duration pendingWritesDelay = mbgl::Milliseconds(250);
+
 } // namespace
 
 namespace mbgl {
@@ -29,6 +37,14 @@ public:
     Impl(const std::string& cachePath, uint64_t maximumCacheSize)
         : offlineDatabase(cachePath, maximumCacheSize) {
     }
+
+    ~Impl() {
+        try {
+            flushPendingWrites();
+        } catch (const std::exception& ex) {
+            Log::Error(Event::Database, "Failed to store cached resources: %s", ex.what());
+        }
+    }
     
     void setAPIBaseURL(const std::string& url) {
         onlineFileSource.setAPIBaseURL(url);
@@ -92,11 +108,36 @@ public:
         }
     }
 
+    void importDatabase(int64_t regionID,
+                        const std::string& path,
+                        std::function<void (std::exception_ptr, optional<uint64_t>)> callback) {
+        try {
+            callback({}, offlineDatabase.importDatabase(regionID, path));
+        } catch (...) {
+            callback(std::current_exception(), {});
+        }
+    }
+
+    void importMBTiles(int64_t regionID,
+                       const std::string& path,
+                       const std::string& urlTemplate,
+                       float pixelRatio,
+                       std::function<void (std::exception_ptr, optional<uint64_t>)> callback) {
+        try {
+            callback({}, offlineDatabase.importMBTiles(regionID, path, urlTemplate, pixelRatio));
+        } catch (...) {
+            callback(std::current_exception(), {});
+        }
+    }
+
     void setRegionObserver(int64_t regionID, std::unique_ptr<OfflineRegionObserver> observer) {
         getDownload(regionID).setObserver(std::move(observer));
     }
 
     void setRegionDownloadState(int64_t regionID, OfflineRegionDownloadState state) {
+        // Make sure the download sees, and doesn't get overwritten by, everything
+        // the ambient cache has received so far.
+        flushPendingWrites();
         getDownload(regionID).setState(state);
     }
 
@@ -105,7 +146,7 @@ public:
 
         const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
         if (!hasPrior || resource.necessity == Resource::Optional) {
-            auto offlineResponse = offlineDatabase.get(resource);
+            auto offlineResponse = getCached(resource);
 
             if (resource.necessity == Resource::Optional && !offlineResponse) {
                 // Ensure there's always a response that we can send, so the caller knows that
@@ -126,7 +167,7 @@ public:
 
         if (resource.necessity == Resource::Required) {
             tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
-                this->offlineDatabase.put(revalidation, onlineResponse);
+                this->queueWrite(revalidation, onlineResponse);
                 callback(onlineResponse);
             });
         }
@@ -136,15 +177,109 @@ public:
         tasks.erase(req);
     }
 
+    void setRequestPriority(AsyncRequest* req, Resource::Necessity necessity, float viewportDistance) {
+        auto it = tasks.find(req);
+        if (it != tasks.end()) {
+            onlineFileSource.setRequestPriority(*it->second, necessity, viewportDistance);
+        }
+    }
+
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
         offlineDatabase.setOfflineMapboxTileCountLimit(limit);
     }
 
     void put(const Resource& resource, const Response& response) {
+        flushPendingWrites();
         offlineDatabase.put(resource, response);
     }
 
 private:
+    // Responses from the network are written to the ambient cache in batches:
+    // they are queued here and stored together, in a single transaction, once
+    // the queue is full or has been sitting for a moment. A newer response for
+    // the same resource replaces the queued one, and requests are answered from
+    // the queue before going to the database.
+    static std::string cacheKey(const Resource& resource) {
+        if (resource.kind == Resource::Kind::Tile && resource.tileData) {
+            const Resource::TileData& tile = *resource.tileData;
+            return tile.urlTemplate + "\n" + util::toString(tile.pixelRatio) + "/" +
+                util::toString(tile.z) + "/" + util::toString(tile.x) + "/" + util::toString(tile.y);
+        }
+        return resource.url;
+    }
+
+    void queueWrite(const Resource& resource, const Response& response) {
+        if (response.error) {
+            // Errors are never stored.
+            return;
+        }
+
+        const std::string key = cacheKey(resource);
+        auto it = pendingWriteIndex.find(key);
+        if (it != pendingWriteIndex.end()) {
+            Response& pending = pendingWrites[it->second].second;
+            if (response.notModified && !pending.notModified) {
+                // Still the same data; only the expiration moved.
+                pending.expires = response.expires;
+            } else {
+                pendingWrites[it->second] = { resource, response };
+            }
+            return;
+        }
+
+        pendingWriteIndex.emplace(key, pendingWrites.size());
+        pendingWrites.emplace_back(resource, response);
+
+        if (pendingWrites.size() >= maxPendingWrites) {
+            flushPendingWrites();
+        } else if (pendingWrites.size() == 1) {
+            pendingWritesTimer.start(pendingWritesDelay, Duration::zero(), [this] {
+                flushPendingWrites();
+            });
+        }
+    }
+
+    void flushPendingWrites() {
+        pendingWritesTimer.stop();
+        if (pendingWrites.empty()) {
+            return;
+        }
+
+        tracing::Scope trace("storage", "cache write");
+
+        auto batch = std::move(pendingWrites);
+        pendingWrites.clear();
+        pendingWriteIndex.clear();
+        offlineDatabase.put(batch);
+    }
+
+    optional<Response> getCached(const Resource& resource) {
+        tracing::Scope trace("storage", "cache lookup");
+
+        auto it = pendingWriteIndex.find(cacheKey(resource));
+        if (it == pendingWriteIndex.end()) {
+            return offlineDatabase.get(resource);
+        }
+
+        const Response& pending = pendingWrites[it->second].second;
+        if (pending.notModified) {
+            auto stored = offlineDatabase.get(resource);
+            if (stored) {
+                stored->expires = pending.expires;
+            }
+            return stored;
+        }
+
+        // Hand out only what the database would have stored.
+        Response response;
+        response.noContent = pending.noContent;
+        response.etag = pending.etag;
+        response.expires = pending.expires;
+        response.modified = pending.modified;
+        response.data = pending.data;
+        return response;
+    }
+
     OfflineDownload& getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
@@ -158,6 +293,10 @@ private:
     OnlineFileSource onlineFileSource;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+
+    std::vector<std::pair<Resource, Response>> pendingWrites;
+    std::unordered_map<std::string, std::size_t> pendingWriteIndex;
+    util::Timer pendingWritesTimer;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
@@ -212,6 +351,11 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
     }
 }
 
+void DefaultFileSource::setRequestPriority(AsyncRequest& req, Resource::Necessity necessity, float viewportDistance) {
+    // Asset and local file requests aren't in the task list, so they're ignored.
+    thread->invoke(&Impl::setRequestPriority, &req, necessity, viewportDistance);
+}
+
 void DefaultFileSource::listOfflineRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
     thread->invoke(&Impl::listRegions, callback);
 }
@@ -232,6 +376,20 @@ void DefaultFileSource::deleteOfflineRegion(OfflineRegion&& region, std::functio
     thread->invoke(&Impl::deleteRegion, std::move(region), callback);
 }
 
+void DefaultFileSource::importOfflineRegionDatabase(OfflineRegion& region,
+                                                    const std::string& path,
+                                                    std::function<void (std::exception_ptr, optional<uint64_t>)> callback) {
+    thread->invoke(&Impl::importDatabase, region.getID(), path, callback);
+}
+
+void DefaultFileSource::importOfflineRegionMBTiles(OfflineRegion& region,
+                                                   const std::string& path,
+                                                   const std::string& urlTemplate,
+                                                   float pixelRatio,
+                                                   std::function<void (std::exception_ptr, optional<uint64_t>)> callback) {
+    thread->invoke(&Impl::importMBTiles, region.getID(), path, urlTemplate, pixelRatio, callback);
+}
+
 void DefaultFileSource::setOfflineRegionObserver(OfflineRegion& region, std::unique_ptr<OfflineRegionObserver> observer) {
     thread->invoke(&Impl::setRegionObserver, region.getID(), std::move(observer));
 }
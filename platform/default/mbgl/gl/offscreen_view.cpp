@@ -6,11 +6,25 @@
 
 namespace mbgl {
 
+#if not MBGL_USE_GLES2
+namespace {
+
+// Double buffering: one buffer receives the frame that was just rendered while the
+// previous frame is copied out of the other.
+constexpr std::size_t readBufferCount = 2;
+
+} // namespace
+#endif // MBGL_USE_GLES2
+
 OffscreenView::OffscreenView(gl::Context& context_, const Size size_)
     : size(std::move(size_)), context(context_) {
     assert(size);
 }
 
+OffscreenView::~OffscreenView() {
+    flushStillImages();
+}
+
 void OffscreenView::bind() {
     if (!framebuffer) {
         color = context.createRenderbuffer<gl::RenderbufferType::RGBA>(size);
@@ -27,4 +41,46 @@ PremultipliedImage OffscreenView::readStillImage() {
     return context.readFramebuffer<PremultipliedImage>(size);
 }
 
+void OffscreenView::readStillImage(std::function<void (PremultipliedImage)> callback) {
+#if not MBGL_USE_GLES2
+    if (context.supportsPixelPackBuffers()) {
+        if (readBuffers.empty()) {
+            readBuffers.push_back(context.createPixelPackBuffer(
+                size.width * size.height * PremultipliedImage::channels));
+        }
+        gl::UniqueBuffer buffer = std::move(readBuffers.back());
+        readBuffers.pop_back();
+
+        context.readFramebuffer<PremultipliedImage>(buffer, size);
+        pendingReads.push_back({ std::move(buffer), std::move(callback) });
+
+        while (pendingReads.size() >= readBufferCount) {
+            finishRead();
+        }
+        return;
+    }
+#endif // MBGL_USE_GLES2
+
+    callback(readStillImage());
+}
+
+void OffscreenView::flushStillImages() {
+#if not MBGL_USE_GLES2
+    while (!pendingReads.empty()) {
+        finishRead();
+    }
+#endif // MBGL_USE_GLES2
+}
+
+#if not MBGL_USE_GLES2
+void OffscreenView::finishRead() {
+    PendingRead read = std::move(pendingReads.front());
+    pendingReads.pop_front();
+
+    auto image = context.readPixelPackBuffer<PremultipliedImage>(read.buffer, size);
+    readBuffers.push_back(std::move(read.buffer));
+    read.callback(std::move(image));
+}
+#endif // MBGL_USE_GLES2
+
 } // namespace mbgl
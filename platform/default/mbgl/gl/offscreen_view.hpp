@@ -2,10 +2,15 @@
 
 #include <mbgl/map/view.hpp>
 #include <mbgl/gl/framebuffer.hpp>
+#include <mbgl/gl/object.hpp>
 #include <mbgl/gl/renderbuffer.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/image.hpp>
 
+#include <deque>
+#include <functional>
+#include <vector>
+
 namespace mbgl {
 
 namespace gl {
@@ -16,10 +21,22 @@ class OffscreenView : public View {
 public:
     OffscreenView(gl::Context&, Size size = { 256, 256 });
 
+    // Delivers the images that are still being read, so that no callback is lost.
+    ~OffscreenView();
+
     void bind() override;
 
     PremultipliedImage readStillImage();
 
+    // Starts reading the current frame without waiting for it to finish rendering, so that
+    // the next frame can be rendered in the meantime. The callback receives the image once
+    // a later frame is read, or on flushStillImages(). Where pixel pack buffers aren't
+    // supported, the frame is read right away instead.
+    void readStillImage(std::function<void (PremultipliedImage)>);
+
+    // Delivers all images that are still being read.
+    void flushStillImages();
+
 public:
     const Size size;
 
@@ -28,6 +45,18 @@ private:
     optional<gl::Framebuffer> framebuffer;
     optional<gl::Renderbuffer<gl::RenderbufferType::RGBA>> color;
     optional<gl::Renderbuffer<gl::RenderbufferType::DepthStencil>> depthStencil;
+
+#if not MBGL_USE_GLES2
+    struct PendingRead {
+        gl::UniqueBuffer buffer;
+        std::function<void (PremultipliedImage)> callback;
+    };
+
+    void finishRead();
+
+    std::deque<PendingRead> pendingReads;
+    std::vector<gl::UniqueBuffer> readBuffers;
+#endif // MBGL_USE_GLES2
 };
 
 } // namespace mbgl
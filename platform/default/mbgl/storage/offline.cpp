@@ -23,7 +23,7 @@ OfflineTilePyramidRegionDefinition::OfflineTilePyramidRegionDefinition(
     }
 }
 
-std::vector<CanonicalTileID> OfflineTilePyramidRegionDefinition::tileCover(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
+Range<uint8_t> OfflineTilePyramidRegionDefinition::coveringZoomRange(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
     double minZ = std::max<double>(util::coveringZoomLevel(minZoom, type, tileSize), zoomRange.min);
     double maxZ = std::min<double>(util::coveringZoomLevel(maxZoom, type, tileSize), zoomRange.max);
 
@@ -32,17 +32,36 @@ std::vector<CanonicalTileID> OfflineTilePyramidRegionDefinition::tileCover(Sourc
     assert(minZ < std::numeric_limits<uint8_t>::max());
     assert(maxZ < std::numeric_limits<uint8_t>::max());
 
+    return { static_cast<uint8_t>(minZ), static_cast<uint8_t>(maxZ) };
+}
+
+std::vector<CanonicalTileID> OfflineTilePyramidRegionDefinition::tileCover(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
+    const Range<uint8_t> zooms = coveringZoomRange(type, tileSize, zoomRange);
+
     std::vector<CanonicalTileID> result;
+    result.reserve(tileCount(type, tileSize, zoomRange));
 
-    for (uint8_t z = minZ; z <= maxZ; z++) {
-        for (const auto& tile : util::tileCover(bounds, z)) {
-            result.emplace_back(tile.canonical);
+    for (uint8_t z = zooms.min; z <= zooms.max; z++) {
+        const util::TileRange tiles(bounds, z);
+        for (uint64_t i = 0; i < tiles.size(); i++) {
+            result.emplace_back(tiles[i].canonical);
         }
     }
 
     return result;
 }
 
+uint64_t OfflineTilePyramidRegionDefinition::tileCount(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
+    const Range<uint8_t> zooms = coveringZoomRange(type, tileSize, zoomRange);
+
+    uint64_t result = 0;
+    for (uint8_t z = zooms.min; z <= zooms.max; z++) {
+        result += util::TileRange(bounds, z).size();
+    }
+
+    return result;
+}
+
 OfflineRegionDefinition decodeOfflineRegionDefinition(const std::string& region) {
     rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
     doc.Parse<0>(region.c_str());
@@ -49,7 +49,9 @@ void OfflineDatabase::ensureSchema() {
             case 2: migrateToVersion3(); // fall through
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
-            case 5: return;
+            case 5: migrateToVersion6(); // fall through
+            case 6: migrateToVersion7(); // fall through
+            case 7: return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -83,7 +85,7 @@ void OfflineDatabase::ensureSchema() {
         db->exec("PRAGMA journal_mode = DELETE");
         db->exec("PRAGMA synchronous = FULL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 5");
+        db->exec("PRAGMA user_version = 7");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -126,6 +128,104 @@ void OfflineDatabase::migrateToVersion5() {
     db->exec("PRAGMA user_version = 5");
 }
 
+void OfflineDatabase::migrateToVersion6() {
+    // clang-format off
+    db->exec(
+        "CREATE TABLE region_download_cursors ("
+        "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,"
+        "  url_template TEXT NOT NULL,"
+        "  tile_count INTEGER NOT NULL,"
+        "  tile_index INTEGER NOT NULL,"
+        "  completed_size INTEGER NOT NULL,"
+        "  UNIQUE (region_id, url_template)"
+        ")");
+    // clang-format on
+    db->exec("PRAGMA user_version = 6");
+}
+
+void OfflineDatabase::migrateToVersion7() {
+    // Tile data moves from the tiles table into tile_blobs. SQLite can't drop columns, so the
+    // tiles table is rebuilt, keeping the tile ids that region_tiles refers to. Foreign keys
+    // are off meanwhile, so that dropping the old table leaves region_tiles alone.
+    db->exec("PRAGMA foreign_keys = OFF");
+
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    // clang-format off
+    db->exec(
+        "CREATE TABLE tile_blobs ("
+        "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,"
+        "  hash INTEGER NOT NULL,"
+        "  data BLOB NOT NULL,"
+        "  compressed INTEGER NOT NULL DEFAULT 0,"
+        "  ref_count INTEGER NOT NULL"
+        ")");
+    db->exec(
+        "CREATE INDEX tile_blobs_hash "
+        "ON tile_blobs (hash)");
+    db->exec(
+        "CREATE TABLE new_tiles ("
+        "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,"
+        "  url_template TEXT NOT NULL,"
+        "  pixel_ratio INTEGER NOT NULL,"
+        "  z INTEGER NOT NULL,"
+        "  x INTEGER NOT NULL,"
+        "  y INTEGER NOT NULL,"
+        "  expires INTEGER,"
+        "  modified INTEGER,"
+        "  etag TEXT,"
+        "  blob_id INTEGER REFERENCES tile_blobs(id),"
+        "  accessed INTEGER NOT NULL,"
+        "  UNIQUE (url_template, pixel_ratio, z, x, y)"
+        ")");
+    // clang-format on
+
+    {
+        // clang-format off
+        mapbox::sqlite::Statement select = db->prepare(
+            //      0        1            2       3  4  5     6        7       8     9       10         11
+            "SELECT id, url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed "
+            "FROM tiles ");
+        mapbox::sqlite::Statement insert = db->prepare(
+            "INSERT INTO new_tiles (id, url_template, pixel_ratio, z,  x,  y,  expires, modified, etag, blob_id, accessed) "
+            "VALUES                (?1, ?2,           ?3,          ?4, ?5, ?6, ?7,      ?8,       ?9,   ?10,     ?11) ");
+        // clang-format on
+
+        while (select.run()) {
+            insert.bind(1, select.get<int64_t>(0));
+            insert.bind(2, select.get<std::string>(1));
+            insert.bind(3, select.get<int64_t>(2));
+            insert.bind(4, select.get<int64_t>(3));
+            insert.bind(5, select.get<int64_t>(4));
+            insert.bind(6, select.get<int64_t>(5));
+            insert.bind(7, select.get<optional<Timestamp>>(6));
+            insert.bind(8, select.get<optional<Timestamp>>(7));
+            insert.bind(9, select.get<optional<std::string>>(8));
+
+            optional<std::string> data = select.get<optional<std::string>>(9);
+            if (data) {
+                insert.bind(10, acquireTileBlob(*data, select.get<int>(10)));
+            } else {
+                insert.bind(10, nullptr);
+            }
+
+            insert.bind(11, select.get<Timestamp>(11));
+            insert.run();
+            insert.reset();
+        }
+    }
+
+    db->exec("DROP TABLE tiles");
+    db->exec("ALTER TABLE new_tiles RENAME TO tiles");
+    db->exec("CREATE INDEX tiles_accessed ON tiles (accessed)");
+    db->exec("PRAGMA user_version = 7");
+
+    transaction.commit();
+
+    db->exec("PRAGMA foreign_keys = ON");
+    db->exec("PRAGMA incremental_vacuum");
+}
+
 OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
     auto it = statements.find(sql);
 
@@ -163,6 +263,69 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
     return putInternal(resource, response, true);
 }
 
+namespace {
+
+// Compresses the response data when that saves space. Returns the size the
+// entry will take up in the database.
+uint64_t encodeResponseData(const Response& response, std::string& compressedData, bool& compressed) {
+    if (!response.data) {
+        return 0;
+    }
+    compressedData = util::compress(*response.data);
+    compressed = compressedData.size() < response.data->size();
+    return compressed ? compressedData.size() : response.data->size();
+}
+
+} // namespace
+
+std::vector<std::pair<bool, uint64_t>> OfflineDatabase::put(const std::vector<std::pair<Resource, Response>>& batch) {
+    std::vector<std::pair<bool, uint64_t>> results(batch.size(), { false, 0 });
+    if (batch.empty()) {
+        return results;
+    }
+
+    std::vector<std::pair<std::string, bool>> encoded(batch.size(), { std::string(), false });
+    std::vector<uint64_t> sizes(batch.size(), 0);
+
+    uint64_t totalSize = 0;
+    uint64_t entryCount = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        if (!batch[i].second.error) {
+            sizes[i] = encodeResponseData(batch[i].second, encoded[i].first, encoded[i].second);
+            totalSize += sizes[i];
+            entryCount++;
+        }
+    }
+
+    if (!evict(totalSize, entryCount)) {
+        // There's no room for the batch as a whole; store the entries one by one,
+        // evicting as needed, so that as many as possible make it in.
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            results[i] = putInternal(batch[i].first, batch[i].second, true);
+        }
+        return results;
+    }
+
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    inBatchTransaction = true;
+    try {
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            const Response& response = batch[i].second;
+            if (!response.error) {
+                results[i] = { putEncoded(batch[i].first, response, encoded[i].first, encoded[i].second), sizes[i] };
+            }
+        }
+    } catch (...) {
+        inBatchTransaction = false;
+        usedSizeEstimate = {};
+        throw;
+    }
+    inBatchTransaction = false;
+    transaction.commit();
+
+    return results;
+}
+
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource, const Response& response, bool evict_) {
     if (response.error) {
         return { false, 0 };
@@ -170,33 +333,30 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
 
     std::string compressedData;
     bool compressed = false;
-    uint64_t size = 0;
-
-    if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
-    }
+    uint64_t size = encodeResponseData(response, compressedData, compressed);
 
     if (evict_ && !evict(size)) {
         Log::Debug(Event::Database, "Unable to make space for entry");
         return { false, 0 };
+    } else if (!evict_ && usedSizeEstimate) {
+        *usedSizeEstimate += size;
     }
 
-    bool inserted;
+    return { putEncoded(resource, response, compressedData, compressed), size };
+}
 
+bool OfflineDatabase::putEncoded(const Resource& resource, const Response& response,
+                                 const std::string& compressedData, bool compressed) {
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        inserted = putTile(*resource.tileData, response,
+        return putTile(*resource.tileData, response,
                 compressed ? compressedData : *response.data,
                 compressed);
     } else {
-        inserted = putResource(resource, response,
+        return putResource(resource, response,
                 compressed ? compressedData : *response.data,
                 compressed);
     }
-
-    return { inserted, size };
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
@@ -280,8 +440,11 @@ bool OfflineDatabase::putResource(const Resource& resource,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment. A batched put already holds one.
+    optional<mapbox::sqlite::Transaction> transaction;
+    if (!inBatchTransaction) {
+        transaction.emplace(*db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -313,7 +476,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -339,7 +504,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -366,9 +533,10 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
 
     // clang-format off
     Statement stmt = getStatement(
-        //        0      1        2       3        4
-        "SELECT etag, expires, modified, data, compressed "
+        //        0      1        2            3                  4
+        "SELECT etag, expires, modified, tile_blobs.data, tile_blobs.compressed "
         "FROM tiles "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = tiles.blob_id "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
@@ -410,8 +578,9 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
 optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
     // clang-format off
     Statement stmt = getStatement(
-        "SELECT length(data) "
+        "SELECT length(tile_blobs.data) "
         "FROM tiles "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = tiles.blob_id "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
@@ -463,8 +632,27 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment. A batched put already holds one.
+    optional<mapbox::sqlite::Transaction> transaction;
+    if (!inBatchTransaction) {
+        transaction.emplace(*db, mapbox::sqlite::Transaction::Immediate);
+    }
+
+    auto existing = findTile(tile);
+    if (!existing) {
+        insertTile(tile, response, data, compressed);
+        if (transaction) {
+            transaction->commit();
+        }
+        return true;
+    }
+
+    // Take the reference to the new data before dropping the old one, so that a tile
+    // that comes back unchanged keeps its blob.
+    optional<int64_t> blobID;
+    if (!response.noContent) {
+        blobID = acquireTileBlob(data, compressed);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -473,43 +661,71 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         "    etag           = ?2, "
         "    expires        = ?3, "
         "    accessed       = ?4, "
-        "    data           = ?5, "
-        "    compressed     = ?6 "
-        "WHERE url_template = ?7 "
-        "  AND pixel_ratio  = ?8 "
-        "  AND x            = ?9 "
-        "  AND y            = ?10 "
-        "  AND z            = ?11 ");
+        "    blob_id        = ?5 "
+        "WHERE id           = ?6 ");
     // clang-format on
 
     update->bind(1, response.modified);
     update->bind(2, response.etag);
     update->bind(3, response.expires);
     update->bind(4, util::now());
-    update->bind(7, tile.urlTemplate);
-    update->bind(8, tile.pixelRatio);
-    update->bind(9, tile.x);
-    update->bind(10, tile.y);
-    update->bind(11, tile.z);
-
-    if (response.noContent) {
-        update->bind(5, nullptr);
-        update->bind(6, false);
+    if (blobID) {
+        update->bind(5, *blobID);
     } else {
-        update->bindBlob(5, data.data(), data.size(), false);
-        update->bind(6, compressed);
+        update->bind(5, nullptr);
     }
-
+    update->bind(6, existing->first);
     update->run();
-    if (update->changes() != 0) {
-        transaction.commit();
-        return false;
+
+    if (existing->second) {
+        releaseTileBlob(*existing->second);
+    }
+
+    if (transaction) {
+        transaction->commit();
+    }
+
+    return false;
+}
+
+optional<std::pair<int64_t, optional<int64_t>>> OfflineDatabase::findTile(const Resource::TileData& tile) {
+    // clang-format off
+    Statement stmt = getStatement(
+        "SELECT id, blob_id "
+        "FROM tiles "
+        "WHERE url_template = ?1 "
+        "  AND pixel_ratio  = ?2 "
+        "  AND x            = ?3 "
+        "  AND y            = ?4 "
+        "  AND z            = ?5 ");
+    // clang-format on
+
+    stmt->bind(1, tile.urlTemplate);
+    stmt->bind(2, tile.pixelRatio);
+    stmt->bind(3, tile.x);
+    stmt->bind(4, tile.y);
+    stmt->bind(5, tile.z);
+
+    if (!stmt->run()) {
+        return {};
+    }
+
+    return std::make_pair(stmt->get<int64_t>(0), stmt->get<optional<int64_t>>(1));
+}
+
+void OfflineDatabase::insertTile(const Resource::TileData& tile,
+                                 const Response& response,
+                                 const std::string& data,
+                                 bool compressed) {
+    optional<int64_t> blobID;
+    if (!response.noContent) {
+        blobID = acquireTileBlob(data, compressed);
     }
 
     // clang-format off
     Statement insert = getStatement(
-        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified,  etag,  expires,  accessed,  data, compressed) "
-        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,        ?7,    ?8,       ?9,        ?10,  ?11) ");
+        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified,  etag,  expires,  accessed,  blob_id) "
+        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,        ?7,    ?8,       ?9,        ?10) ");
     // clang-format on
 
     insert->bind(1, tile.urlTemplate);
@@ -522,18 +738,94 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     insert->bind(8, response.expires);
     insert->bind(9, util::now());
 
-    if (response.noContent) {
-        insert->bind(10, nullptr);
-        insert->bind(11, false);
+    if (blobID) {
+        insert->bind(10, *blobID);
     } else {
-        insert->bindBlob(10, data.data(), data.size(), false);
-        insert->bind(11, compressed);
+        insert->bind(10, nullptr);
     }
 
     insert->run();
-    transaction.commit();
+}
 
-    return true;
+namespace {
+
+// FNV-1a. The hash only narrows down the blobs whose data gets compared, so it doesn't
+// need to be strong, but it is stored, so it must not vary between runs or platforms.
+int64_t hashTileData(const std::string& data) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : data) {
+        hash ^= uint8_t(c);
+        hash *= 1099511628211ull;
+    }
+    return int64_t(hash);
+}
+
+} // namespace
+
+int64_t OfflineDatabase::acquireTileBlob(const std::string& data, bool compressed) {
+    const int64_t hash = hashTileData(data);
+
+    // clang-format off
+    Statement select = getStatement(
+        "SELECT id "
+        "FROM tile_blobs "
+        "WHERE hash       = ?1 "
+        "  AND compressed = ?2 "
+        "  AND data       = ?3 ");
+    // clang-format on
+
+    select->bind(1, hash);
+    select->bind(2, compressed);
+    select->bindBlob(3, data.data(), data.size(), false);
+
+    if (select->run()) {
+        const int64_t blobID = select->get<int64_t>(0);
+
+        // clang-format off
+        Statement update = getStatement(
+            "UPDATE tile_blobs "
+            "SET ref_count = ref_count + 1 "
+            "WHERE id      = ?1 ");
+        // clang-format on
+
+        update->bind(1, blobID);
+        update->run();
+        return blobID;
+    }
+
+    // clang-format off
+    Statement insert = getStatement(
+        "INSERT INTO tile_blobs (hash, data, compressed, ref_count) "
+        "VALUES                 (?1,   ?2,   ?3,         1) ");
+    // clang-format on
+
+    insert->bind(1, hash);
+    insert->bindBlob(2, data.data(), data.size(), false);
+    insert->bind(3, compressed);
+    insert->run();
+    return insert->lastInsertRowId();
+}
+
+void OfflineDatabase::releaseTileBlob(int64_t blobID) {
+    // clang-format off
+    Statement update = getStatement(
+        "UPDATE tile_blobs "
+        "SET ref_count = ref_count - 1 "
+        "WHERE id      = ?1 ");
+    // clang-format on
+
+    update->bind(1, blobID);
+    update->run();
+
+    // clang-format off
+    Statement remove = getStatement(
+        "DELETE FROM tile_blobs "
+        "WHERE id        = ?1 "
+        "  AND ref_count = 0 ");
+    // clang-format on
+
+    remove->bind(1, blobID);
+    remove->run();
 }
 
 std::vector<OfflineRegion> OfflineDatabase::listRegions() {
@@ -591,7 +883,8 @@ void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
     stmt->bind(1, region.getID());
     stmt->run();
 
-    evict(0);
+    usedSizeEstimate = {};
+    evict(0, 0);
     db->exec("PRAGMA incremental_vacuum");
 
     // Ensure that the cached offlineTileCount value is recalculated.
@@ -618,6 +911,92 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
     return response;
 }
 
+std::vector<optional<int64_t>> OfflineDatabase::hasRegionTiles(int64_t regionID, const std::vector<Resource>& tiles) {
+    std::vector<optional<int64_t>> results(tiles.size());
+    if (tiles.empty()) {
+        return results;
+    }
+
+    // clang-format off
+    db->exec(
+        "CREATE TEMP TABLE IF NOT EXISTS tile_batch ("
+        "  batch_index INTEGER NOT NULL PRIMARY KEY,"
+        "  url_template TEXT NOT NULL,"
+        "  pixel_ratio INTEGER NOT NULL,"
+        "  z INTEGER NOT NULL,"
+        "  x INTEGER NOT NULL,"
+        "  y INTEGER NOT NULL"
+        ")");
+    // clang-format on
+
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    db->exec("DELETE FROM temp.tile_batch");
+
+    // clang-format off
+    Statement insert = getStatement(
+        "INSERT INTO temp.tile_batch (batch_index, url_template, pixel_ratio, z, x, y) "
+        "VALUES                      (?1,          ?2,           ?3,          ?4, ?5, ?6) ");
+    // clang-format on
+
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        assert(tiles[i].kind == Resource::Kind::Tile);
+        const Resource::TileData& tile = *tiles[i].tileData;
+        insert->bind(1, int64_t(i));
+        insert->bind(2, tile.urlTemplate);
+        insert->bind(3, tile.pixelRatio);
+        insert->bind(4, tile.z);
+        insert->bind(5, tile.x);
+        insert->bind(6, tile.y);
+        insert->run();
+        insert->reset();
+    }
+
+    // Like hasRegionResource(), tiles are only considered present, and marked as
+    // used by the region, when they have data.
+
+    // clang-format off
+    Statement mark = getStatement(
+        "INSERT OR IGNORE INTO region_tiles (region_id, tile_id) "
+        "SELECT                              ?1,        tiles.id "
+        "FROM temp.tile_batch batch, tiles "
+        "WHERE tiles.url_template = batch.url_template "
+        "  AND tiles.pixel_ratio  = batch.pixel_ratio "
+        "  AND tiles.z            = batch.z "
+        "  AND tiles.x            = batch.x "
+        "  AND tiles.y            = batch.y "
+        "  AND tiles.blob_id IS NOT NULL ");
+    // clang-format on
+
+    mark->bind(1, regionID);
+    mark->run();
+
+    if (mark->changes() > 0) {
+        // Some of the tiles may not have been used by any region before.
+        offlineMapboxTileCount = {};
+    }
+
+    // clang-format off
+    Statement select = getStatement(
+        "SELECT batch.batch_index, length(tile_blobs.data) "
+        "FROM temp.tile_batch batch, tiles, tile_blobs "
+        "WHERE tiles.url_template = batch.url_template "
+        "  AND tiles.pixel_ratio  = batch.pixel_ratio "
+        "  AND tiles.z            = batch.z "
+        "  AND tiles.x            = batch.x "
+        "  AND tiles.y            = batch.y "
+        "  AND tile_blobs.id      = tiles.blob_id ");
+    // clang-format on
+
+    while (select->run()) {
+        results[select->get<int64_t>(0)] = select->get<int64_t>(1);
+    }
+
+    transaction.commit();
+
+    return results;
+}
+
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) {
     uint64_t size = putInternal(resource, response, false).second;
     bool previouslyUnused = markUsed(regionID, resource);
@@ -632,6 +1011,189 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return size;
 }
 
+uint64_t OfflineDatabase::importDatabase(int64_t regionID, const std::string& sourcePath) {
+    return importInto(sourcePath, [&] {
+        // Databases from before schema version 7 keep the tile data in the tiles table.
+        mapbox::sqlite::Statement version = db->prepare("PRAGMA source.user_version");
+        version.run();
+        const bool sourceHasBlobs = version.get<int>(0) >= 7;
+
+        // clang-format off
+        mapbox::sqlite::Statement selectTiles = db->prepare(sourceHasBlobs ?
+            //             0                1              2        3        4          5                6             7            8                    9
+            "SELECT tiles.url_template, tiles.pixel_ratio, tiles.z, tiles.x, tiles.y, tiles.expires, tiles.modified, tiles.etag, tile_blobs.data, tile_blobs.compressed "
+            "FROM source.tiles "
+            "LEFT JOIN source.tile_blobs ON tile_blobs.id = tiles.blob_id " :
+            "SELECT url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed "
+            "FROM source.tiles ");
+        // clang-format on
+
+        while (selectTiles.run()) {
+            Resource::TileData tile;
+            tile.urlTemplate = selectTiles.get<std::string>(0);
+            tile.pixelRatio = selectTiles.get<int>(1);
+            tile.z = selectTiles.get<int>(2);
+            tile.x = selectTiles.get<int>(3);
+            tile.y = selectTiles.get<int>(4);
+
+            if (findTile(tile)) {
+                continue;
+            }
+
+            Response response;
+            response.expires = selectTiles.get<optional<Timestamp>>(5);
+            response.modified = selectTiles.get<optional<Timestamp>>(6);
+            response.etag = selectTiles.get<optional<std::string>>(7);
+
+            optional<std::string> data = selectTiles.get<optional<std::string>>(8);
+            response.noContent = !data;
+            insertTile(tile, response, data ? *data : std::string(), data && selectTiles.get<int>(9));
+        }
+
+        // clang-format off
+        mapbox::sqlite::Statement markTiles = db->prepare(
+            "INSERT OR IGNORE INTO main.region_tiles (region_id, tile_id) "
+            "SELECT                                   ?1,        main.tiles.id "
+            "FROM source.tiles, main.tiles "
+            "WHERE main.tiles.url_template = source.tiles.url_template "
+            "  AND main.tiles.pixel_ratio  = source.tiles.pixel_ratio "
+            "  AND main.tiles.z            = source.tiles.z "
+            "  AND main.tiles.x            = source.tiles.x "
+            "  AND main.tiles.y            = source.tiles.y ");
+        // clang-format on
+        markTiles.bind(1, regionID);
+        markTiles.run();
+        uint64_t added = markTiles.changes();
+
+        // clang-format off
+        mapbox::sqlite::Statement copyResources = db->prepare(
+            "INSERT OR IGNORE INTO main.resources (url, kind, expires, modified, etag, data, compressed, accessed) "
+            "SELECT                                url, kind, expires, modified, etag, data, compressed, ?1 "
+            "FROM source.resources ");
+        // clang-format on
+        copyResources.bind(1, util::now());
+        copyResources.run();
+
+        // clang-format off
+        mapbox::sqlite::Statement markResources = db->prepare(
+            "INSERT OR IGNORE INTO main.region_resources (region_id, resource_id) "
+            "SELECT                                       ?1,        main.resources.id "
+            "FROM source.resources, main.resources "
+            "WHERE main.resources.url = source.resources.url ");
+        // clang-format on
+        markResources.bind(1, regionID);
+        markResources.run();
+        added += markResources.changes();
+
+        return added;
+    });
+}
+
+uint64_t OfflineDatabase::importMBTiles(int64_t regionID, const std::string& sourcePath,
+                                        const std::string& urlTemplate, float pixelRatio) {
+    // Store the tiles under the same key that a download of `urlTemplate` looks them up by.
+    const Resource::TileData key = *Resource::tile(urlTemplate, pixelRatio, 0, 0, 0, Tileset::Scheme::XYZ).tileData;
+
+    return importInto(sourcePath, [&] {
+        // clang-format off
+        mapbox::sqlite::Statement selectTiles = db->prepare(
+            "SELECT zoom_level, tile_column, tile_row, tile_data "
+            "FROM source.tiles ");
+        // clang-format on
+
+        while (selectTiles.run()) {
+            // MBTiles rows are numbered from the bottom (TMS), while the tiles table counts from the top.
+            Resource::TileData tile = key;
+            tile.z = selectTiles.get<int>(0);
+            tile.x = selectTiles.get<int>(1);
+            tile.y = (1 << tile.z) - 1 - selectTiles.get<int>(2);
+
+            if (findTile(tile)) {
+                continue;
+            }
+
+            Response response;
+            optional<std::string> data = selectTiles.get<optional<std::string>>(3);
+            response.noContent = !data;
+            if (!data) {
+                insertTile(tile, response, std::string(), false);
+                continue;
+            }
+
+            // Vector tiles in MBTiles files are usually gzipped, but only the HTTP layer
+            // knows how to undo that; store them the way a download would have.
+            response.data = std::make_shared<std::string>(
+                util::isGzip(*data) ? util::decompress(*data) : std::move(*data));
+
+            std::string compressedData;
+            bool compressed = false;
+            encodeResponseData(response, compressedData, compressed);
+            insertTile(tile, response, compressed ? compressedData : *response.data, compressed);
+        }
+
+        // clang-format off
+        mapbox::sqlite::Statement markTiles = db->prepare(
+            "INSERT OR IGNORE INTO main.region_tiles (region_id, tile_id) "
+            "SELECT                                   ?1,        main.tiles.id "
+            "FROM source.tiles, main.tiles "
+            "WHERE main.tiles.url_template = ?2 "
+            "  AND main.tiles.pixel_ratio  = ?3 "
+            "  AND main.tiles.z            = source.tiles.zoom_level "
+            "  AND main.tiles.x            = source.tiles.tile_column "
+            "  AND main.tiles.y            = (1 << source.tiles.zoom_level) - 1 - source.tiles.tile_row ");
+        // clang-format on
+        markTiles.bind(1, regionID);
+        markTiles.bind(2, key.urlTemplate);
+        markTiles.bind(3, key.pixelRatio);
+        markTiles.run();
+
+        return markTiles.changes();
+    });
+}
+
+uint64_t OfflineDatabase::importInto(const std::string& sourcePath, std::function<uint64_t ()> merge) {
+    // Opening the source on its own first makes sure that it exists; attaching a missing
+    // file would create an empty database.
+    {
+        mapbox::sqlite::Database source(sourcePath.c_str(), mapbox::sqlite::ReadOnly);
+    }
+
+    {
+        mapbox::sqlite::Statement attach = db->prepare("ATTACH DATABASE ?1 AS source");
+        attach.bind(1, sourcePath);
+        attach.run();
+    }
+
+    uint64_t added = 0;
+    try {
+        mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+        const uint64_t mapboxTileCount = getOfflineMapboxTileCount();
+
+        added = merge();
+
+        // Imported tiles count towards the Mapbox tile limit just like downloaded ones.
+        offlineMapboxTileCount = {};
+        if (getOfflineMapboxTileCount() > mapboxTileCount &&
+            getOfflineMapboxTileCount() > offlineMapboxTileCountLimit) {
+            transaction.rollback();
+            offlineMapboxTileCount = {};
+            throw std::runtime_error("Mapbox tile count limit exceeded");
+        }
+
+        transaction.commit();
+    } catch (...) {
+        offlineMapboxTileCount = {};
+        db->exec("DETACH DATABASE source");
+        throw;
+    }
+
+    db->exec("DETACH DATABASE source");
+    usedSizeEstimate = {};
+
+    return added;
+}
+
 bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         // clang-format off
@@ -737,6 +1299,44 @@ OfflineRegionStatus OfflineDatabase::getRegionCompletedStatus(int64_t regionID)
     return result;
 }
 
+optional<OfflineDownloadCursor> OfflineDatabase::getRegionDownloadCursor(int64_t regionID, const std::string& urlTemplate) {
+    // clang-format off
+    Statement stmt = getStatement(
+        "SELECT tile_count, tile_index, completed_size "
+        "FROM region_download_cursors "
+        "WHERE region_id    = ?1 "
+        "  AND url_template = ?2 ");
+    // clang-format on
+
+    stmt->bind(1, regionID);
+    stmt->bind(2, urlTemplate);
+
+    if (!stmt->run()) {
+        return {};
+    }
+
+    OfflineDownloadCursor cursor;
+    cursor.tileCount = stmt->get<int64_t>(0);
+    cursor.tileIndex = stmt->get<int64_t>(1);
+    cursor.completedSize = stmt->get<int64_t>(2);
+    return cursor;
+}
+
+void OfflineDatabase::putRegionDownloadCursor(int64_t regionID, const std::string& urlTemplate, const OfflineDownloadCursor& cursor) {
+    // clang-format off
+    Statement stmt = getStatement(
+        "REPLACE INTO region_download_cursors (region_id, url_template, tile_count, tile_index, completed_size) "
+        "VALUES                               (?1,        ?2,           ?3,         ?4,         ?5) ");
+    // clang-format on
+
+    stmt->bind(1, regionID);
+    stmt->bind(2, urlTemplate);
+    stmt->bind(3, int64_t(cursor.tileCount));
+    stmt->bind(4, int64_t(cursor.tileIndex));
+    stmt->bind(5, int64_t(cursor.completedSize));
+    stmt->run();
+}
+
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(int64_t regionID) {
     // clang-format off
     Statement stmt = getStatement(
@@ -751,12 +1351,14 @@ std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(in
 }
 
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedTileCountAndSize(int64_t regionID) {
+    // Tiles that share a blob each count its full size, as they do while downloading.
     // clang-format off
     Statement stmt = getStatement(
-        "SELECT COUNT(*), SUM(LENGTH(data)) "
-        "FROM region_tiles, tiles "
-        "WHERE region_id = ?1 "
-        "AND tile_id = tiles.id ");
+        "SELECT COUNT(*), SUM(LENGTH(tile_blobs.data)) "
+        "FROM region_tiles "
+        "JOIN tiles ON tile_id = tiles.id "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = tiles.blob_id "
+        "WHERE region_id = ?1 ");
     // clang-format on
     stmt->bind(1, regionID);
     stmt->run();
@@ -779,18 +1381,37 @@ T OfflineDatabase::getPragma(const char * sql) {
 // are monitoring the soft limit (i.e. number of free pages in the file)
 // and as it approaches to the hard limit (i.e. the actual file size) we
 // delete an arbitrary number of old cache entries. The free pages approach saves
-// us from calling VACCUM or keeping a running total, which can be costly.
-bool OfflineDatabase::evict(uint64_t neededFreeSize) {
-    uint64_t pageSize = getPragma<int64_t>("PRAGMA page_size");
+// us from calling VACCUM.
+//
+// Measuring the used size takes a couple of PRAGMA queries, so between
+// measurements we keep a running estimate that is bumped by every entry we
+// make room for, plus a per-row allowance for the non `data` columns and the
+// indices. The estimate errs on the high side; once it reaches the limit we
+// measure again, and only then consider evicting anything.
+bool OfflineDatabase::evict(uint64_t neededFreeSize, uint64_t entryCount) {
+    static const uint64_t rowOverhead = 256;
+
+    if (!pageSize) {
+        pageSize = getPragma<int64_t>("PRAGMA page_size");
+    }
+
+    // The addition of pageSize is a fudge factor to account for non `data` column
+    // size, and because pages can get fragmented on the database.
+    if (usedSizeEstimate && *usedSizeEstimate + neededFreeSize + *pageSize <= maximumCacheSize) {
+        *usedSizeEstimate += neededFreeSize + entryCount * rowOverhead;
+        return true;
+    }
+
+    usedSizeEstimate = {};
+
     uint64_t pageCount = getPragma<int64_t>("PRAGMA page_count");
 
     auto usedSize = [&] {
-        return pageSize * (pageCount - getPragma<int64_t>("PRAGMA freelist_count"));
+        return *pageSize * (pageCount - getPragma<int64_t>("PRAGMA freelist_count"));
     };
 
-    // The addition of pageSize is a fudge factor to account for non `data` column
-    // size, and because pages can get fragmented on the database.
-    while (usedSize() + neededFreeSize + pageSize > maximumCacheSize) {
+    uint64_t used;
+    while ((used = usedSize()) + neededFreeSize + *pageSize > maximumCacheSize) {
         // clang-format off
         Statement accessedStmt = getStatement(
             "SELECT max(accessed) "
@@ -816,6 +1437,8 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
         }
         Timestamp accessed = accessedStmt->get<Timestamp>(0);
         
+        mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
         // clang-format off
         Statement stmt1 = getStatement(
             "DELETE FROM resources "
@@ -831,20 +1454,39 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
         stmt1->run();
         uint64_t changes1 = stmt1->changes();
 
+        // Evicted tiles give up their references to blobs one by one, since several
+        // of them may share one; only blobs that no other tile uses are freed.
+        std::vector<std::pair<int64_t, optional<int64_t>>> evicted;
+        {
+            // clang-format off
+            Statement stmt2 = getStatement(
+                "SELECT tiles.id, blob_id FROM tiles "
+                "LEFT JOIN region_tiles "
+                "ON tile_id = tiles.id "
+                "WHERE tile_id IS NULL "
+                "AND accessed <= ?1 ");
+            // clang-format on
+            stmt2->bind(1, accessed);
+            while (stmt2->run()) {
+                evicted.emplace_back(stmt2->get<int64_t>(0), stmt2->get<optional<int64_t>>(1));
+            }
+        }
+
         // clang-format off
-        Statement stmt2 = getStatement(
-            "DELETE FROM tiles "
-            "WHERE id IN ( "
-            "  SELECT id FROM tiles "
-            "  LEFT JOIN region_tiles "
-            "  ON tile_id = tiles.id "
-            "  WHERE tile_id IS NULL "
-            "  AND accessed <= ?1 "
-            ") ");
+        Statement stmt3 = getStatement(
+            "DELETE FROM tiles WHERE id = ?1 ");
         // clang-format on
-        stmt2->bind(1, accessed);
-        stmt2->run();
-        uint64_t changes2 = stmt2->changes();
+        for (const auto& tile : evicted) {
+            stmt3->bind(1, tile.first);
+            stmt3->run();
+            stmt3->reset();
+            if (tile.second) {
+                releaseTileBlob(*tile.second);
+            }
+        }
+        uint64_t changes2 = evicted.size();
+
+        transaction.commit();
 
         // The cached value of offlineTileCount does not need to be updated
         // here because only non-offline tiles can be removed by eviction.
@@ -854,6 +1496,7 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
         }
     }
 
+    usedSizeEstimate = used + neededFreeSize + entryCount * rowOverhead;
     return true;
 }
 
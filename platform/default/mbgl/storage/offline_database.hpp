@@ -7,9 +7,11 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
 
+#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -23,6 +25,15 @@ namespace mbgl {
 class Response;
 class TileID;
 
+// How far the download of a region got through the tile cover of one of its sources: all
+// tiles before `tileIndex` are stored in the region, and their total size is `completedSize`.
+// A cursor only applies to a cover of `tileCount` tiles.
+struct OfflineDownloadCursor {
+    uint64_t tileCount = 0;
+    uint64_t tileIndex = 0;
+    uint64_t completedSize = 0;
+};
+
 class OfflineDatabase : private util::noncopyable {
 public:
     // Limits affect ambient caching (put) only; resources required by offline
@@ -35,6 +46,11 @@ public:
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
+    // Stores a batch of ambient cache entries in a single transaction, making
+    // room for all of them with one eviction pass. Return values are as above,
+    // in the order of the batch.
+    std::vector<std::pair<bool, uint64_t>> put(const std::vector<std::pair<Resource, Response>>&);
+
     std::vector<OfflineRegion> listRegions();
 
     OfflineRegion createRegion(const OfflineRegionDefinition&,
@@ -49,9 +65,23 @@ public:
     optional<int64_t> hasRegionResource(int64_t regionID, const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
 
+    // Checks a batch of tiles with a single transaction, marking the ones that are stored as
+    // used by the region. Return values are the stored sizes, in the order of the batch.
+    std::vector<optional<int64_t>> hasRegionTiles(int64_t regionID, const std::vector<Resource>& tiles);
+
+    // Add the tiles and resources of another offline database, or the tiles of an MBTiles file,
+    // to the region, without requesting them. Entries this database already has are kept.
+    // Return value is the number of tiles and resources that weren't part of the region yet.
+    uint64_t importDatabase(int64_t regionID, const std::string& sourcePath);
+    uint64_t importMBTiles(int64_t regionID, const std::string& sourcePath,
+                           const std::string& urlTemplate, float pixelRatio);
+
     OfflineRegionDefinition getRegionDefinition(int64_t regionID);
     OfflineRegionStatus getRegionCompletedStatus(int64_t regionID);
 
+    optional<OfflineDownloadCursor> getRegionDownloadCursor(int64_t regionID, const std::string& urlTemplate);
+    void putRegionDownloadCursor(int64_t regionID, const std::string& urlTemplate, const OfflineDownloadCursor&);
+
     void setOfflineMapboxTileCountLimit(uint64_t);
     uint64_t getOfflineMapboxTileCountLimit();
     bool offlineMapboxTileCountLimitExceeded();
@@ -64,6 +94,8 @@ private:
     void removeExisting();
     void migrateToVersion3();
     void migrateToVersion5();
+    void migrateToVersion6();
+    void migrateToVersion7();
 
     class Statement {
     public:
@@ -85,6 +117,17 @@ private:
     bool putTile(const Resource::TileData&, const Response&,
                  const std::string&, bool compressed);
 
+    // Return value is the tile's (id, blob id), if it is stored.
+    optional<std::pair<int64_t, optional<int64_t>>> findTile(const Resource::TileData&);
+    void insertTile(const Resource::TileData&, const Response&,
+                    const std::string&, bool compressed);
+
+    // Tiles with the same content share a single row in tile_blobs. Acquiring a blob finds or
+    // stores one holding `data` and adds a reference to it; releasing the last reference
+    // deletes it.
+    int64_t acquireTileBlob(const std::string& data, bool compressed);
+    void releaseTileBlob(int64_t blobID);
+
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
@@ -93,10 +136,14 @@ private:
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
     std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
+    bool putEncoded(const Resource&, const Response&, const std::string& compressedData, bool compressed);
 
     // Return value is true iff the resource was previously unused by any other regions.
     bool markUsed(int64_t regionID, const Resource&);
 
+    // Attaches the database at `sourcePath` as `source` while `merge` runs in a transaction.
+    uint64_t importInto(const std::string& sourcePath, std::function<uint64_t ()> merge);
+
     std::pair<int64_t, int64_t> getCompletedResourceCountAndSize(int64_t regionID);
     std::pair<int64_t, int64_t> getCompletedTileCountAndSize(int64_t regionID);
 
@@ -112,7 +159,17 @@ private:
     uint64_t offlineMapboxTileCountLimit = util::mapbox::DEFAULT_OFFLINE_TILE_COUNT_LIMIT;
     optional<uint64_t> offlineMapboxTileCount;
 
-    bool evict(uint64_t neededFreeSize);
+    bool evict(uint64_t neededFreeSize, uint64_t entryCount = 1);
+
+    // Set while a batched put holds the write transaction, so that the individual
+    // inserts don't try to open nested ones.
+    bool inBatchTransaction = false;
+
+    // Running estimate of the used database size, so that puts don't have to
+    // query the page counts while there is plenty of room left. Reset whenever
+    // rows are deleted.
+    optional<uint64_t> usedSizeEstimate;
+    optional<uint64_t> pageSize;
 };
 
 } // namespace mbgl
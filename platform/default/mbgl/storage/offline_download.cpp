@@ -13,6 +13,7 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <cassert>
 #include <set>
 
 namespace mbgl {
@@ -81,15 +82,15 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
 
             if (urlOrTileset.is<Tileset>()) {
                 result.requiredResourceCount +=
-                    definition.tileCover(type, tileSize, urlOrTileset.get<Tileset>().zoomRange).size();
+                    definition.tileCount(type, tileSize, urlOrTileset.get<Tileset>().zoomRange);
             } else {
                 result.requiredResourceCount += 1;
                 const std::string& url = urlOrTileset.get<std::string>();
                 optional<Response> sourceResponse = offlineDatabase.get(Resource::source(url));
                 if (sourceResponse) {
                     result.requiredResourceCount +=
-                        definition.tileCover(type, tileSize, style::TileSourceImpl::parseTileJSON(
-                            *sourceResponse->data, url, type, tileSize).zoomRange).size();
+                        definition.tileCount(type, tileSize, style::TileSourceImpl::parseTileJSON(
+                            *sourceResponse->data, url, type, tileSize).zoomRange);
                 } else {
                     result.requiredResourceCountIsPrecise = false;
                 }
@@ -226,12 +227,30 @@ void OfflineDownload::continueDownload() {
         ensureResource(resourcesRemaining.front());
         resourcesRemaining.pop_front();
     }
+
+    for (auto& queue : tileQueues) {
+        while (requests.size() < HTTPFileSource::maximumConcurrentRequests()) {
+            if (!queue.missing.empty()) {
+                requestTile(queue);
+            } else if (!queue.checking && queue.nextIndex < queue.cursor.tileCount &&
+                       queue.pending.size() < maxPendingTiles) {
+                ensureTiles(queue);
+            } else {
+                break;
+            }
+        }
+    }
 }
 
 void OfflineDownload::deactivateDownload() {
+    for (auto& queue : tileQueues) {
+        saveCursor(queue);
+    }
+
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
     requests.clear();
+    tileQueues.clear();
 }
 
 void OfflineDownload::queueResource(Resource resource) {
@@ -240,13 +259,140 @@ void OfflineDownload::queueResource(Resource resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    for (const auto& tile : definition.tileCover(type, tileSize, tileset.zoomRange)) {
-        status.requiredResourceCount++;
-        resourcesRemaining.push_back(
-            Resource::tile(tileset.tiles[0], definition.pixelRatio, tile.x, tile.y, tile.z, tileset.scheme));
+    tileQueues.emplace_back();
+    TileQueue& queue = tileQueues.back();
+    queue.urlTemplate = tileset.tiles[0];
+    queue.scheme = tileset.scheme;
+
+    const Range<uint8_t> zoomRange = definition.coveringZoomRange(type, tileSize, tileset.zoomRange);
+    for (uint8_t z = zoomRange.min; z <= zoomRange.max; z++) {
+        queue.ranges.emplace_back(definition.bounds, z);
+        queue.cursor.tileCount += queue.ranges.back().size();
+    }
+
+    status.requiredResourceCount += queue.cursor.tileCount;
+
+    // Pick up where an earlier download of this region stopped, unless the tile cover
+    // changed since, e.g. because the source's zoom range did.
+    optional<OfflineDownloadCursor> saved = offlineDatabase.getRegionDownloadCursor(id, queue.urlTemplate);
+    if (saved && saved->tileCount == queue.cursor.tileCount && saved->tileIndex <= saved->tileCount) {
+        queue.cursor = *saved;
+        queue.seek(saved->tileIndex);
+
+        status.completedResourceCount += saved->tileIndex;
+        status.completedResourceSize += saved->completedSize;
+        status.completedTileCount += saved->tileIndex;
+        status.completedTileSize += saved->completedSize;
+    }
+
+    queue.savedTileIndex = queue.cursor.tileIndex;
+}
+
+void OfflineDownload::TileQueue::seek(uint64_t index) {
+    nextIndex = index;
+    range = 0;
+    rangeIndex = index;
+    while (range < ranges.size() && rangeIndex >= ranges[range].size()) {
+        rangeIndex -= ranges[range].size();
+        range++;
     }
 }
 
+CanonicalTileID OfflineDownload::TileQueue::next() {
+    assert(nextIndex < cursor.tileCount);
+    while (rangeIndex == ranges[range].size()) {
+        range++;
+        rangeIndex = 0;
+    }
+    nextIndex++;
+    return ranges[range][rangeIndex++].canonical;
+}
+
+void OfflineDownload::ensureTiles(TileQueue& queue) {
+    const uint64_t first = queue.nextIndex;
+    std::vector<Resource> batch;
+    while (batch.size() < tileBatchSize && queue.nextIndex < queue.cursor.tileCount &&
+           queue.pending.size() < maxPendingTiles) {
+        queue.pending.emplace(queue.nextIndex, optional<uint64_t>());
+        const CanonicalTileID tile = queue.next();
+        batch.push_back(Resource::tile(queue.urlTemplate, definition.pixelRatio, tile.x, tile.y, tile.z, queue.scheme));
+    }
+
+    queue.checking = true;
+
+    // Queues live in a list, and are only destroyed along with the requests.
+    TileQueue* queuePtr = &queue;
+    auto workRequestsIt = requests.insert(requests.begin(), nullptr);
+    *workRequestsIt = util::RunLoop::Get()->invokeCancellable([=]() {
+        requests.erase(workRequestsIt);
+        queuePtr->checking = false;
+
+        const std::vector<optional<int64_t>> sizes = offlineDatabase.hasRegionTiles(id, batch);
+
+        bool found = false;
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            if (sizes[i]) {
+                status.completedResourceCount++;
+                status.completedResourceSize += *sizes[i];
+                status.completedTileCount += 1;
+                status.completedTileSize += *sizes[i];
+                tileStored(*queuePtr, first + i, *sizes[i]);
+                found = true;
+            } else {
+                queuePtr->missing.emplace_back(first + i, batch[i]);
+            }
+        }
+
+        if (found) {
+            observer->statusChanged(status);
+        }
+
+        if (!queuePtr->missing.empty() && checkTileCountLimit(queuePtr->missing.front().second)) {
+            return;
+        }
+
+        continueDownload();
+    });
+}
+
+void OfflineDownload::requestTile(TileQueue& queue) {
+    const uint64_t index = queue.missing.front().first;
+    const Resource resource = std::move(queue.missing.front().second);
+    queue.missing.pop_front();
+
+    TileQueue* queuePtr = &queue;
+    requestResource(resource, {}, [this, queuePtr, index](uint64_t size) {
+        tileStored(*queuePtr, index, size);
+    });
+}
+
+void OfflineDownload::tileStored(TileQueue& queue, uint64_t index, uint64_t size) {
+    queue.pending[index] = size;
+
+    // Tiles may be stored out of order; the cursor only moves past contiguous ones.
+    while (!queue.pending.empty() && queue.pending.begin()->second) {
+        queue.cursor.tileIndex = queue.pending.begin()->first + 1;
+        queue.cursor.completedSize += *queue.pending.begin()->second;
+        queue.pending.erase(queue.pending.begin());
+    }
+
+    // Save the cursor every so often, rather than after every tile. Tiles stored after the
+    // saved cursor aren't lost if the download is interrupted; they are just checked again.
+    if (queue.cursor.tileIndex >= queue.savedTileIndex + 64 ||
+        queue.cursor.tileIndex == queue.cursor.tileCount) {
+        saveCursor(queue);
+    }
+}
+
+void OfflineDownload::saveCursor(TileQueue& queue) {
+    if (queue.cursor.tileIndex == queue.savedTileIndex) {
+        return;
+    }
+
+    offlineDatabase.putRegionDownloadCursor(id, queue.urlTemplate, queue.cursor);
+    queue.savedTileIndex = queue.cursor.tileIndex;
+}
+
 void OfflineDownload::ensureResource(const Resource& resource,
                                      std::function<void(Response)> callback) {
     auto workRequestsIt = requests.insert(requests.begin(), nullptr);
@@ -283,35 +429,45 @@ void OfflineDownload::ensureResource(const Resource& resource,
             return;
         }
 
-        auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
-        *fileRequestsIt = onlineFileSource.request(resource, [=](Response onlineResponse) {
-            if (onlineResponse.error) {
-                observer->responseError(*onlineResponse.error);
-                return;
-            }
+        requestResource(resource, callback);
+    });
+}
 
-            requests.erase(fileRequestsIt);
+void OfflineDownload::requestResource(const Resource& resource,
+                                      std::function<void(Response)> callback,
+                                      std::function<void(uint64_t)> stored) {
+    auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
+    *fileRequestsIt = onlineFileSource.request(resource, [=](Response onlineResponse) {
+        if (onlineResponse.error) {
+            observer->responseError(*onlineResponse.error);
+            return;
+        }
 
-            if (callback) {
-                callback(onlineResponse);
-            }
+        requests.erase(fileRequestsIt);
 
-            status.completedResourceCount++;
-            uint64_t resourceSize = offlineDatabase.putRegionResource(id, resource, onlineResponse);
-            status.completedResourceSize += resourceSize;
-            if (resource.kind == Resource::Kind::Tile) {
-                status.completedTileCount += 1;
-                status.completedTileSize += resourceSize;
-            }
+        if (callback) {
+            callback(onlineResponse);
+        }
 
-            observer->statusChanged(status);
+        status.completedResourceCount++;
+        uint64_t resourceSize = offlineDatabase.putRegionResource(id, resource, onlineResponse);
+        status.completedResourceSize += resourceSize;
+        if (resource.kind == Resource::Kind::Tile) {
+            status.completedTileCount += 1;
+            status.completedTileSize += resourceSize;
+        }
 
-            if (checkTileCountLimit(resource)) {
-                return;
-            }
+        if (stored) {
+            stored(resourceSize);
+        }
 
-            continueDownload();
-        });
+        observer->statusChanged(status);
+
+        if (checkTileCountLimit(resource)) {
+            return;
+        }
+
+        continueDownload();
     });
 }
 
@@ -1,20 +1,22 @@
 #pragma once
 
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/util/tile_cover.hpp>
+#include <mbgl/util/tileset.hpp>
 
 #include <list>
+#include <map>
 #include <unordered_set>
 #include <memory>
 #include <deque>
 
 namespace mbgl {
 
-class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
 class Response;
-class Tileset;
 
 namespace style {
 class Parser;
@@ -46,8 +48,60 @@ private:
      * is deactivated, all in progress requests are cancelled.
      */
     void ensureResource(const Resource&, std::function<void (Response)> = {});
+
+    /*
+     * Request the resource and store it, without checking the database first. Once the
+     * resource is stored, `stored` is called with its size.
+     */
+    void requestResource(const Resource&,
+                         std::function<void (Response)> = {},
+                         std::function<void (uint64_t)> stored = {});
     bool checkTileCountLimit(const Resource& resource);
-    
+
+    /*
+     * The tiles of a source. Rather than being queued up front, they are enumerated from
+     * the region's tile cover as requests become available. `cursor` trails the requests:
+     * it is the first tile that isn't stored yet, and it is saved to the database, so that
+     * a later download of the region can skip the tiles before it.
+     */
+    struct TileQueue {
+        std::string urlTemplate;
+        Tileset::Scheme scheme;
+        std::vector<util::TileRange> ranges;
+
+        // The next tile to request, by its index in the whole cover and in `ranges`.
+        uint64_t nextIndex = 0;
+        std::size_t range = 0;
+        uint64_t rangeIndex = 0;
+
+        // Tiles that have been enumerated, but are at or after the cursor; the size is set
+        // once the tile is stored.
+        std::map<uint64_t, optional<uint64_t>> pending;
+
+        // Tiles are checked against the database in batches; the ones that aren't stored
+        // wait here to be requested.
+        bool checking = false;
+        std::deque<std::pair<uint64_t, Resource>> missing;
+
+        OfflineDownloadCursor cursor;
+        uint64_t savedTileIndex = 0;
+
+        void seek(uint64_t index);
+        CanonicalTileID next();
+    };
+
+    static constexpr std::size_t tileBatchSize = 128;
+
+    // Tiles after one that is slow or keeps failing are still requested and stored, but the
+    // cursor can't move past them. Enumeration pauses once this many tiles are pending, so
+    // that the map of pending tiles stays bounded.
+    static constexpr std::size_t maxPendingTiles = 4 * tileBatchSize;
+
+    void ensureTiles(TileQueue&);
+    void requestTile(TileQueue&);
+    void tileStored(TileQueue&, uint64_t index, uint64_t size);
+    void saveCursor(TileQueue&);
+
     int64_t id;
     OfflineRegionDefinition definition;
     OfflineDatabase& offlineDatabase;
@@ -58,6 +112,7 @@ private:
     std::list<std::unique_ptr<AsyncRequest>> requests;
     std::unordered_set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
+    std::list<TileQueue> tileQueues;
 
     void queueResource(Resource);
     void queueTiles(SourceType, uint16_t tileSize, const Tileset&);
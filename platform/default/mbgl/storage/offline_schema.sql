@@ -21,12 +21,19 @@ CREATE TABLE tiles (
   expires INTEGER,
   modified INTEGER,
   etag TEXT,
-  data BLOB,
-  compressed INTEGER NOT NULL DEFAULT 0,
+  blob_id INTEGER REFERENCES tile_blobs(id),  -- NULL for tiles without content.
   accessed INTEGER NOT NULL,
   UNIQUE (url_template, pixel_ratio, z, x, y)
 );
 
+CREATE TABLE tile_blobs (                 -- Tile data, stored once for all tiles with the same content.
+  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,
+  hash INTEGER NOT NULL,                    -- Hash of the stored (possibly compressed) data.
+  data BLOB NOT NULL,
+  compressed INTEGER NOT NULL DEFAULT 0,
+  ref_count INTEGER NOT NULL                -- Number of tiles using the blob; it's removed when this drops to zero.
+);
+
 CREATE TABLE regions (
   id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,
   definition TEXT NOT NULL,   -- JSON formatted definition of region. Regions may be of variant types:
@@ -47,6 +54,15 @@ CREATE TABLE region_tiles (
   UNIQUE (region_id, tile_id)
 );
 
+CREATE TABLE region_download_cursors (    -- How far a region's download got through the tiles of each source.
+  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,
+  url_template TEXT NOT NULL,
+  tile_count INTEGER NOT NULL,              -- Size of the source's tile cover when the cursor was stored.
+  tile_index INTEGER NOT NULL,              -- All tiles of the cover before this one are stored.
+  completed_size INTEGER NOT NULL,          -- Total size of the tiles before tile_index.
+  UNIQUE (region_id, url_template)
+);
+
 -- Indexes for efficient eviction queries
 
 CREATE INDEX resources_accessed
@@ -60,3 +76,8 @@ ON region_resources (resource_id);
 
 CREATE INDEX region_tiles_tile_id
 ON region_tiles (tile_id);
+
+-- Index for looking up blobs by content
+
+CREATE INDEX tile_blobs_hash
+ON tile_blobs (hash);
@@ -1,5 +1,6 @@
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/thread_local.hpp>
 
 namespace mbgl {
 
@@ -50,4 +51,125 @@ void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
     cv.notify_one();
 }
 
+WorkStealingThreadPool::WorkStealingThreadPool(std::size_t count)
+    : current(std::make_unique<util::ThreadLocal<Worker>>()) {
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    threads.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        threads.emplace_back([this, i] () {
+            run(i);
+        });
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        terminate = true;
+    }
+
+    cv.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
+    auto priority = Priority::Normal;
+    if (auto locked = mailbox.lock()) {
+        priority = locked->getPriority();
+    } else {
+        // The actor is already gone; there is nothing left to process.
+        return;
+    }
+
+    Worker* worker = current->get();
+    if (!worker) {
+        worker = workers[nextWorker++ % workers.size()].get();
+    }
+
+    // `pending` is incremented before `idle` is read, and sleeping threads increment `idle`
+    // before checking `pending`, so a wakeup can't get lost between the two.
+    ++pending;
+    push(*worker, static_cast<std::size_t>(priority), std::move(mailbox));
+
+    if (idle > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        cv.notify_one();
+    }
+}
+
+void WorkStealingThreadPool::push(Worker& worker, std::size_t priority, std::weak_ptr<Mailbox> mailbox) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queues[priority].push_back(std::move(mailbox));
+    ++worker.sizes[priority];
+}
+
+bool WorkStealingThreadPool::pop(std::size_t index, std::weak_ptr<Mailbox>& mailbox) {
+    const std::size_t count = workers.size();
+
+    for (std::size_t priority = priorityCount; priority-- > 0;) {
+        // Look at our own queue first, then try to steal from the other threads.
+        for (std::size_t offset = 0; offset < count; ++offset) {
+            Worker& worker = *workers[(index + offset) % count];
+            if (worker.sizes[priority] == 0) {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+
+            // The owning thread takes the oldest entry to keep its own work roughly FIFO,
+            // while thieves take from the other end to avoid contending with the owner.
+            if (offset == 0) {
+                mailbox = std::move(queue.front());
+                queue.pop_front();
+            } else {
+                mailbox = std::move(queue.back());
+                queue.pop_back();
+            }
+            --worker.sizes[priority];
+            --pending;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingThreadPool::run(std::size_t index) {
+    current->set(workers[index].get());
+
+    std::weak_ptr<Mailbox> mailbox;
+    while (true) {
+        if (pop(index, mailbox)) {
+            Mailbox::maybeReceive(std::move(mailbox));
+            mailbox.reset();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        ++idle;
+        cv.wait(lock, [this] {
+            return pending > 0 || terminate;
+        });
+        --idle;
+
+        if (terminate) {
+            break;
+        }
+    }
+
+    // Unset the pointer so that ThreadLocal doesn't attempt to delete the worker.
+    current->set(nullptr);
+}
+
 } // namespace mbgl
@@ -2,13 +2,20 @@
 
 #include <mbgl/actor/scheduler.hpp>
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <queue>
 #include <thread>
 
 namespace mbgl {
 
+namespace util {
+template <class> class ThreadLocal;
+} // namespace util
+
 class ThreadPool : public Scheduler {
 public:
     ThreadPool(std::size_t count);
@@ -24,4 +31,50 @@ private:
     bool terminate { false };
 };
 
+// A thread pool that keeps a separate set of queues per thread, one for each
+// `Scheduler::Priority`. Mailboxes scheduled from a pool thread go to that thread's
+// own queue; mailboxes scheduled from elsewhere are distributed round-robin. Idle
+// threads steal work from the other threads' queues, always picking the highest
+// priority work available in the pool.
+class WorkStealingThreadPool : public Scheduler {
+public:
+    WorkStealingThreadPool(std::size_t count);
+    ~WorkStealingThreadPool() override;
+
+    void schedule(std::weak_ptr<Mailbox>) override;
+
+private:
+    static constexpr std::size_t priorityCount = 3;
+
+    class Worker {
+    public:
+        std::mutex mutex;
+        std::array<std::deque<std::weak_ptr<Mailbox>>, priorityCount> queues;
+
+        // Number of mailboxes queued at each priority; lets other threads skip empty
+        // queues without taking the lock.
+        std::array<std::atomic<std::size_t>, priorityCount> sizes {};
+    };
+
+    void run(std::size_t index);
+    void push(Worker&, std::size_t priority, std::weak_ptr<Mailbox>);
+    bool pop(std::size_t index, std::weak_ptr<Mailbox>&);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    // Set on pool threads to the worker they're running, so that mailboxes scheduled
+    // from within the pool stay on the same thread.
+    std::unique_ptr<util::ThreadLocal<Worker>> current;
+
+    std::atomic<std::size_t> nextWorker { 0 };
+    std::atomic<std::size_t> pending { 0 };
+
+    // Only used for putting idle threads to sleep and waking them up again.
+    std::atomic<std::size_t> idle { 0 };
+    std::mutex sleepMutex;
+    std::condition_variable cv;
+    std::atomic<bool> terminate { false };
+};
+
 } // namespace mbgl
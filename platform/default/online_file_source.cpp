@@ -14,12 +14,14 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/http_timeout.hpp>
+#include <mbgl/util/tracing.hpp>
 
 #include <algorithm>
 #include <cassert>
-#include <list>
+#include <limits>
+#include <tuple>
 #include <unordered_set>
-#include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
@@ -50,8 +52,16 @@ public:
     uint32_t failedRequests = 0;
     Response::Error::Reason failedRequestReason = Response::Error::Reason::Success;
     optional<Timestamp> retryAfter;
+
+    // Position in the pending request heap, or `notPending`, and the order in which the
+    // request was queued, which breaks ties between requests of equal priority.
+    static constexpr std::size_t notPending = std::numeric_limits<std::size_t>::max();
+    std::size_t pendingIndex = notPending;
+    uint64_t pendingSequence = 0;
 };
 
+constexpr std::size_t OnlineFileRequest::notPending;
+
 class OnlineFileSource::Impl {
 public:
     Impl() {
@@ -70,14 +80,9 @@ public:
         allRequests.erase(request);
         if (activeRequests.erase(request)) {
             activatePendingRequest();
-        } else {
-            auto it = pendingRequestsMap.find(request);
-            if (it != pendingRequestsMap.end()) {
-                pendingRequestsList.erase(it->second);
-                pendingRequestsMap.erase(it);
-            }
+        } else if (isPending(request)) {
+            removePendingRequest(request->pendingIndex);
         }
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
     }
 
     void activateOrQueueRequest(OnlineFileRequest* request) {
@@ -93,38 +98,48 @@ public:
     }
 
     void queueRequest(OnlineFileRequest* request) {
-        auto it = pendingRequestsList.insert(pendingRequestsList.end(), request);
-        pendingRequestsMap.emplace(request, std::move(it));
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        request->pendingSequence = nextPendingSequence++;
+        request->pendingIndex = pendingRequests.size();
+        pendingRequests.push_back(request);
+        siftUp(request->pendingIndex);
     }
 
     void activateRequest(OnlineFileRequest* request) {
         activeRequests.insert(request);
+        const TimePoint start = Clock::now();
         request->request = httpFileSource.request(request->resource, [=] (Response response) {
+            if (tracing::isEnabled()) {
+                tracing::record("network", request->resource.url, start, Clock::now());
+            }
             activeRequests.erase(request);
             activatePendingRequest();
             request->request.reset();
             request->completed(response);
         });
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+    }
+
+    // Moves a queued request to its new place in the heap after its necessity or viewport
+    // distance has changed. Requests that aren't queued pick up the new rank the next time
+    // they are.
+    void updatePendingRequest(OnlineFileRequest* request) {
+        if (isPending(request)) {
+            siftDown(siftUp(request->pendingIndex));
+        }
     }
 
     void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
+        if (pendingRequests.empty()) {
             return;
         }
 
-        OnlineFileRequest* request = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
-
-        pendingRequestsMap.erase(request);
+        OnlineFileRequest* request = pendingRequests.front();
+        removePendingRequest(0);
 
         activateRequest(request);
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
     }
     
     bool isPending(OnlineFileRequest* request) {
-        return pendingRequestsMap.find(request) != pendingRequestsMap.end();
+        return request->pendingIndex != OnlineFileRequest::notPending;
     }
     
     bool isActive(OnlineFileRequest* request) {
@@ -132,6 +147,87 @@ public:
     }
 
 private:
+    // Resources the map can't render anything without come first, then resources that
+    // are required over optional ones. Tiles at lower zoom levels cover more of the
+    // viewport and are fetched before tiles at higher zoom levels, and tiles close to
+    // the center of the viewport before those at its edges.
+    static uint8_t kindRank(Resource::Kind kind) {
+        switch (kind) {
+        case Resource::Kind::Style:
+        case Resource::Kind::Source:
+            return 0;
+        case Resource::Kind::SpriteJSON:
+        case Resource::Kind::SpriteImage:
+        case Resource::Kind::Glyphs:
+            return 1;
+        case Resource::Kind::Unknown:
+            return 2;
+        case Resource::Kind::Tile:
+            return 3;
+        }
+        return 3;
+    }
+
+    static bool isMoreUrgent(const OnlineFileRequest* a, const OnlineFileRequest* b) {
+        const Resource& ra = a->resource;
+        const Resource& rb = b->resource;
+        const int8_t za = ra.tileData ? ra.tileData->z : 0;
+        const int8_t zb = rb.tileData ? rb.tileData->z : 0;
+        return std::make_tuple(kindRank(ra.kind), !ra.necessity, za, ra.viewportDistance, a->pendingSequence) <
+               std::make_tuple(kindRank(rb.kind), !rb.necessity, zb, rb.viewportDistance, b->pendingSequence);
+    }
+
+    void swapPendingRequests(std::size_t i, std::size_t j) {
+        std::swap(pendingRequests[i], pendingRequests[j]);
+        pendingRequests[i]->pendingIndex = i;
+        pendingRequests[j]->pendingIndex = j;
+    }
+
+    std::size_t siftUp(std::size_t i) {
+        while (i > 0) {
+            const std::size_t parent = (i - 1) / 2;
+            if (!isMoreUrgent(pendingRequests[i], pendingRequests[parent])) {
+                break;
+            }
+            swapPendingRequests(i, parent);
+            i = parent;
+        }
+        return i;
+    }
+
+    void siftDown(std::size_t i) {
+        const std::size_t size = pendingRequests.size();
+        while (true) {
+            std::size_t first = i;
+            for (std::size_t child = 2 * i + 1; child <= 2 * i + 2 && child < size; ++child) {
+                if (isMoreUrgent(pendingRequests[child], pendingRequests[first])) {
+                    first = child;
+                }
+            }
+            if (first == i) {
+                return;
+            }
+            swapPendingRequests(i, first);
+            i = first;
+        }
+    }
+
+    void removePendingRequest(std::size_t i) {
+        assert(i < pendingRequests.size());
+        pendingRequests[i]->pendingIndex = OnlineFileRequest::notPending;
+
+        const std::size_t last = pendingRequests.size() - 1;
+        if (i != last) {
+            pendingRequests[i] = pendingRequests[last];
+            pendingRequests[i]->pendingIndex = i;
+        }
+        pendingRequests.pop_back();
+
+        if (i < pendingRequests.size()) {
+            siftDown(siftUp(i));
+        }
+    }
+
     void networkIsReachableAgain() {
         for (auto& request : allRequests) {
             request->networkIsReachableAgain();
@@ -147,11 +243,12 @@ private:
      * 4. Back to #1
      *
      * Requests in any state are in `allRequests`. Requests in the pending state are in
-     * `pendingRequests`. Requests in the active state are in `activeRequests`.
+     * `pendingRequests`, a binary heap with the most urgent request at the front. Requests
+     * in the active state are in `activeRequests`.
      */
     std::unordered_set<OnlineFileRequest*> allRequests;
-    std::list<OnlineFileRequest*> pendingRequestsList;
-    std::unordered_map<OnlineFileRequest*, std::list<OnlineFileRequest*>::iterator> pendingRequestsMap;
+    std::vector<OnlineFileRequest*> pendingRequests;
+    uint64_t nextPendingSequence = 0;
     std::unordered_set<OnlineFileRequest*> activeRequests;
 
     HTTPFileSource httpFileSource;
@@ -196,6 +293,13 @@ std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource
     return std::make_unique<OnlineFileRequest>(std::move(res), std::move(callback), *impl);
 }
 
+void OnlineFileSource::setRequestPriority(AsyncRequest& req, Resource::Necessity necessity, float viewportDistance) {
+    auto& request = static_cast<OnlineFileRequest&>(req);
+    request.resource.necessity = necessity;
+    request.resource.viewportDistance = viewportDistance;
+    impl->updatePendingRequest(&request);
+}
+
 OnlineFileRequest::OnlineFileRequest(Resource resource_, Callback callback_, OnlineFileSource::Impl& impl_)
     : impl(impl_),
       resource(std::move(resource_)),
@@ -1,14 +1,22 @@
-#include <mbgl/util/compression.hpp>
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/premultiply.hpp>
+#include <mbgl/actor/fork_join.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #include <boost/crc.hpp>
 #pragma GCC diagnostic pop
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
 
 #define NETWORK_BYTE_UINT32(value)                                                                 \
     char(value >> 24), char(value >> 16), char(value >> 8), char(value >> 0)
@@ -33,26 +41,215 @@ void addChunk(std::string& png, const char* type, const char* data = "", const u
     png.append(crc, 4);
 }
 
+// Division-free unpremultiplication: `table[a][c]` holds `(255 * c + a / 2) / a`, the
+// same result util::unpremultiply() computes, without copying the whole image first.
+class UnpremultiplyTable {
+public:
+    UnpremultiplyTable() {
+        for (uint32_t c = 0; c < 256; ++c) {
+            table[0][c] = c;
+        }
+        for (uint32_t a = 1; a < 256; ++a) {
+            for (uint32_t c = 0; c < 256; ++c) {
+                table[a][c] = uint8_t((255 * c + a / 2) / a);
+            }
+        }
+    }
+
+    // Unpremultiplies a row of RGBA pixels. Opaque pixels, usually the bulk of a render,
+    // are copied as they are.
+    void operator()(const uint8_t* src, uint8_t* dst, std::size_t bytes) const {
+        for (std::size_t i = 0; i < bytes; i += 4) {
+            const uint8_t a = src[i + 3];
+            if (a == 255) {
+                std::memcpy(dst + i, src + i, 4);
+            } else {
+                const auto& row = table[a];
+                dst[i + 0] = row[src[i + 0]];
+                dst[i + 1] = row[src[i + 1]];
+                dst[i + 2] = row[src[i + 2]];
+                dst[i + 3] = a;
+            }
+        }
+    }
+
+private:
+    uint8_t table[256][256];
+};
+
+const UnpremultiplyTable& unpremultiplyTable() {
+    static const UnpremultiplyTable table;
+    return table;
+}
+
+enum FilterType : uint8_t {
+    FilterNone = 0,
+    FilterSub = 1,
+    FilterUp = 2,
+    FilterAverage = 3,
+    FilterPaeth = 4,
+};
+
+constexpr std::size_t filterCount = 5;
+constexpr std::size_t bytesPerPixel = 4;
+
+uint8_t paethPredictor(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    } else if (pb <= pc) {
+        return b;
+    } else {
+        return c;
+    }
+}
+
+// Applies `filter` to `row`, given the (unfiltered) row above it, and returns the sum of
+// the absolute values of the filtered bytes taken as signed. That sum is the heuristic the
+// PNG specification recommends for picking a filter per row.
+uint32_t applyFilter(FilterType filter, const uint8_t* row, const uint8_t* prior, uint8_t* out, std::size_t bytes) {
+    const std::size_t bpp = bytesPerPixel;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        const uint8_t left = i >= bpp ? row[i - bpp] : 0;
+        const uint8_t up = prior[i];
+        const uint8_t upLeft = i >= bpp ? prior[i - bpp] : 0;
+
+        switch (filter) {
+        case FilterNone:    out[i] = row[i]; break;
+        case FilterSub:     out[i] = row[i] - left; break;
+        case FilterUp:      out[i] = row[i] - up; break;
+        case FilterAverage: out[i] = row[i] - uint8_t((left + up) / 2); break;
+        case FilterPaeth:   out[i] = row[i] - paethPredictor(left, up, upLeft); break;
+        }
+    }
+
+    uint32_t sum = 0;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        sum += std::abs(int8_t(out[i]));
+    }
+    return sum;
+}
+
+// A horizontal band of the image that is filtered and compressed on its own.
+class Strip {
+public:
+    uint32_t begin;
+    uint32_t end;
+
+    // Filter type byte followed by the filtered scanline, for every row in the strip.
+    std::string filtered;
+    std::string compressed;
+    uLong adler = 0;
+};
+
+// Aim for strips of about this many bytes of raw image data. Smaller strips parallelize
+// better, but each one costs a flush and starts with a cold dictionary.
+constexpr std::size_t stripSize = 128 * 1024;
+
+// The deflate window, which is also how much of the previous strip is used to prime
+// each strip's dictionary.
+constexpr std::size_t windowSize = 32 * 1024;
+
+void filterStrip(const mbgl::PremultipliedImage& image, Strip& strip, bool adaptive) {
+    const std::size_t stride = image.stride();
+    const UnpremultiplyTable& unpremultiply = unpremultiplyTable();
+
+    std::vector<uint8_t> prior(stride, 0);
+    std::vector<uint8_t> row(stride);
+    std::array<std::vector<uint8_t>, filterCount> candidates;
+    for (auto& candidate : candidates) {
+        candidate.resize(stride);
+    }
+
+    if (strip.begin > 0) {
+        unpremultiply(image.data.get() + (strip.begin - 1) * stride, prior.data(), stride);
+    }
+
+    strip.filtered.reserve((strip.end - strip.begin) * (stride + 1));
+    for (uint32_t y = strip.begin; y < strip.end; ++y) {
+        unpremultiply(image.data.get() + y * stride, row.data(), stride);
+
+        FilterType best = FilterNone;
+        if (adaptive) {
+            uint32_t bestSum = std::numeric_limits<uint32_t>::max();
+            for (uint8_t filter = FilterNone; filter <= FilterPaeth; ++filter) {
+                const uint32_t sum = applyFilter(FilterType(filter), row.data(), prior.data(), candidates[filter].data(), stride);
+                if (sum < bestSum) {
+                    bestSum = sum;
+                    best = FilterType(filter);
+                }
+            }
+        } else {
+            applyFilter(FilterNone, row.data(), prior.data(), candidates[FilterNone].data(), stride);
+        }
+
+        strip.filtered.append(1, char(best));
+        strip.filtered.append(reinterpret_cast<const char*>(candidates[best].data()), stride);
+
+        std::swap(row, prior);
+    }
+
+    strip.adler = adler32(adler32(0, nullptr, 0), reinterpret_cast<const Bytef*>(strip.filtered.data()), uInt(strip.filtered.size()));
+}
+
+// Compresses a strip into a raw deflate stream. All but the last strip end in a sync
+// flush, so that the streams can simply be concatenated.
+void compressStrip(Strip& strip, const Strip* previous, bool last, int level) {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_FILTERED) != Z_OK) {
+        throw std::runtime_error("failed to initialize deflate");
+    }
+
+    if (previous) {
+        const std::size_t length = std::min(windowSize, previous->filtered.size());
+        deflateSetDictionary(&stream,
+            reinterpret_cast<const Bytef*>(previous->filtered.data() + previous->filtered.size() - length),
+            uInt(length));
+    }
+
+    // Leave room for the sync flush marker on top of the worst case.
+    strip.compressed.resize(deflateBound(&stream, uLong(strip.filtered.size())) + 16);
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(strip.filtered.data()));
+    stream.avail_in = uInt(strip.filtered.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&strip.compressed[0]);
+    stream.avail_out = uInt(strip.compressed.size());
+
+    const int code = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    strip.compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    if (code != (last ? Z_STREAM_END : Z_OK) || stream.avail_in != 0) {
+        throw std::runtime_error("failed to deflate image data");
+    }
+
+    // The filtered data is still needed as the next strip's dictionary.
+}
+
 } // namespace
 
 namespace mbgl {
 
-// Encode PNGs without libpng.
 std::string encodePNG(const PremultipliedImage& pre) {
-    const UnassociatedImage src = [&pre] {
-        // Make copy of the image so that we can unpremultiply it.
-        PremultipliedImage copy(pre.size);
-        std::copy(pre.data.get(), pre.data.get() + pre.bytes(), copy.data.get());
-        return util::unpremultiply(std::move(copy));
-    }();
+    return encodePNG(pre, PNGEncodeOptions());
+}
+
+// Encode PNGs without libpng.
+std::string encodePNG(const PremultipliedImage& pre, const PNGEncodeOptions& options) {
+    const int level = std::max(0, std::min(options.compressionLevel, 9));
 
     // PNG magic bytes
     const char preamble[8] = { char(0x89), 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
 
     // IHDR chunk for our RGBA image.
     const char ihdr[13] = {
-        NETWORK_BYTE_UINT32(src.size.width),  // width
-        NETWORK_BYTE_UINT32(src.size.height), // height
+        NETWORK_BYTE_UINT32(pre.size.width),  // width
+        NETWORK_BYTE_UINT32(pre.size.height), // height
         8,                                    // bit depth == 8 bits
         6,                                    // color type == RGBA
         0,                                    // compression method == deflate
@@ -60,15 +257,61 @@ std::string encodePNG(const PremultipliedImage& pre) {
         0,                                    // interlace method == none
     };
 
-    // Prepare the (compressed) data chunk.
-    const auto stride = src.stride();
+    // Split the image into strips of whole rows, which are filtered and then compressed
+    // independently, pigz-style.
+    const std::size_t stride = pre.stride();
+    const uint32_t rowsPerStrip = std::max<uint32_t>(1, stripSize / (stride + 1));
+    std::vector<Strip> strips;
+    for (uint32_t y = 0; y < pre.size.height; y += rowsPerStrip) {
+        strips.push_back({ y, std::min(pre.size.height, y + rowsPerStrip), {}, {}, 0 });
+    }
+
+    auto forEachStrip = [&] (std::function<void (std::size_t)> fn) {
+        if (options.scheduler) {
+            forkJoin(*options.scheduler, strips.size(), std::move(fn));
+        } else {
+            for (std::size_t i = 0; i < strips.size(); ++i) {
+                fn(i);
+            }
+        }
+    };
+
+    // Filtering isn't worth it when the data is stored uncompressed anyway.
+    const bool adaptive = level > 0;
+    forEachStrip([&] (std::size_t i) {
+        filterStrip(pre, strips[i], adaptive);
+    });
+
+    forEachStrip([&] (std::size_t i) {
+        compressStrip(strips[i], i > 0 ? &strips[i - 1] : nullptr, i + 1 == strips.size(), level);
+    });
+
+    // Wrap the concatenated deflate streams in a zlib header and trailer.
+    const uint8_t cmf = 0x78; // deflate, 32K window
+    uint8_t flg = (level <= 1 ? 0 : level <= 5 ? 1 : level == 6 ? 2 : 3) << 6;
+    flg += 31 - ((cmf * 256 + flg) % 31);
+
+    uLong adler = adler32(0, nullptr, 0);
+    std::size_t compressedSize = 2 + 4;
+    for (const auto& strip : strips) {
+        adler = adler32_combine(adler, strip.adler, z_off_t(strip.filtered.size()));
+        compressedSize += strip.compressed.size();
+    }
+
     std::string idat;
-    for (uint32_t y = 0; y < src.size.height; y++) {
-        // Every scanline needs to be prefixed with one byte that indicates the filter type.
-        idat.append(1, 0); // filter type 0
-        idat.append((const char*)(src.data.get() + y * stride), stride);
+    idat.reserve(compressedSize);
+    idat.append(1, char(cmf));
+    idat.append(1, char(flg));
+    if (strips.empty()) {
+        // An empty image still needs a valid, empty deflate stream.
+        const char empty[2] = { 0x03, 0x00 };
+        idat.append(empty, 2);
+    }
+    for (const auto& strip : strips) {
+        idat.append(strip.compressed);
     }
-    idat = util::compress(idat);
+    const char trailer[4] = { NETWORK_BYTE_UINT32(uint32_t(adler)) };
+    idat.append(trailer, 4);
 
     // Assemble the PNG.
     std::string png;
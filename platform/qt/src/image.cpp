@@ -19,6 +19,10 @@ std::string encodePNG(const PremultipliedImage& pre) {
     return std::string(array.constData(), array.size());
 }
 
+std::string encodePNG(const PremultipliedImage& pre, const PNGEncodeOptions&) {
+    return encodePNG(pre);
+}
+
 #if !defined(QT_IMAGE_DECODERS)
 PremultipliedImage decodeJPEG(const uint8_t*, size_t);
 PremultipliedImage decodeWebP(const uint8_t*, size_t);
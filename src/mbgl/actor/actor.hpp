@@ -61,6 +61,12 @@ public:
         mailbox->push(actor::makeMessage(object, fn, std::forward<Args>(args)...));
     }
 
+    // Hints the scheduler how urgently messages to this actor should be processed,
+    // relative to other actors sharing the same scheduler.
+    void setPriority(Scheduler::Priority priority) {
+        mailbox->setPriority(priority);
+    }
+
     ActorRef<std::decay_t<Object>> self() {
         return ActorRef<std::decay_t<Object>>(object, mailbox);
     }
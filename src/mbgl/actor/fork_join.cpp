@@ -0,0 +1,111 @@
+#include <mbgl/actor/fork_join.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/actor/message.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+class ForkJoinState {
+public:
+    ForkJoinState(std::size_t count_, std::function<void (std::size_t)> task_)
+        : count(count_), task(std::move(task_)) {
+    }
+
+    // Claims and runs tasks until there are none left.
+    void run() {
+        std::size_t index;
+        while ((index = next++) < count) {
+            std::exception_ptr error;
+            try {
+                task(index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error && !firstError) {
+                firstError = error;
+            }
+            if (++done == count) {
+                cv.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return done == count; });
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void (std::size_t)> task;
+    std::atomic<std::size_t> next { 0 };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t done = 0;
+    std::exception_ptr firstError;
+};
+
+// Keeps the shared state alive for helpers that only get to run after the caller
+// has returned; by then, there is nothing left for them to claim.
+class ForkJoinMessage : public Message {
+public:
+    ForkJoinMessage(std::shared_ptr<ForkJoinState> state_)
+        : state(std::move(state_)) {
+    }
+
+    void operator()() override {
+        state->run();
+    }
+
+private:
+    std::shared_ptr<ForkJoinState> state;
+};
+
+} // namespace
+
+void forkJoin(Scheduler& scheduler, std::size_t count, std::function<void (std::size_t)> task) {
+    if (count == 0) {
+        return;
+    }
+
+    if (count == 1) {
+        task(0);
+        return;
+    }
+
+    auto state = std::make_shared<ForkJoinState>(count, std::move(task));
+
+    // One helper per additional task, up to the number of cores. Each helper gets a
+    // mailbox of its own so that the scheduler may run them concurrently.
+    const std::size_t helperCount = std::min<std::size_t>(
+        count - 1, std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<std::shared_ptr<Mailbox>> helpers;
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        helpers.push_back(std::make_shared<Mailbox>(scheduler));
+        helpers.back()->setPriority(Scheduler::Priority::High);
+        helpers.back()->push(std::make_unique<ForkJoinMessage>(state));
+    }
+
+    state->run();
+    state->wait();
+}
+
+} // namespace mbgl
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <mbgl/actor/scheduler.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+/*
+    Runs `task(0)` through `task(count - 1)`, spreading the calls over the threads of
+    the given `Scheduler`, and returns once all of them have completed. Tasks run in
+    no particular order and may run concurrently, so they must not touch shared state
+    without synchronization; results are best written to per-index slots and merged
+    by the caller afterwards.
+
+    The calling thread takes part in the work and only ever waits for tasks that
+    another thread has already started, so it's safe to call this from an actor
+    running on the same scheduler, even when every other thread is busy (or when the
+    scheduler is the caller's own `RunLoop`, in which case everything runs inline).
+
+    If tasks throw, the remaining tasks still run, and the first exception is rethrown
+    to the caller.
+*/
+void forkJoin(Scheduler&, std::size_t count, std::function<void (std::size_t)> task);
+
+} // namespace mbgl
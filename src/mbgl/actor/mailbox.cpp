@@ -3,6 +3,7 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <cassert>
+#include <thread>
 
 namespace mbgl {
 
@@ -10,13 +11,18 @@ Mailbox::Mailbox(Scheduler& scheduler_)
     : scheduler(scheduler_) {
 }
 
+Mailbox::~Mailbox() {
+    // Nobody can push anymore; drop whatever wasn't received.
+    while (Message* message = dequeue()) {
+        delete message;
+    }
+}
+
 void Mailbox::push(std::unique_ptr<Message> message) {
     assert(!closing);
 
-    std::lock_guard<std::mutex> queueLock(queueMutex);
-    bool wasEmpty = queue.empty();
-    queue.push(std::move(message));
-    if (wasEmpty) {
+    enqueue(message.release());
+    if (pending.fetch_add(1, std::memory_order_acq_rel) == 0) {
         scheduler.schedule(shared_from_this());
     }
 }
@@ -34,24 +40,73 @@ void Mailbox::receive() {
         return;
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty;
-
-    {
-        std::lock_guard<std::mutex> queueLock(queueMutex);
-        assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
+    // At least one push has completed, but a producer that started before it may not have
+    // linked its message into the queue yet. That's a window of a few instructions, so just
+    // wait it out.
+    Message* first = dequeue();
+    while (!first) {
+        std::this_thread::yield();
+        first = dequeue();
     }
 
+    std::unique_ptr<Message> message(first);
     (*message)();
+    message.reset();
 
-    if (!wasEmpty) {
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) > 1) {
         scheduler.schedule(shared_from_this());
     }
 }
 
+void Mailbox::enqueue(Message* message) {
+    message->next.store(nullptr, std::memory_order_relaxed);
+    Message* previous = head.exchange(message, std::memory_order_acq_rel);
+    previous->next.store(message, std::memory_order_release);
+}
+
+Message* Mailbox::dequeue() {
+    Message* first = tail;
+    Message* next = first->next.load(std::memory_order_acquire);
+
+    if (first == &stub) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        tail = next;
+        return first;
+    }
+
+    if (first != head.load(std::memory_order_acquire)) {
+        // A push is in progress.
+        return nullptr;
+    }
+
+    // `first` is the last message; put the stub behind it so that it can be taken out.
+    enqueue(&stub);
+
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return first;
+    }
+
+    return nullptr;
+}
+
+void Mailbox::setPriority(Scheduler::Priority priority_) {
+    priority = priority_;
+}
+
+Scheduler::Priority Mailbox::getPriority() const {
+    return priority;
+}
+
 void Mailbox::maybeReceive(std::weak_ptr<Mailbox> mailbox) {
     if (auto locked = mailbox.lock()) {
         locked->receive();
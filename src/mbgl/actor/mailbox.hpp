@@ -1,33 +1,54 @@
 #pragma once
 
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/message.hpp>
+
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 namespace mbgl {
 
-class Scheduler;
-class Message;
-
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
     Mailbox(Scheduler&);
+    ~Mailbox();
 
     void push(std::unique_ptr<Message>);
 
     void close();
     void receive();
 
+    void setPriority(Scheduler::Priority);
+    Scheduler::Priority getPriority() const;
+
     static void maybeReceive(std::weak_ptr<Mailbox>);
 
 private:
+    void enqueue(Message*);
+    Message* dequeue();
+
     Scheduler& scheduler;
 
+    std::atomic<Scheduler::Priority> priority { Scheduler::Priority::Normal };
+
     std::mutex closingMutex;
     bool closing { false };
 
-    std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    // The number of messages pushed but not yet received. The mailbox is scheduled when it
+    // goes up from zero, and rescheduled after a receive as long as it doesn't drop to zero.
+    std::atomic<std::size_t> pending { 0 };
+
+    // An intrusive multi-producer, single-consumer queue (after Dmitry Vyukov), linked through
+    // `Message::next`. Producers only exchange `head`; `tail` is only touched while receiving.
+    // The stub keeps the queue non-empty, so that neither end ever needs to be null.
+    class Stub : public Message {
+        void operator()() override {}
+    };
+
+    Stub stub;
+    std::atomic<Message*> head { &stub };
+    Message* tail { &stub };
 };
 
 } // namespace mbgl
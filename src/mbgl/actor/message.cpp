@@ -0,0 +1,86 @@
+#include <mbgl/actor/message.hpp>
+#include <mbgl/util/thread_local.hpp>
+
+#include <new>
+
+namespace mbgl {
+
+namespace {
+
+// A free list of message blocks. Messages are mostly freed on a different thread than the
+// one that allocated them, so blocks migrate between the lists of different threads; that's
+// fine, since all of them come from the heap and have the same size. Each list keeps a
+// bounded number of blocks, and returns the rest to the heap.
+class MessagePool {
+public:
+    ~MessagePool() {
+        while (head) {
+            Block* block = head;
+            head = block->next;
+            ::operator delete(block);
+        }
+    }
+
+    void* allocate() {
+        if (!head) {
+            return ::operator new(Message::blockSize);
+        }
+        Block* block = head;
+        head = block->next;
+        --size;
+        return block;
+    }
+
+    void deallocate(void* ptr) {
+        if (size == maxSize) {
+            ::operator delete(ptr);
+            return;
+        }
+        Block* block = static_cast<Block*>(ptr);
+        block->next = head;
+        head = block;
+        ++size;
+    }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    static constexpr std::size_t maxSize = 256;
+
+    Block* head = nullptr;
+    std::size_t size = 0;
+};
+
+MessagePool& pool() {
+    static util::ThreadLocal<MessagePool>& pools = *new util::ThreadLocal<MessagePool>;
+
+    MessagePool* current = pools.get();
+    if (!current) {
+        current = new MessagePool;
+        pools.set(current);
+    }
+    return *current;
+}
+
+} // namespace
+
+constexpr std::size_t Message::blockSize;
+
+void* Message::operator new(std::size_t size) {
+    if (size > blockSize) {
+        return ::operator new(size);
+    }
+    return pool().allocate();
+}
+
+void Message::operator delete(void* ptr, std::size_t size) {
+    if (size > blockSize) {
+        ::operator delete(ptr);
+        return;
+    }
+    pool().deallocate(ptr);
+}
+
+} // namespace mbgl
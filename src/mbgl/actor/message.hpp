@@ -1,9 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <tuple>
 #include <utility>
 
 namespace mbgl {
 
+class Mailbox;
+
 // A movable type-erasing function wrapper. This allows to store arbitrary invokable
 // things (like std::function<>, or the result of a movable-only std::bind()) in the queue.
 // Source: http://stackoverflow.com/a/29642072/331379
@@ -11,6 +17,20 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+    // Messages are allocated for every `invoke()` and freed right after they've been
+    // received, so they're drawn from a per-thread pool of fixed-size blocks rather than
+    // from the heap. Messages too big for a block fall back to the heap.
+    static constexpr std::size_t blockSize = 192;
+
+    static void* operator new(std::size_t);
+    static void operator delete(void*, std::size_t);
+
+private:
+    friend class Mailbox;
+
+    // Link to the next message in the mailbox's queue.
+    std::atomic<Message*> next { nullptr };
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
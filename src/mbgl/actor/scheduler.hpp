@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace mbgl {
@@ -21,6 +22,12 @@ class Mailbox;
       Subject to these constraints, processing can happen on whatever thread in the
       pool is available.
 
+    * `WorkStealingThreadPool` preserves the same guarantees, but gives each thread
+      its own queue and lets idle threads steal from busy ones, so that scheduling
+      doesn't contend on a single lock. It also honors the `Priority` hint of each
+      mailbox, processing high-priority mailboxes (e.g. tiles in the ideal cover)
+      ahead of low-priority ones (e.g. prefetched or cached tiles).
+
     * `RunLoop` is a `Scheduler` that is typically used to create a mailbox and
       `ActorRef` for an object that lives on the main thread and is not itself wrapped
       as an `Actor`:
@@ -31,6 +38,14 @@ class Mailbox;
 
 class Scheduler {
 public:
+    // A hint for ordering the processing of different mailboxes. Schedulers are free
+    // to ignore it; it never affects the order of messages within a single mailbox.
+    enum class Priority : uint8_t {
+        Low,
+        Normal,
+        High,
+    };
+
     virtual ~Scheduler() = default;
     virtual void schedule(std::weak_ptr<Mailbox>) = 0;
 };
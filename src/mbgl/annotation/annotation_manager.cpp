@@ -54,10 +54,18 @@ Update AnnotationManager::updateAnnotation(const AnnotationID& id, const Annotat
 
 void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
+        const Point<double>& position = symbolAnnotations.at(id)->annotation.geometry;
+        changedSymbolPositions.emplace_back(position.y, position.x);
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
-        obsoleteShapeAnnotationLayers.insert(shapeAnnotations.at(id)->layerID);
+        auto& impl = shapeAnnotations.at(id);
+        obsoleteShapeAnnotationLayers.insert(impl->layerID);
+        addedShapes.erase(id);
+        // A shape that was never tiled isn't in any tile yet.
+        if (impl->shapeTiler) {
+            removedShapes.push_back(std::move(impl));
+        }
         shapeAnnotations.erase(id);
     } else {
         assert(false); // Should never happen
@@ -68,24 +76,28 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    changedSymbolPositions.emplace_back(annotation.geometry.y, annotation.geometry.x);
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    addedShapes.insert(id);
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    addedShapes.insert(id);
 }
 
 void AnnotationManager::add(const AnnotationID& id, const StyleSourcedAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    addedShapes.insert(id);
 }
 
 Update AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t maxZoom) {
@@ -173,6 +185,30 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
     return tileData;
 }
 
+bool AnnotationManager::isChanged(const CanonicalTileID& tileID) const {
+    // Symbols are in the tiles whose bounds contain them, as in getTileData().
+    LatLngBounds tileBounds(tileID);
+    for (const auto& position : changedSymbolPositions) {
+        if (boost::geometry::intersects(position, tileBounds)) {
+            return true;
+        }
+    }
+
+    for (const auto& shape : removedShapes) {
+        if (shape->intersects(tileID)) {
+            return true;
+        }
+    }
+
+    for (const auto& id : addedShapes) {
+        if (shapeAnnotations.at(id)->intersects(tileID)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void AnnotationManager::updateStyle(Style& style) {
     // Create annotation source, point layer, and point bucket
     if (!style.getSource(SourceID)) {
@@ -206,9 +242,17 @@ void AnnotationManager::updateStyle(Style& style) {
 }
 
 void AnnotationManager::updateData() {
+    // Moving a single annotation only affects the few tiles it moves between, so leave
+    // the rest of them alone.
     for (auto& tile : tiles) {
-        tile->setData(getTileData(tile->id.canonical));
+        if (isChanged(tile->id.canonical)) {
+            tile->setData(getTileData(tile->id.canonical));
+        }
     }
+
+    changedSymbolPositions.clear();
+    addedShapes.clear();
+    removedShapes.clear();
 }
 
 void AnnotationManager::addTile(AnnotationTile& tile) {
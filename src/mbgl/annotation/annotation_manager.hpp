@@ -61,6 +61,10 @@ private:
 
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
 
+    // Whether any annotation added, updated or removed since the last updateData() is, or
+    // was, in the tile.
+    bool isChanged(const CanonicalTileID&) const;
+
     AnnotationID nextID = 0;
 
     using SymbolAnnotationTree = boost::geometry::index::rtree<std::shared_ptr<const SymbolAnnotationImpl>, boost::geometry::index::rstar<16, 4>>;
@@ -73,6 +77,14 @@ private:
     SymbolAnnotationMap symbolAnnotations;
     ShapeAnnotationMap shapeAnnotations;
     std::unordered_set<std::string> obsoleteShapeAnnotationLayers;
+
+    // Changes since the last updateData(): the old and new positions of changed symbols, the
+    // added shapes, and the removed shapes that were tiled already, which are kept to find the
+    // tiles they were in.
+    std::vector<LatLng> changedSymbolPositions;
+    std::unordered_set<AnnotationID> addedShapes;
+    std::vector<std::unique_ptr<ShapeAnnotationImpl>> removedShapes;
+
     std::unordered_set<AnnotationTile*> tiles;
     SpriteAtlas spriteAtlas;
 };
@@ -19,7 +19,9 @@ AnnotationTile::~AnnotationTile() {
     annotationManager.removeTile(*this);
 }
 
-void AnnotationTile::setNecessity(Necessity) {}
+void AnnotationTile::setNecessity(Necessity necessity) {
+    setWorkerPriority(necessity);
+}
 
 AnnotationTileFeature::AnnotationTileFeature(const AnnotationID id_,
                                              FeatureType type_, GeometryCollection geometries_,
@@ -40,6 +42,14 @@ optional<Value> AnnotationTileFeature::getValue(const std::string& key) const {
 AnnotationTileLayer::AnnotationTileLayer(std::string name_)
     : name(std::move(name_)) {}
 
+void AnnotationTileLayer::eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t)> fn) const {
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (!fn(features[i], i)) {
+            break;
+        }
+    }
+}
+
 std::unique_ptr<GeometryTileData> AnnotationTileData::clone() const {
     return std::make_unique<AnnotationTileData>(*this);
 }
@@ -46,6 +46,7 @@ public:
 
     std::size_t featureCount() const override { return features.size(); }
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override { return std::make_unique<AnnotationTileFeature>(features[i]); }
+    void eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t)>) const override;
     std::string getName() const override { return name; };
 
     std::vector<AnnotationTileFeature> features;
@@ -18,7 +18,7 @@ ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const uint8_t m
       layerID("com.mapbox.annotations.shape." + util::toString(id)) {
 }
 
-void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
+const geojsonvt::Tile& ShapeAnnotationImpl::getTile(const CanonicalTileID& tileID) {
     static const double baseTolerance = 4;
 
     if (!shapeTiler) {
@@ -34,7 +34,15 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
     }
 
-    const auto& shapeTile = shapeTiler->getTile(tileID.z, tileID.x, tileID.y);
+    return shapeTiler->getTile(tileID.z, tileID.x, tileID.y);
+}
+
+bool ShapeAnnotationImpl::intersects(const CanonicalTileID& tileID) {
+    return !getTile(tileID).features.empty();
+}
+
+void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
+    const auto& shapeTile = getTile(tileID);
     if (shapeTile.features.empty())
         return;
 
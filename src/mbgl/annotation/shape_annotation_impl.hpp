@@ -27,10 +27,16 @@ public:
 
     void updateTileData(const CanonicalTileID&, AnnotationTileData&);
 
+    // Whether the shape has any features in the tile.
+    bool intersects(const CanonicalTileID&);
+
     const AnnotationID id;
     const uint8_t maxZoom;
     const std::string layerID;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
+
+private:
+    const mapbox::geojsonvt::Tile& getTile(const CanonicalTileID&);
 };
 
 struct CloseShapeAnnotation {
@@ -10,7 +10,10 @@
 
 #include <mapbox/geometry/envelope.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <limits>
 #include <string>
 
 namespace mbgl {
@@ -23,12 +26,62 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
                           const std::string& sourceLayerName,
                           const std::string& bucketName) {
+    const uint16_t sourceLayerID = intern(sourceLayerNames, sourceLayerName);
+    const uint16_t bucketID = intern(bucketNames, bucketName);
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
+        grid.insert(Entry { uint32_t(index), sortIndex++, sourceLayerID, bucketID },
                     mapbox::geometry::envelope(ring));
     }
 }
 
+void FeatureIndex::insert(const FeatureIndex& other) {
+    std::vector<uint16_t> sourceLayerIDs;
+    for (const auto& name : other.sourceLayerNames) {
+        sourceLayerIDs.push_back(intern(sourceLayerNames, name));
+    }
+    std::vector<uint16_t> bucketIDs;
+    for (const auto& name : other.bucketNames) {
+        bucketIDs.push_back(intern(bucketNames, name));
+    }
+
+    const uint32_t offset = sortIndex;
+    for (const auto& element : other.grid.getElements()) {
+        Entry entry = element.first;
+        entry.sortIndex += offset;
+        entry.sourceLayerName = sourceLayerIDs[entry.sourceLayerName];
+        entry.bucketName = bucketIDs[entry.bucketName];
+        grid.insert(std::move(entry), element.second);
+    }
+    sortIndex += other.sortIndex;
+}
+
+uint16_t FeatureIndex::intern(std::vector<std::string>& table, const std::string& name) {
+    // Features are inserted a layer at a time, so the name is usually the last one added.
+    const auto it = std::find(table.rbegin(), table.rend(), name);
+    if (it != table.rend()) {
+        return uint16_t(std::distance(it, table.rend()) - 1);
+    }
+
+    assert(table.size() < std::numeric_limits<uint16_t>::max());
+    table.push_back(name);
+    return uint16_t(table.size() - 1);
+}
+
+void FeatureIndex::build() {
+    grid.build();
+}
+
+std::size_t FeatureIndex::getByteSize() const {
+    std::size_t size = grid.getByteSize();
+    for (const auto& name : sourceLayerNames) {
+        size += sizeof(name) + name.capacity();
+    }
+    for (const auto& name : bucketNames) {
+        size += sizeof(name) + name.capacity();
+    }
+    return size;
+}
+
 static bool vectorContains(const std::vector<std::string>& vector, const std::string& s) {
     return std::find(vector.begin(), vector.end(), s) != vector.end();
 }
@@ -42,7 +95,7 @@ static bool vectorsIntersect(const std::vector<std::string>& vectorA, const std:
     return false;
 }
 
-static bool topDown(const IndexedSubfeature& a, const IndexedSubfeature& b) {
+static bool topDown(const FeatureIndex::Entry& a, const FeatureIndex::Entry& b) {
     return a.sortIndex > b.sortIndex;
 }
 
@@ -66,17 +119,21 @@ void FeatureIndex::query(
 
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
     const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(style.getQueryRadius() * pixelsToTileUnits));
-    std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
+    std::vector<Entry> features;
+    grid.query({ box.min - additionalRadius, box.max + additionalRadius }, [&] (const Entry& entry) {
+        features.push_back(entry);
+    });
 
     std::sort(features.begin(), features.end(), topDown);
-    size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
+    uint32_t previousSortIndex = std::numeric_limits<uint32_t>::max();
+    for (const auto& entry : features) {
 
         // If this feature is the same as the previous feature, skip it.
-        if (indexedFeature.sortIndex == previousSortIndex) continue;
-        previousSortIndex = indexedFeature.sortIndex;
+        if (entry.sortIndex == previousSortIndex) continue;
+        previousSortIndex = entry.sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, entry.index, sourceLayerNames[entry.sourceLayerName], bucketNames[entry.bucketName],
+                   queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -87,13 +144,16 @@ void FeatureIndex::query(
     std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
     std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
     for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, symbolFeature.index, symbolFeature.sourceLayerName, symbolFeature.bucketName,
+                   queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
     }
 }
 
 void FeatureIndex::addFeature(
     std::unordered_map<std::string, std::vector<Feature>>& result,
-    const IndexedSubfeature& indexedFeature,
+    std::size_t index,
+    const std::string& sourceLayerName,
+    const std::string& bucketName,
     const GeometryCoordinates& queryGeometry,
     const optional<std::vector<std::string>>& filterLayerIDs,
     const GeometryTileData& geometryTileData,
@@ -102,15 +162,15 @@ void FeatureIndex::addFeature(
     const float bearing,
     const float pixelsToTileUnits) const {
 
-    auto& layerIDs = bucketLayerIDs.at(indexedFeature.bucketName);
+    auto& layerIDs = bucketLayerIDs.at(bucketName);
     if (filterLayerIDs && !vectorsIntersect(layerIDs, *filterLayerIDs)) {
         return;
     }
 
-    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+    auto sourceLayer = geometryTileData.getLayer(sourceLayerName);
     assert(sourceLayer);
 
-    auto geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
+    auto geometryTileFeature = sourceLayer->getFeature(index);
     assert(geometryTileFeature);
 
     for (const auto& layerID : layerIDs) {
@@ -33,6 +33,9 @@ public:
 
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
 
+    // Append all features indexed by another index, ordered after the ones already present.
+    void insert(const FeatureIndex&);
+
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
@@ -54,10 +57,27 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Lays out the index for querying, once all features are inserted.
+    void build();
+
+    // Approximate number of bytes used by the index.
+    std::size_t getByteSize() const;
+
+    // What the index stores for every ring: the feature, and its source layer and bucket as
+    // indices into the index's string tables.
+    struct Entry {
+        uint32_t index;
+        uint32_t sortIndex;
+        uint16_t sourceLayerName;
+        uint16_t bucketName;
+    };
+
 private:
     void addFeature(
             std::unordered_map<std::string, std::vector<Feature>>& result,
-            const IndexedSubfeature&,
+            std::size_t index,
+            const std::string& sourceLayerName,
+            const std::string& bucketName,
             const GeometryCoordinates& queryGeometry,
             const optional<std::vector<std::string>>& filterLayerIDs,
             const GeometryTileData&,
@@ -66,9 +86,16 @@ private:
             const float bearing,
             const float pixelsToTileUnits) const;
 
-    GridIndex<IndexedSubfeature> grid;
+    static uint16_t intern(std::vector<std::string>& table, const std::string&);
+
+    GridIndex<Entry> grid;
     unsigned int sortIndex = 0;
 
+    // The names of the source layers and buckets of the indexed features. A tile has a few
+    // dozen of each at most.
+    std::vector<std::string> sourceLayerNames;
+    std::vector<std::string> bucketNames;
+
     std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
 };
 } // namespace mbgl
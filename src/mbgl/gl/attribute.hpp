@@ -5,7 +5,6 @@
 #include <mbgl/util/indexed_tuple.hpp>
 
 #include <cstddef>
-#include <functional>
 
 namespace mbgl {
 namespace gl {
@@ -155,15 +154,13 @@ public:
         return State { typename As::State(bindAttributeLocation(id, Index<As>, As::name))... };
     }
 
-    static std::function<void (std::size_t)> binder(const State& state) {
-        return [&state] (std::size_t vertexOffset) {
-            util::ignore({ (bindAttribute(state.template get<As>().location,
-                                          state.template get<As>().count,
-                                          state.template get<As>().type,
-                                          sizeof(Vertex),
-                                          vertexOffset,
-                                          Vertex::attributeOffsets[Index<As>]), 0)... });
-        };
+    static void bind(const State& state, std::size_t vertexOffset) {
+        util::ignore({ (bindAttribute(state.template get<As>().location,
+                                      state.template get<As>().count,
+                                      state.template get<As>().type,
+                                      sizeof(Vertex),
+                                      vertexOffset,
+                                      Vertex::attributeOffsets[Index<As>]), 0)... });
     }
 };
 
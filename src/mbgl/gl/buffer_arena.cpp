@@ -0,0 +1,163 @@
+#include <mbgl/gl/buffer_arena.hpp>
+#include <mbgl/gl/context.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+namespace gl {
+
+BufferRange::BufferRange(BufferArena* arena_, std::size_t generation_, BufferID buffer_, std::size_t offset_, std::size_t size_)
+    : buffer(buffer_), offset(offset_), size(size_), arena(arena_), generation(generation_) {}
+
+BufferRange::BufferRange(BufferRange&& other)
+    : buffer(other.buffer), offset(other.offset), size(other.size), arena(other.arena), generation(other.generation) {
+    other.arena = nullptr;
+}
+
+BufferRange& BufferRange::operator=(BufferRange&& other) {
+    if (this != &other) {
+        release();
+        buffer = other.buffer;
+        offset = other.offset;
+        size = other.size;
+        arena = other.arena;
+        generation = other.generation;
+        other.arena = nullptr;
+    }
+    return *this;
+}
+
+BufferRange::~BufferRange() {
+    release();
+}
+
+void BufferRange::release() {
+    if (arena) {
+        arena->free(generation, buffer, offset, size);
+        arena = nullptr;
+    }
+}
+
+BufferArena::Page::Page(UniqueBuffer buffer_, std::size_t capacity_)
+    : buffer(std::move(buffer_)), capacity(capacity_), freeRanges({{ 0, capacity_ }}) {}
+
+optional<std::size_t> BufferArena::Page::allocate(std::size_t size, std::size_t alignment) {
+    // First fit: allocations are mostly similar in size, and are freed together with their tile.
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+        const std::size_t begin = it->first;
+        const std::size_t end = begin + it->second;
+        const std::size_t aligned = (begin + alignment - 1) / alignment * alignment;
+        if (aligned + size > end) {
+            continue;
+        }
+
+        freeRanges.erase(it);
+        if (aligned > begin) {
+            freeRanges.emplace(begin, aligned - begin);
+        }
+        if (aligned + size < end) {
+            freeRanges.emplace(aligned + size, end - aligned - size);
+        }
+
+        used += size;
+        return aligned;
+    }
+
+    return {};
+}
+
+void BufferArena::Page::free(std::size_t offset, std::size_t size) {
+    assert(used >= size);
+    used -= size;
+
+    auto it = freeRanges.emplace(offset, size).first;
+
+    // Merge with the following range.
+    auto next = std::next(it);
+    if (next != freeRanges.end() && it->first + it->second == next->first) {
+        it->second += next->second;
+        freeRanges.erase(next);
+    }
+
+    // Merge with the preceding range.
+    if (it != freeRanges.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second == it->first) {
+            prev->second += it->second;
+            freeRanges.erase(it);
+        }
+    }
+}
+
+BufferArena::BufferArena(Context& context_, BufferType type_, std::size_t pageSize_)
+    : context(context_), type(type_), pageSize(pageSize_) {}
+
+BufferArena::~BufferArena() = default;
+
+BufferRange BufferArena::allocate(const void* data, std::size_t size, std::size_t alignment) {
+    assert(alignment > 0);
+    if (size == 0) {
+        return {};
+    }
+
+    for (auto& page : pages) {
+        if (page->capacity - page->used < size) {
+            continue;
+        }
+        if (auto offset = page->allocate(size, alignment)) {
+            context.updateBuffer(type, page->buffer, *offset, data, size);
+            return { this, generation, page->buffer, *offset, size };
+        }
+    }
+
+    const std::size_t capacity = std::max(pageSize, size);
+    pages.push_back(std::make_unique<Page>(context.createBuffer(type, nullptr, capacity), capacity));
+
+    Page& page = *pages.back();
+    const auto offset = page.allocate(size, alignment);
+    assert(offset && *offset == 0);
+    context.updateBuffer(type, page.buffer, *offset, data, size);
+    return { this, generation, page.buffer, *offset, size };
+}
+
+void BufferArena::free(std::size_t generation_, BufferID buffer, std::size_t offset, std::size_t size) {
+    if (generation_ != generation) {
+        // The page went away with releaseAllPages().
+        return;
+    }
+
+    auto it = std::find_if(pages.begin(), pages.end(), [&] (const auto& page) {
+        return BufferID(page->buffer) == buffer;
+    });
+    assert(it != pages.end());
+    (*it)->free(offset, size);
+}
+
+void BufferArena::releaseEmptyPages() {
+    pages.erase(std::remove_if(pages.begin(), pages.end(), [] (const auto& page) {
+        return page->used == 0;
+    }), pages.end());
+}
+
+void BufferArena::releaseAllPages() {
+    pages.clear();
+    generation++;
+}
+
+BufferArena::Statistics BufferArena::getStatistics() const {
+    Statistics statistics;
+    for (const auto& page : pages) {
+        statistics.pages++;
+        statistics.capacity += page->capacity;
+        statistics.used += page->used;
+        statistics.freeRanges += page->freeRanges.size();
+        for (const auto& range : page->freeRanges) {
+            statistics.largestFreeRange = std::max(statistics.largestFreeRange, range.second);
+        }
+    }
+    return statistics;
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/types.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+class BufferArena;
+
+// A range of bytes in one of the buffers of a BufferArena. The range is returned to the arena
+// when it is destroyed. A default constructed range is empty and doesn't refer to any buffer.
+class BufferRange {
+public:
+    BufferRange() = default;
+    BufferRange(BufferRange&&);
+    BufferRange& operator=(BufferRange&&);
+    ~BufferRange();
+
+    BufferID buffer = 0;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+
+private:
+    friend class BufferArena;
+    BufferRange(BufferArena*, std::size_t generation, BufferID, std::size_t offset, std::size_t size);
+    void release();
+
+    BufferArena* arena = nullptr;
+    std::size_t generation = 0;
+};
+
+// Packs many small buffers into a few large buffer objects ("pages"), so that uploading a
+// tile's geometry doesn't create a buffer object per bucket. Freed ranges are coalesced with
+// their free neighbours and reused for later allocations; pages without any allocations are
+// deleted by releaseEmptyPages().
+class BufferArena : private util::noncopyable {
+public:
+    BufferArena(Context&, BufferType, std::size_t pageSize = 1024 * 1024);
+    ~BufferArena();
+
+    // Uploads `size` bytes into a range that starts at a multiple of `alignment`. Allocations
+    // larger than the page size get a page of their own.
+    BufferRange allocate(const void* data, std::size_t size, std::size_t alignment);
+
+    void releaseEmptyPages();
+
+    // Deletes every page, including those with ranges still in use, for when the context is
+    // torn down. Ranges allocated before are left behind; returning them is a no-op.
+    void releaseAllPages();
+
+    struct Statistics {
+        std::size_t pages = 0;
+        std::size_t capacity = 0;
+        std::size_t used = 0;
+        std::size_t freeRanges = 0;
+        std::size_t largestFreeRange = 0;
+
+        double occupancy() const {
+            return capacity ? double(used) / capacity : 0;
+        }
+
+        // The share of free space that is unusable for an allocation of the size of the
+        // largest free range: 0 when all free space is contiguous.
+        double fragmentation() const {
+            const std::size_t available = capacity - used;
+            return available ? 1 - double(largestFreeRange) / available : 0;
+        }
+    };
+
+    Statistics getStatistics() const;
+
+private:
+    friend class BufferRange;
+
+    class Page {
+    public:
+        Page(UniqueBuffer, std::size_t capacity);
+
+        optional<std::size_t> allocate(std::size_t size, std::size_t alignment);
+        void free(std::size_t offset, std::size_t size);
+
+        UniqueBuffer buffer;
+        const std::size_t capacity;
+        std::size_t used = 0;
+
+        // Free ranges by offset, with their lengths. Adjacent free ranges are always merged.
+        std::map<std::size_t, std::size_t> freeRanges;
+    };
+
+    void free(std::size_t generation, BufferID, std::size_t offset, std::size_t size);
+
+    Context& context;
+    const BufferType type;
+    const std::size_t pageSize;
+    std::vector<std::unique_ptr<Page>> pages;
+
+    // Bumped by releaseAllPages(), so that ranges from deleted pages can't free space in a
+    // new page that happens to get the same buffer ID.
+    std::size_t generation = 0;
+};
+
+} // namespace gl
+} // namespace mbgl
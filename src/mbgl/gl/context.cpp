@@ -2,10 +2,13 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/gl.hpp>
 #include <mbgl/gl/vertex_array.hpp>
+#include <mbgl/gl/pixel_buffer.hpp>
+#include <mbgl/gl/program_binary_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <cassert>
 #include <cstring>
 
 namespace mbgl {
@@ -14,6 +17,9 @@ namespace gl {
 static_assert(underlying_type(ShaderType::Vertex) == GL_VERTEX_SHADER, "OpenGL type mismatch");
 static_assert(underlying_type(ShaderType::Fragment) == GL_FRAGMENT_SHADER, "OpenGL type mismatch");
 
+static_assert(underlying_type(BufferType::Vertex) == GL_ARRAY_BUFFER, "OpenGL type mismatch");
+static_assert(underlying_type(BufferType::Index) == GL_ELEMENT_ARRAY_BUFFER, "OpenGL type mismatch");
+
 static_assert(underlying_type(PrimitiveType::Points) == GL_POINTS, "OpenGL type mismatch");
 static_assert(underlying_type(PrimitiveType::Lines) == GL_LINES, "OpenGL type mismatch");
 static_assert(underlying_type(PrimitiveType::LineLoop) == GL_LINE_LOOP, "OpenGL type mismatch");
@@ -73,6 +79,10 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
 }
 
 void Context::linkProgram(ProgramID program_) {
+    // Drivers may not keep a binary of programs linked without the hint.
+    if (ProgramParameteri) {
+        MBGL_CHECK_ERROR(ProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
     MBGL_CHECK_ERROR(glLinkProgram(program_));
 
     GLint status;
@@ -92,25 +102,80 @@ void Context::linkProgram(ProgramID program_) {
     throw std::runtime_error("program failed to link");
 }
 
-UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size) {
-    BufferID id = 0;
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    UniqueBuffer result { std::move(id), { this } };
-    vertexBuffer = result;
-    MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+bool Context::supportsProgramBinaries() const {
+    return GetProgramBinary && ProgramBinary;
+}
+
+UniqueProgram Context::createProgram(BinaryProgramFormat binaryFormat, const std::string& binary) {
+    assert(supportsProgramBinaries());
+    UniqueProgram result { MBGL_CHECK_ERROR(glCreateProgram()), { this } };
+    // Drivers reject binaries they don't understand with an error, which is an expected
+    // outcome here rather than a bug.
+    ProgramBinary(result, static_cast<GLenum>(binaryFormat), binary.data(),
+                  static_cast<GLint>(binary.size()));
+    if (glGetError() != GL_NO_ERROR) {
+        throw std::runtime_error("program binary format is not supported");
+    }
+
+    GLint status;
+    MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        throw std::runtime_error("program binary was rejected");
+    }
+
     return result;
 }
 
-UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
+optional<std::pair<BinaryProgramFormat, std::string>> Context::getBinaryProgram(ProgramID program_) const {
+    assert(supportsProgramBinaries());
+    GLint binaryLength;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+    if (binaryLength <= 0) {
+        return {};
+    }
+
+    std::string binary;
+    binary.resize(binaryLength);
+    GLenum binaryFormat;
+    MBGL_CHECK_ERROR(GetProgramBinary(program_, binaryLength, &binaryLength, &binaryFormat,
+                                      const_cast<char*>(binary.data())));
+    if (static_cast<std::size_t>(binaryLength) != binary.size()) {
+        return {};
+    }
+
+    return { { binaryFormat, std::move(binary) } };
+}
+
+UniqueBuffer Context::createBuffer(BufferType type, const void* data, std::size_t size) {
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
     UniqueBuffer result { std::move(id), { this } };
-    vertexArrayObject = 0;
-    elementBuffer = result;
-    MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    bindBuffer(type, result);
+    MBGL_CHECK_ERROR(glBufferData(static_cast<GLenum>(type), size, data, GL_STATIC_DRAW));
+    if (data) {
+        statistics.bufferBytesUploaded += size;
+    }
     return result;
 }
 
+void Context::updateBuffer(BufferType type, BufferID id, std::size_t offset, const void* data, std::size_t size) {
+    bindBuffer(type, id);
+    MBGL_CHECK_ERROR(glBufferSubData(static_cast<GLenum>(type), offset, size, data));
+    statistics.bufferBytesUploaded += size;
+}
+
+void Context::bindBuffer(BufferType type, BufferID id) {
+    if (type == BufferType::Vertex) {
+        vertexBuffer = id;
+    } else {
+        // The element array binding is part of the vertex array object's state, so the
+        // binding we last recorded may belong to another vertex array object.
+        vertexArrayObject = 0;
+        elementBuffer.setDirty();
+        elementBuffer = id;
+    }
+}
+
 UniqueTexture Context::createTexture() {
     if (pooledTextures.empty()) {
         pooledTextures.resize(TextureMax);
@@ -147,6 +212,9 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const Textu
     // When reading data from the framebuffer, make sure that we are storing the values
     // tightly packed into the buffer to avoid buffer overruns.
     pixelStorePack = { 1 };
+
+    // With a pixel pack buffer bound, glReadPixels would treat our pointer as an offset.
+    pixelPackBuffer = 0;
 #endif // MBGL_USE_GLES2
 
     MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
@@ -166,6 +234,53 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const Textu
 }
 
 #if not MBGL_USE_GLES2
+bool Context::supportsPixelPackBuffers() const {
+    return MapBuffer && UnmapBuffer;
+}
+
+UniqueBuffer Context::createPixelPackBuffer(std::size_t size) {
+    BufferID id = 0;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    UniqueBuffer result { std::move(id), { this } };
+    pixelPackBuffer = result;
+    MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ));
+    return result;
+}
+
+void Context::readFramebuffer(BufferID buffer, const Size size, const TextureFormat format) {
+    assert(supportsPixelPackBuffers());
+    pixelStorePack = { 1 };
+    pixelPackBuffer = buffer;
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
+                                  GL_UNSIGNED_BYTE, nullptr));
+}
+
+std::unique_ptr<uint8_t[]> Context::readPixelPackBuffer(BufferID buffer, const Size size, const TextureFormat format, const bool flip) {
+    assert(supportsPixelPackBuffers());
+    const size_t stride = size.width * (format == TextureFormat::RGBA ? 4 : 1);
+    auto data = std::make_unique<uint8_t[]>(stride * size.height);
+
+    pixelPackBuffer = buffer;
+    auto mapped = static_cast<const uint8_t*>(
+        MBGL_CHECK_ERROR(MapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)));
+    if (!mapped) {
+        throw Error("failed to map pixel pack buffer");
+    }
+
+    // OpenGL returns rows bottom to top, so flipping is a matter of copying them out in
+    // reverse order.
+    if (flip) {
+        for (uint32_t y = 0; y < size.height; y++) {
+            std::memcpy(data.get() + y * stride, mapped + (size.height - 1 - y) * stride, stride);
+        }
+    } else {
+        std::memcpy(data.get(), mapped, stride * size.height);
+    }
+
+    MBGL_CHECK_ERROR(UnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    return data;
+}
+
 void Context::drawPixels(const Size size, const void* data, TextureFormat format) {
     pixelStoreUnpack = { 1 };
     if (format != TextureFormat::RGBA) {
@@ -290,6 +405,10 @@ void Context::updateTexture(
     MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), GL_UNSIGNED_BYTE,
                                   data));
+    if (data) {
+        statistics.textureBytesUploaded += std::size_t(size.width) * size.height *
+            (format == TextureFormat::RGBA ? 4 : 1);
+    }
 }
 
 void Context::bindTexture(Texture& obj,
@@ -338,6 +457,12 @@ void Context::bindTexture(Texture& obj,
 void Context::reset() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
+
+    // Pages that are still in use too, or their buffers would only be abandoned after the
+    // last cleanup, when the arenas are destroyed.
+    vertexArena.releaseAllPages();
+    indexArena.releaseAllPages();
+
     performCleanup();
 }
 
@@ -368,6 +493,7 @@ void Context::setDirtyState() {
     pixelZoom.setDirty();
     rasterPos.setDirty();
     pixelStorePack.setDirty();
+    pixelPackBuffer.setDirty();
     pixelStoreUnpack.setDirty();
     pixelTransferDepth.setDirty();
     pixelTransferStencil.setDirty();
@@ -474,60 +600,53 @@ void Context::setColorMode(const ColorMode& color) {
     colorMask = color.mask;
 }
 
-void Context::draw(const Drawable& drawable) {
-    if (drawable.segments.empty()) {
-        return;
-    }
-
-    PrimitiveType primitiveType = apply_visitor([&] (auto m) { return (*this)(m); }, drawable.drawMode);
-
-    setDepthMode(drawable.depthMode);
-    setStencilMode(drawable.stencilMode);
-    setColorMode(drawable.colorMode);
-
-    program = drawable.program;
-
-    drawable.bindUniforms();
+bool Context::bindSegment(const Segment& segment, BufferID vertexBuffer_, BufferID indexBuffer_) {
+    auto needAttributeBindings = [&] () {
+        if (!gl::GenVertexArrays || !gl::BindVertexArray) {
+            return true;
+        }
 
-    for (const auto& segment : drawable.segments) {
-        auto needAttributeBindings = [&] () {
-            if (!gl::GenVertexArrays || !gl::BindVertexArray) {
-                return true;
-            }
+        if (segment.vao) {
+            vertexArrayObject = *segment.vao;
+            return false;
+        }
 
-            if (segment.vao) {
-                vertexArrayObject = *segment.vao;
-                return false;
-            }
+        VertexArrayID id = 0;
+        MBGL_CHECK_ERROR(gl::GenVertexArrays(1, &id));
+        vertexArrayObject = id;
+        segment.vao = UniqueVertexArray(std::move(id), { this });
 
-            VertexArrayID id = 0;
-            MBGL_CHECK_ERROR(gl::GenVertexArrays(1, &id));
-            vertexArrayObject = id;
-            segment.vao = UniqueVertexArray(std::move(id), { this });
+        // If we are initializing a new VAO, we need to force the buffers
+        // to be rebound. VAOs don't inherit the existing buffer bindings.
+        vertexBuffer.setDirty();
+        elementBuffer.setDirty();
 
-            // If we are initializing a new VAO, we need to force the buffers
-            // to be rebound. VAOs don't inherit the existing buffer bindings.
-            vertexBuffer.setDirty();
-            elementBuffer.setDirty();
+        return true;
+    };
 
-            return true;
-        };
+    if (needAttributeBindings()) {
+        vertexBuffer = vertexBuffer_;
+        elementBuffer = indexBuffer_;
+        return true;
+    }
 
-        if (needAttributeBindings()) {
-            vertexBuffer = drawable.vertexBuffer;
-            elementBuffer = drawable.indexBuffer;
-            drawable.bindAttributes(segment.vertexOffset);
-        }
+    return false;
+}
 
-        MBGL_CHECK_ERROR(glDrawElements(
-            static_cast<GLenum>(primitiveType),
-            static_cast<GLsizei>(segment.indexLength),
-            GL_UNSIGNED_SHORT,
-            reinterpret_cast<GLvoid*>(sizeof(uint16_t) * segment.indexOffset)));
-    }
+void Context::drawSegment(PrimitiveType primitiveType, std::size_t indexOffset, std::size_t indexLength) {
+    MBGL_CHECK_ERROR(glDrawElements(
+        static_cast<GLenum>(primitiveType),
+        static_cast<GLsizei>(indexLength),
+        GL_UNSIGNED_SHORT,
+        reinterpret_cast<GLvoid*>(sizeof(uint16_t) * indexOffset)));
+    statistics.drawCalls++;
 }
 
 void Context::performCleanup() {
+    // Deleting the arenas' empty pages abandons their buffers, which are deleted below.
+    vertexArena.releaseEmptyPages();
+    indexArena.releaseEmptyPages();
+
     for (auto id : abandonedPrograms) {
         if (program == id) {
             program.setDirty();
@@ -548,6 +667,11 @@ void Context::performCleanup() {
             } else if (elementBuffer == id) {
                 elementBuffer.setDirty();
             }
+#if not MBGL_USE_GLES2
+            if (pixelPackBuffer == id) {
+                pixelPackBuffer.setDirty();
+            }
+#endif // MBGL_USE_GLES2
         }
         MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
         abandonedBuffers.clear();
@@ -8,6 +8,7 @@
 #include <mbgl/gl/framebuffer.hpp>
 #include <mbgl/gl/vertex_buffer.hpp>
 #include <mbgl/gl/index_buffer.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/gl/types.hpp>
 #include <mbgl/gl/draw_mode.hpp>
 #include <mbgl/gl/depth_mode.hpp>
@@ -15,6 +16,7 @@
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/gl/segment.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 
 
 #include <functional>
@@ -23,6 +25,7 @@
 #include <array>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace mbgl {
 
@@ -39,20 +42,28 @@ public:
     UniqueShader createShader(ShaderType type, const std::string& source);
     UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader);
     void linkProgram(ProgramID);
+
+    // Linked program binaries, which can be saved and restored to skip compiling and
+    // linking. Binaries are specific to the driver that produced them, so restoring one
+    // throws if the driver rejects it.
+    bool supportsProgramBinaries() const;
+    UniqueProgram createProgram(BinaryProgramFormat, const std::string& binary);
+    optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID) const;
+
     UniqueTexture createTexture();
 
     template <class Vertex, class DrawMode>
     VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode>&& v) {
         return VertexBuffer<Vertex, DrawMode> {
             v.vertexSize(),
-            createVertexBuffer(v.data(), v.byteSize())
+            vertexArena.allocate(v.data(), v.byteSize(), sizeof(Vertex))
         };
     }
 
     template <class DrawMode>
     IndexBuffer<DrawMode> createIndexBuffer(IndexVector<DrawMode>&& v) {
         return IndexBuffer<DrawMode> {
-            createIndexBuffer(v.data(), v.byteSize())
+            indexArena.allocate(v.data(), v.byteSize(), sizeof(uint16_t))
         };
     }
 
@@ -80,6 +91,30 @@ public:
     }
 
 #if not MBGL_USE_GLES2
+    // Asynchronous readback: reading the framebuffer into a pixel pack buffer returns as
+    // soon as the copy is queued, and reading the buffer back only blocks if the copy
+    // hasn't finished by then.
+    bool supportsPixelPackBuffers() const;
+    UniqueBuffer createPixelPackBuffer(std::size_t size);
+
+    template <typename Image,
+              TextureFormat format = Image::channels == 4 ? TextureFormat::RGBA
+                                                          : TextureFormat::Alpha>
+    void readFramebuffer(BufferID buffer, const Size size) {
+        static_assert(Image::channels == (format == TextureFormat::RGBA ? 4 : 1),
+                      "image format mismatch");
+        readFramebuffer(buffer, size, format);
+    }
+
+    template <typename Image,
+              TextureFormat format = Image::channels == 4 ? TextureFormat::RGBA
+                                                          : TextureFormat::Alpha>
+    Image readPixelPackBuffer(BufferID buffer, const Size size, bool flip = true) {
+        static_assert(Image::channels == (format == TextureFormat::RGBA ? 4 : 1),
+                      "image format mismatch");
+        return { size, readPixelPackBuffer(buffer, size, format, flip) };
+    }
+
     template <typename Image>
     void drawPixels(const Image& image) {
         auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
@@ -119,20 +154,45 @@ public:
                optional<float> depth,
                optional<int32_t> stencil);
 
-    struct Drawable {
-        DrawMode drawMode;
-        DepthMode depthMode;
-        StencilMode stencilMode;
-        ColorMode colorMode;
-        gl::ProgramID program;
-        gl::BufferID vertexBuffer;
-        gl::BufferID indexBuffer;
-        const std::vector<Segment>& segments;
-        std::function<void ()> bindUniforms;
-        std::function<void (std::size_t)> bindAttributes;
-    };
-
-    void draw(const Drawable&);
+    // Issues one draw call per segment. Vertex and index buffers are sub-allocated, so the
+    // segments' offsets are relative to `vertexOffset` and `indexOffset`. The binders are
+    // invoked inline rather than through a type-erased callback, so submitting a draw doesn't
+    // allocate: `bindUniforms()` is called once, and `bindAttributes(vertexOffset)` for every
+    // segment that needs its attribute pointers (re)established.
+    template <class DrawMode, class BindUniforms, class BindAttributes>
+    void draw(const DrawMode& drawMode,
+              const DepthMode& depthMode,
+              const StencilMode& stencilMode,
+              const ColorMode& colorMode,
+              ProgramID program_,
+              BufferID vertexBuffer_,
+              std::size_t vertexOffset,
+              BufferID indexBuffer_,
+              std::size_t indexOffset,
+              const std::vector<Segment>& segments,
+              BindUniforms&& bindUniforms,
+              BindAttributes&& bindAttributes) {
+        if (segments.empty()) {
+            return;
+        }
+
+        const PrimitiveType primitiveType = (*this)(drawMode);
+
+        setDepthMode(depthMode);
+        setStencilMode(stencilMode);
+        setColorMode(colorMode);
+
+        program = program_;
+
+        bindUniforms();
+
+        for (const auto& segment : segments) {
+            if (bindSegment(segment, vertexBuffer_, indexBuffer_)) {
+                bindAttributes(vertexOffset + segment.vertexOffset);
+            }
+            drawSegment(primitiveType, indexOffset + segment.indexOffset, segment.indexLength);
+        }
+    }
 
     void setDepthMode(const DepthMode&);
     void setStencilMode(const StencilMode&);
@@ -158,55 +218,85 @@ public:
 
     void setDirtyState();
 
-    State<value::ActiveTexture> activeTexture;
-    State<value::BindFramebuffer> bindFramebuffer;
-    State<value::Viewport> viewport;
-    std::array<State<value::BindTexture>, 2> texture;
-    State<value::BindVertexArray> vertexArrayObject;
-    State<value::Program> program;
+    // Running totals of the work submitted through this context. Take the difference
+    // between two snapshots to measure a frame.
+    struct Statistics {
+        std::size_t drawCalls = 0;
+        std::size_t stateChanges = 0;
+        std::size_t bufferBytesUploaded = 0;
+        std::size_t textureBytesUploaded = 0;
+    };
+
+    const Statistics& getStatistics() const {
+        return statistics;
+    }
+
+    // How full and how fragmented the pooled vertex or index buffers are.
+    BufferArena::Statistics getBufferArenaStatistics(BufferType type) const {
+        return (type == BufferType::Vertex ? vertexArena : indexArena).getStatistics();
+    }
+
+private:
+    // Declared ahead of the state below, which counts its changes in here.
+    Statistics statistics;
+
+public:
+    State<value::ActiveTexture> activeTexture { statistics.stateChanges };
+    State<value::BindFramebuffer> bindFramebuffer { statistics.stateChanges };
+    State<value::Viewport> viewport { statistics.stateChanges };
+    std::array<State<value::BindTexture>, 2> texture {{
+        State<value::BindTexture> { statistics.stateChanges },
+        State<value::BindTexture> { statistics.stateChanges }
+    }};
+    State<value::BindVertexArray> vertexArrayObject { statistics.stateChanges };
+    State<value::Program> program { statistics.stateChanges };
 
 #if not MBGL_USE_GLES2
-    State<value::PixelZoom> pixelZoom;
-    State<value::RasterPos> rasterPos;
-    State<value::PixelStorePack> pixelStorePack;
-    State<value::PixelStoreUnpack> pixelStoreUnpack;
-    State<value::PixelTransferDepth> pixelTransferDepth;
-    State<value::PixelTransferStencil> pixelTransferStencil;
+    State<value::PixelZoom> pixelZoom { statistics.stateChanges };
+    State<value::RasterPos> rasterPos { statistics.stateChanges };
+    State<value::PixelStorePack> pixelStorePack { statistics.stateChanges };
+    State<value::BindPixelPackBuffer> pixelPackBuffer { statistics.stateChanges };
+    State<value::PixelStoreUnpack> pixelStoreUnpack { statistics.stateChanges };
+    State<value::PixelTransferDepth> pixelTransferDepth { statistics.stateChanges };
+    State<value::PixelTransferStencil> pixelTransferStencil { statistics.stateChanges };
 #endif // MBGL_USE_GLES2
 
 private:
-    State<value::StencilFunc> stencilFunc;
-    State<value::StencilMask> stencilMask;
-    State<value::StencilTest> stencilTest;
-    State<value::StencilOp> stencilOp;
-    State<value::DepthRange> depthRange;
-    State<value::DepthMask> depthMask;
-    State<value::DepthTest> depthTest;
-    State<value::DepthFunc> depthFunc;
-    State<value::Blend> blend;
-    State<value::BlendEquation> blendEquation;
-    State<value::BlendFunc> blendFunc;
-    State<value::BlendColor> blendColor;
-    State<value::ColorMask> colorMask;
-    State<value::ClearDepth> clearDepth;
-    State<value::ClearColor> clearColor;
-    State<value::ClearStencil> clearStencil;
-    State<value::LineWidth> lineWidth;
-    State<value::BindRenderbuffer> bindRenderbuffer;
+    State<value::StencilFunc> stencilFunc { statistics.stateChanges };
+    State<value::StencilMask> stencilMask { statistics.stateChanges };
+    State<value::StencilTest> stencilTest { statistics.stateChanges };
+    State<value::StencilOp> stencilOp { statistics.stateChanges };
+    State<value::DepthRange> depthRange { statistics.stateChanges };
+    State<value::DepthMask> depthMask { statistics.stateChanges };
+    State<value::DepthTest> depthTest { statistics.stateChanges };
+    State<value::DepthFunc> depthFunc { statistics.stateChanges };
+    State<value::Blend> blend { statistics.stateChanges };
+    State<value::BlendEquation> blendEquation { statistics.stateChanges };
+    State<value::BlendFunc> blendFunc { statistics.stateChanges };
+    State<value::BlendColor> blendColor { statistics.stateChanges };
+    State<value::ColorMask> colorMask { statistics.stateChanges };
+    State<value::ClearDepth> clearDepth { statistics.stateChanges };
+    State<value::ClearColor> clearColor { statistics.stateChanges };
+    State<value::ClearStencil> clearStencil { statistics.stateChanges };
+    State<value::LineWidth> lineWidth { statistics.stateChanges };
+    State<value::BindRenderbuffer> bindRenderbuffer { statistics.stateChanges };
 #if not MBGL_USE_GLES2
-    State<value::PointSize> pointSize;
+    State<value::PointSize> pointSize { statistics.stateChanges };
 #endif // MBGL_USE_GLES2
-    State<value::BindVertexBuffer> vertexBuffer;
-    State<value::BindElementBuffer> elementBuffer;
+    State<value::BindVertexBuffer> vertexBuffer { statistics.stateChanges };
+    State<value::BindElementBuffer> elementBuffer { statistics.stateChanges };
 
-    UniqueBuffer createVertexBuffer(const void* data, std::size_t size);
-    UniqueBuffer createIndexBuffer(const void* data, std::size_t size);
+    UniqueBuffer createBuffer(BufferType, const void* data, std::size_t size);
+    void updateBuffer(BufferType, BufferID, std::size_t offset, const void* data, std::size_t size);
+    void bindBuffer(BufferType, BufferID);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit);
     void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
 #if not MBGL_USE_GLES2
+    void readFramebuffer(BufferID, Size, TextureFormat);
+    std::unique_ptr<uint8_t[]> readPixelPackBuffer(BufferID, Size, TextureFormat, bool flip);
     void drawPixels(Size size, const void* data, TextureFormat);
 #endif // MBGL_USE_GLES2
 
@@ -216,6 +306,11 @@ private:
     PrimitiveType operator()(const Triangles&);
     PrimitiveType operator()(const TriangleStrip&);
 
+    // Binds the segment's vertex array object, creating it if necessary, and returns whether
+    // attribute bindings have to be (re)established for it.
+    bool bindSegment(const Segment&, BufferID vertexBuffer, BufferID indexBuffer);
+    void drawSegment(PrimitiveType, std::size_t indexOffset, std::size_t indexLength);
+
     friend detail::ProgramDeleter;
     friend detail::ShaderDeleter;
     friend detail::BufferDeleter;
@@ -223,6 +318,7 @@ private:
     friend detail::VertexArrayDeleter;
     friend detail::FramebufferDeleter;
     friend detail::RenderbufferDeleter;
+    friend BufferArena;
 
     std::vector<TextureID> pooledTextures;
 
@@ -233,6 +329,11 @@ private:
     std::vector<VertexArrayID> abandonedVertexArrays;
     std::vector<FramebufferID> abandonedFramebuffers;
     std::vector<RenderbufferID> abandonedRenderbuffers;
+
+    // Vertex and index buffers are sub-allocated from these. Declared after the abandoned
+    // objects, which they return their buffers to.
+    BufferArena vertexArena { *this, BufferType::Vertex };
+    BufferArena indexArena { *this, BufferType::Index };
 };
 
 } // namespace gl
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <mbgl/gl/primitives.hpp>
-#include <mbgl/util/variant.hpp>
 
 #include <cassert>
 
@@ -65,12 +64,5 @@ public:
     static constexpr std::size_t bufferGroupSize = 1;
 };
 
-using DrawMode = variant<
-    Points,
-    Lines,
-    LineStrip,
-    Triangles,
-    TriangleStrip>;
-
 } // namespace gl
 } // namespace mbgl
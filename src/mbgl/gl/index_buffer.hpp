@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/gl/draw_mode.hpp>
 #include <mbgl/util/ignore.hpp>
 
@@ -33,7 +33,12 @@ private:
 template <class DrawMode>
 class IndexBuffer {
 public:
-    UniqueBuffer buffer;
+    BufferRange range;
+
+    // The index of the first index within the range's buffer.
+    std::size_t indexOffset() const {
+        return range.offset / sizeof(uint16_t);
+    }
 };
 
 } // namespace gl
@@ -0,0 +1,15 @@
+#include <mbgl/gl/pixel_buffer.hpp>
+
+namespace mbgl {
+namespace gl {
+
+ExtensionFunction<void*(GLenum target, GLenum access)>
+    MapBuffer({ { "GL_ARB_pixel_buffer_object", "glMapBuffer" },
+                { "GL_EXT_pixel_buffer_object", "glMapBufferARB" } });
+
+ExtensionFunction<GLboolean(GLenum target)>
+    UnmapBuffer({ { "GL_ARB_pixel_buffer_object", "glUnmapBuffer" },
+                  { "GL_EXT_pixel_buffer_object", "glUnmapBufferARB" } });
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+namespace mbgl {
+namespace gl {
+
+extern ExtensionFunction<void*(GLenum target, GLenum access)> MapBuffer;
+extern ExtensionFunction<GLboolean(GLenum target)> UnmapBuffer;
+
+} // namespace gl
+} // namespace mbgl
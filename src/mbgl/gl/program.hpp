@@ -25,13 +25,25 @@ public:
 
     static_assert(std::is_standard_layout<Vertex>::value, "vertex type must use standard layout");
 
+    // The shaders only need to live until the program is linked; the context deletes
+    // them at the next cleanup.
     Program(Context& context, const std::string& vertexSource, const std::string& fragmentSource)
-        : vertexShader(context.createShader(ShaderType::Vertex, vertexSource)),
-          fragmentShader(context.createShader(ShaderType::Fragment, fragmentSource)),
-          program(context.createProgram(vertexShader, fragmentShader)),
+        : program(context.createProgram(context.createShader(ShaderType::Vertex, vertexSource),
+                                        context.createShader(ShaderType::Fragment, fragmentSource))),
           attributesState(Attributes::state(program)),
           uniformsState((context.linkProgram(program), Uniforms::state(program))) {}
 
+    // Restores a program from a binary obtained with getBinary(). Attribute locations were
+    // bound before the original program was linked, and are part of the binary.
+    Program(Context& context, BinaryProgramFormat binaryFormat, const std::string& binary)
+        : program(context.createProgram(binaryFormat, binary)),
+          attributesState(Attributes::state(program)),
+          uniformsState(Uniforms::state(program)) {}
+
+    optional<std::pair<BinaryProgramFormat, std::string>> getBinary(Context& context) const {
+        return context.getBinaryProgram(program);
+    }
+
     template <class DrawMode>
     void draw(Context& context,
               DrawMode drawMode,
@@ -43,23 +55,26 @@ public:
               const IndexBuffer<DrawMode>& indexBuffer,
               const SegmentVector<Attributes>& segments) {
         static_assert(std::is_same<Primitive, typename DrawMode::Primitive>::value, "incompatible draw mode");
-        context.draw({
-            std::move(drawMode),
-            std::move(depthMode),
-            std::move(stencilMode),
-            std::move(colorMode),
+        context.draw(
+            drawMode,
+            depthMode,
+            stencilMode,
+            colorMode,
             program,
-            vertexBuffer.buffer,
-            indexBuffer.buffer,
+            vertexBuffer.range.buffer,
+            vertexBuffer.vertexOffset(),
+            indexBuffer.range.buffer,
+            indexBuffer.indexOffset(),
             segments,
-            Uniforms::binder(uniformsState, std::move(uniformValues)),
-            Attributes::binder(attributesState)
-        });
+            [&] () {
+                Uniforms::bind(uniformsState, uniformValues);
+            },
+            [&] (std::size_t vertexOffset) {
+                Attributes::bind(attributesState, vertexOffset);
+            });
     }
 
 private:
-    UniqueShader vertexShader;
-    UniqueShader fragmentShader;
     UniqueProgram program;
 
     typename Attributes::State attributesState;
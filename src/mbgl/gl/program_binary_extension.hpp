@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
+namespace mbgl {
+namespace gl {
+
+extern ExtensionFunction<void(GLuint program,
+                              GLsizei bufSize,
+                              GLsizei* length,
+                              GLenum* binaryFormat,
+                              GLvoid* binary)>
+    GetProgramBinary;
+
+extern ExtensionFunction<void(GLuint program,
+                              GLenum binaryFormat,
+                              const GLvoid* binary,
+                              GLint length)>
+    ProgramBinary;
+
+// Only ARB_get_program_binary has it; OES_get_program_binary always allows retrieval.
+extern ExtensionFunction<void(GLuint program,
+                              GLenum pname,
+                              GLint value)>
+    ProgramParameteri;
+
+} // namespace gl
+} // namespace mbgl
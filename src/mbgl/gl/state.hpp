@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace mbgl {
 namespace gl {
 
@@ -15,10 +17,19 @@ namespace gl {
 template <typename T>
 class State {
 public:
+    State() = default;
+
+    // Counts the changes that actually result in an OpenGL call in `changes_`.
+    explicit State(std::size_t& changes_) : changes(&changes_) {
+    }
+
     void operator=(const typename T::Type& value) {
         if (*this != value) {
             setCurrentValue(value);
             T::Set(currentValue);
+            if (changes) {
+                ++*changes;
+            }
         }
     }
 
@@ -52,6 +63,7 @@ public:
 private:
     typename T::Type currentValue = T::Default;
     bool dirty = true;
+    std::size_t* changes = nullptr;
 };
 
 // Helper struct that stores the current state and restores it upon destruction. You should not use
@@ -14,6 +14,7 @@ using TextureID = uint32_t;
 using VertexArrayID = uint32_t;
 using FramebufferID = uint32_t;
 using RenderbufferID = uint32_t;
+using BinaryProgramFormat = uint32_t;
 
 using AttributeLocation = int32_t;
 using UniformLocation = int32_t;
@@ -24,6 +25,11 @@ enum class ShaderType : uint32_t {
     Fragment = 0x8B30
 };
 
+enum class BufferType : uint32_t {
+    Vertex = 0x8892,
+    Index = 0x8893
+};
+
 enum class DataType : uint32_t {
     Byte = 0x1400,
     UnsignedByte = 0x1401,
@@ -6,7 +6,6 @@
 #include <mbgl/util/indexed_tuple.hpp>
 
 #include <array>
-#include <functional>
 
 namespace mbgl {
 namespace gl {
@@ -70,10 +69,9 @@ public:
         return State { { uniformLocation(id, Us::name) }... };
     }
 
-    static std::function<void ()> binder(State& state, Values&& values_) {
-        return [&state, values = std::move(values_)] () mutable {
-            util::ignore({ (state.template get<Us>() = values.template get<Us>(), 0)... });
-        };
+    // Only uniforms whose value differs from the one last set on this program are uploaded.
+    static void bind(State& state, const Values& values) {
+        util::ignore({ (state.template get<Us>() = values.template get<Us>(), 0)... });
     }
 };
 
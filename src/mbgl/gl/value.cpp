@@ -403,6 +403,18 @@ PixelStorePack::Type PixelStorePack::Get() {
     return value;
 }
 
+const constexpr BindPixelPackBuffer::Type BindPixelPackBuffer::Default;
+
+void BindPixelPackBuffer::Set(const Type& value) {
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, value));
+}
+
+BindPixelPackBuffer::Type BindPixelPackBuffer::Get() {
+    GLint binding;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &binding));
+    return binding;
+}
+
 const constexpr PixelStoreUnpack::Type PixelStoreUnpack::Default;
 
 void PixelStoreUnpack::Set(const Type& value) {
@@ -275,6 +275,13 @@ struct PixelStorePack {
     static Type Get();
 };
 
+struct BindPixelPackBuffer {
+    using Type = gl::BufferID;
+    static const constexpr Type Default = 0;
+    static void Set(const Type&);
+    static Type Get();
+};
+
 struct PixelStoreUnpack {
     using Type = PixelStorageType;
     static const constexpr Type Default = { 4 };
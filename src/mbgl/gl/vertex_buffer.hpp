@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/gl/primitives.hpp>
 #include <mbgl/gl/draw_mode.hpp>
 #include <mbgl/util/ignore.hpp>
@@ -39,7 +39,12 @@ public:
     static constexpr std::size_t vertexSize = sizeof(Vertex);
 
     std::size_t vertexCount;
-    UniqueBuffer buffer;
+    BufferRange range;
+
+    // The index of the first vertex within the range's buffer.
+    std::size_t vertexOffset() const {
+        return range.offset / vertexSize;
+    }
 };
 
 } // namespace gl
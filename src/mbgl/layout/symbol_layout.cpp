@@ -2,7 +2,7 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/clip_lines.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
@@ -58,17 +58,16 @@ SymbolLayout::SymbolLayout(std::vector<std::string> layerIDs_,
     auto layerName = layer.getName();
 
     // Determine and load glyph ranges
-    const size_t featureCount = layer.featureCount();
-    for (size_t i = 0; i < featureCount; ++i) {
-        auto feature = layer.getFeature(i);
-        if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
-            continue;
+    const CompiledFilter compiledFilter(filter, layer);
+    layer.eachFeature([&] (const GeometryTileFeature& feature, std::size_t i) {
+        if (!compiledFilter(feature))
+            return true;
 
         SymbolFeature ft;
         ft.index = i;
 
         auto getValue = [&feature](const std::string& key) -> std::string {
-            auto value = feature->getValue(key);
+            auto value = feature.getValue(key);
             if (!value)
                 return std::string();
             if (value->is<std::string>())
@@ -106,11 +105,13 @@ SymbolLayout::SymbolLayout(std::vector<std::string> layerIDs_,
         }
 
         if (ft.text || ft.icon) {
-            ft.type = feature->getType();
-            ft.geometry = feature->getGeometries();
+            ft.type = feature.getType();
+            ft.geometry = feature.getGeometries();
             features.push_back(std::move(ft));
         }
-    }
+
+        return true;
+    });
 
     if (layout.get<SymbolPlacement>() == SymbolPlacementType::Line) {
         util::mergeLines(features);
@@ -201,7 +202,7 @@ void SymbolLayout::prepare(uintptr_t tileUID,
 
             // Add the glyphs we need for this label to the glyph atlas.
             if (shapedText) {
-                glyphAtlas.addGlyphs(tileUID, *feature.text, layout.get<TextFont>(), **glyphSet, face);
+                glyphAtlas.addGlyphs(tileUID, *feature.text, layout.get<TextFont>(), *glyphSet, face);
             }
         }
 
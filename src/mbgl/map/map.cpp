@@ -13,11 +13,13 @@
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/query_parameters.hpp>
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/gl/context.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/projection.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/async_task.hpp>
 #include <mbgl/util/mapbox.hpp>
@@ -55,7 +57,8 @@ public:
          MapMode,
          GLContextMode,
          ConstrainMode,
-         ViewportMode);
+         ViewportMode,
+         const optional<std::string>& programCacheDir);
 
     void onSourceAttributionChanged(style::Source&, const std::string&) override;
     void onUpdate(Update) override;
@@ -79,6 +82,7 @@ public:
     const MapMode mode;
     const GLContextMode contextMode;
     const float pixelRatio;
+    const optional<std::string> programCacheDir;
 
     MapDebugOptions debugOptions { MapDebugOptions::NoDebug };
 
@@ -96,6 +100,7 @@ public:
     std::unique_ptr<AsyncRequest> styleRequest;
 
     size_t sourceCacheSize;
+    size_t sourceCacheBudget = util::DEFAULT_TILE_CACHE_BUDGET;
     bool loading = false;
 
     util::AsyncTask asyncInvalidate;
@@ -110,7 +115,8 @@ Map::Map(Backend& backend,
          MapMode mapMode,
          GLContextMode contextMode,
          ConstrainMode constrainMode,
-         ViewportMode viewportMode)
+         ViewportMode viewportMode,
+         const optional<std::string>& programCacheDir)
     : impl(std::make_unique<Impl>(*this,
                                   backend,
                                   pixelRatio,
@@ -119,7 +125,8 @@ Map::Map(Backend& backend,
                                   mapMode,
                                   contextMode,
                                   constrainMode,
-                                  viewportMode)) {
+                                  viewportMode,
+                                  programCacheDir)) {
     impl->transform.resize(size);
 }
 
@@ -131,7 +138,8 @@ Map::Impl::Impl(Map& map_,
                 MapMode mode_,
                 GLContextMode contextMode_,
                 ConstrainMode constrainMode_,
-                ViewportMode viewportMode_)
+                ViewportMode viewportMode_,
+                const optional<std::string>& programCacheDir_)
     : map(map_),
       backend(backend_),
       fileSource(fileSource_),
@@ -142,6 +150,7 @@ Map::Impl::Impl(Map& map_,
       mode(mode_),
       contextMode(contextMode_),
       pixelRatio(pixelRatio_),
+      programCacheDir(programCacheDir_),
       annotationManager(std::make_unique<AnnotationManager>(pixelRatio)),
       asyncInvalidate([this] {
           if (mode == MapMode::Continuous) {
@@ -194,6 +203,48 @@ void Map::renderStill(View& view, StillImageCallback callback) {
     impl->onUpdate(Update::Repaint);
 }
 
+void Map::renderStillTiles(View& view, const Size grid, StillTilesCallback callback) {
+    if (!callback) {
+        Log::Error(Event::General, "StillTilesCallback not set");
+        return;
+    }
+
+    const Size size = impl->transform.getState().getSize();
+    const Size framebufferSize { static_cast<uint32_t>(size.width * impl->pixelRatio),
+                                 static_cast<uint32_t>(size.height * impl->pixelRatio) };
+    if (!grid || framebufferSize.width % grid.width != 0 || framebufferSize.height % grid.height != 0) {
+        callback(std::make_exception_ptr(util::MisuseException("Map size is not a multiple of the metatile grid")), {});
+        return;
+    }
+
+    renderStill(view, [this, grid, framebufferSize, callback] (std::exception_ptr error) {
+        if (error) {
+            callback(error, {});
+            return;
+        }
+
+        // Still called from within the render, with the view's framebuffer bound.
+        const auto metatile = impl->backend.getContext().readFramebuffer<PremultipliedImage>(framebufferSize);
+
+        const Size tileSize { framebufferSize.width / grid.width, framebufferSize.height / grid.height };
+        std::vector<PremultipliedImage> tiles;
+        tiles.reserve(grid.width * grid.height);
+        for (uint32_t y = 0; y < grid.height; ++y) {
+            for (uint32_t x = 0; x < grid.width; ++x) {
+                PremultipliedImage tile(tileSize);
+                for (uint32_t row = 0; row < tileSize.height; ++row) {
+                    std::copy_n(metatile.data.get() + (y * tileSize.height + row) * metatile.stride() + x * tile.stride(),
+                                tile.stride(),
+                                tile.data.get() + row * tile.stride());
+                }
+                tiles.push_back(std::move(tile));
+            }
+        }
+
+        callback(nullptr, std::move(tiles));
+    });
+}
+
 void Map::Impl::renderStill() {
     if (!stillImageRequest) {
         return;
@@ -258,7 +309,7 @@ void Map::Impl::render(View& view) {
     updateFlags = Update::Nothing;
 
     if (!painter) {
-        painter = std::make_unique<Painter>(backend.getContext(), transform.getState(), pixelRatio);
+        painter = std::make_unique<Painter>(backend.getContext(), transform.getState(), pixelRatio, programCacheDir);
     }
 
     if (mode == MapMode::Continuous) {
@@ -342,7 +393,8 @@ void Map::setStyleURL(const std::string& url) {
     impl->styleJSON.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
+    impl->style->setSourceTileCacheBudget(impl->sourceCacheBudget);
 
     impl->styleRequest = impl->fileSource.request(Resource::style(impl->styleURL), [this](Response res) {
         // Once we get a fresh style, or the style is mutated, stop revalidating.
@@ -385,7 +437,8 @@ void Map::setStyleJSON(const std::string& json) {
     impl->styleJSON.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
+    impl->style->setSourceTileCacheBudget(impl->sourceCacheBudget);
 
     impl->loadStyleJSON(json);
 }
@@ -795,6 +848,31 @@ void Map::removeAnnotation(AnnotationID annotation) {
     impl->onUpdate(Update::AnnotationStyle | Update::AnnotationData);
 }
 
+AnnotationIDs Map::addAnnotations(const std::vector<Annotation>& annotations) {
+    AnnotationIDs result;
+    result.reserve(annotations.size());
+    for (const auto& annotation : annotations) {
+        result.push_back(impl->annotationManager->addAnnotation(annotation, getMaxZoom()));
+    }
+    impl->onUpdate(Update::AnnotationStyle | Update::AnnotationData);
+    return result;
+}
+
+void Map::updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>& annotations) {
+    Update flags = Update::Nothing;
+    for (const auto& annotation : annotations) {
+        flags |= impl->annotationManager->updateAnnotation(annotation.first, annotation.second, getMaxZoom());
+    }
+    impl->onUpdate(flags);
+}
+
+void Map::removeAnnotations(const AnnotationIDs& annotations) {
+    for (const auto& annotation : annotations) {
+        impl->annotationManager->removeAnnotation(annotation);
+    }
+    impl->onUpdate(Update::AnnotationStyle | Update::AnnotationData);
+}
+
 #pragma mark - Feature query api
 
 std::vector<Feature> Map::queryRenderedFeatures(const ScreenCoordinate& point, const optional<std::vector<std::string>>& layerIDs) {
@@ -1008,6 +1086,10 @@ MapDebugOptions Map::getDebug() const {
     return impl->debugOptions;
 }
 
+RenderStats Map::getRenderStats() const {
+    return impl->painter ? impl->painter->getStats() : RenderStats();
+}
+
 bool Map::isFullyLoaded() const {
     return impl->style ? impl->style->isLoaded() : false;
 }
@@ -1064,6 +1146,15 @@ void Map::setSourceTileCacheSize(size_t size) {
     }
 }
 
+void Map::setSourceTileCacheBudget(size_t budget) {
+    if (budget != impl->sourceCacheBudget) {
+        impl->sourceCacheBudget = budget;
+        if (!impl->style) return;
+        impl->style->setSourceTileCacheBudget(budget);
+        impl->backend.invalidate();
+    }
+}
+
 void Map::onLowMemory() {
     if (impl->painter) {
         BackendScope guard(impl->backend);
@@ -0,0 +1,141 @@
+#include <mbgl/programs/binary_program.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <zlib.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace mbgl {
+
+namespace {
+
+// Bump when the file layout below changes.
+constexpr const char magic[8] = { 'M', 'B', 'G', 'L', 'P', 'R', 'G', '2' };
+
+// Layout: magic, format, identifier length, identifier, code length, CRC-32 of the code, code.
+// The length and checksum reject files that were cut short or overwritten halfway.
+void appendUint32(std::string& data, uint32_t value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+uint32_t readUint32(const std::string& data, std::size_t& offset) {
+    if (offset + sizeof(uint32_t) > data.size()) {
+        throw std::runtime_error("truncated program binary");
+    }
+    uint32_t value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+}
+
+uint32_t checksum(const std::string& code) {
+    return crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(code.data()), uInt(code.size()));
+}
+
+} // namespace
+
+BinaryProgram::BinaryProgram(gl::BinaryProgramFormat binaryFormat_,
+                             std::string&& binaryCode_,
+                             std::string binaryIdentifier_)
+    : binaryFormat(binaryFormat_),
+      binaryCode(std::move(binaryCode_)),
+      binaryIdentifier(std::move(binaryIdentifier_)) {
+}
+
+BinaryProgram::BinaryProgram(const std::string& data) {
+    if (data.size() < sizeof(magic) || std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("not a program binary");
+    }
+
+    std::size_t offset = sizeof(magic);
+    binaryFormat = readUint32(data, offset);
+
+    const uint32_t identifierLength = readUint32(data, offset);
+    if (offset + identifierLength > data.size()) {
+        throw std::runtime_error("truncated program binary");
+    }
+    binaryIdentifier = data.substr(offset, identifierLength);
+    offset += identifierLength;
+
+    const uint32_t codeLength = readUint32(data, offset);
+    const uint32_t codeChecksum = readUint32(data, offset);
+    if (offset + codeLength != data.size()) {
+        throw std::runtime_error("program binary has the wrong size");
+    }
+    binaryCode = data.substr(offset);
+    if (checksum(binaryCode) != codeChecksum) {
+        throw std::runtime_error("program binary is corrupt");
+    }
+}
+
+std::string BinaryProgram::serialize() const {
+    std::string data;
+    data.reserve(sizeof(magic) + 4 * sizeof(uint32_t) + binaryIdentifier.size() + binaryCode.size());
+    data.append(magic, sizeof(magic));
+    appendUint32(data, binaryFormat);
+    appendUint32(data, static_cast<uint32_t>(binaryIdentifier.size()));
+    data.append(binaryIdentifier);
+    appendUint32(data, static_cast<uint32_t>(binaryCode.size()));
+    appendUint32(data, checksum(binaryCode));
+    data.append(binaryCode);
+    return data;
+}
+
+std::string BinaryProgram::identifierFor(const std::string& vertexSource, const std::string& fragmentSource) {
+    std::ostringstream ss;
+    ss << std::hex << std::hash<std::string>()(vertexSource) << '-'
+       << std::hash<std::string>()(fragmentSource) << '-'
+       << vertexSource.size() << '-' << fragmentSource.size();
+    return ss.str();
+}
+
+optional<BinaryProgram> BinaryProgram::load(const std::string& path, const std::string& identifier) {
+    std::string data;
+    try {
+        data = util::read_file(path);
+    } catch (const std::exception&) {
+        // Not cached yet.
+        return {};
+    }
+
+    try {
+        BinaryProgram program(data);
+        if (program.identifier() == identifier) {
+            return { std::move(program) };
+        }
+        Log::Info(Event::OpenGL, "Cached program %s is outdated", path.c_str());
+    } catch (const std::exception& error) {
+        Log::Warning(Event::OpenGL, "Could not read cached program %s: %s", path.c_str(), error.what());
+    }
+
+    return {};
+}
+
+void BinaryProgram::save(const std::string& path) const {
+    // Other processes and threads may be reading or writing the same file. Write a file of
+    // our own and move it into place, so that they only ever see a complete one.
+    static std::atomic<uint64_t> saves { 0 };
+    const std::string temporaryPath =
+        path + "." + std::to_string(getpid()) + "." + std::to_string(saves++) + ".tmp";
+    try {
+        util::write_file(temporaryPath, serialize());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error(std::strerror(errno));
+        }
+    } catch (const std::exception& error) {
+        Log::Warning(Event::OpenGL, "Could not cache program %s: %s", path.c_str(), error.what());
+        std::remove(temporaryPath.c_str());
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <mbgl/gl/types.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+
+namespace mbgl {
+
+// A linked program binary as stored in the program cache, together with an identifier of
+// the sources it was built from, so that binaries of outdated shaders aren't restored.
+class BinaryProgram {
+public:
+    BinaryProgram(gl::BinaryProgramFormat, std::string&& code, std::string identifier);
+
+    // Parses a serialized program; throws std::runtime_error if the data is malformed.
+    explicit BinaryProgram(const std::string& data);
+
+    std::string serialize() const;
+
+    gl::BinaryProgramFormat format() const {
+        return binaryFormat;
+    }
+
+    const std::string& code() const {
+        return binaryCode;
+    }
+
+    const std::string& identifier() const {
+        return binaryIdentifier;
+    }
+
+    // Returns an identifier for a pair of shader sources.
+    static std::string identifierFor(const std::string& vertexSource, const std::string& fragmentSource);
+
+    // Loads the cached binary at `path` if it was built from the sources `identifier`
+    // stands for. Missing, malformed and outdated files are ignored.
+    static optional<BinaryProgram> load(const std::string& path, const std::string& identifier);
+
+    // Writes the binary to `path`, logging rather than throwing on failure.
+    void save(const std::string& path) const;
+
+private:
+    gl::BinaryProgramFormat binaryFormat = 0;
+    std::string binaryCode;
+    std::string binaryIdentifier;
+};
+
+} // namespace mbgl
@@ -2,6 +2,8 @@
 
 #include <mbgl/gl/program.hpp>
 #include <mbgl/programs/program_parameters.hpp>
+#include <mbgl/programs/binary_program.hpp>
+#include <mbgl/util/logging.hpp>
 
 #include <sstream>
 #include <cassert>
@@ -14,9 +16,36 @@ public:
     using ParentType = gl::Program<Primitive, Attributes, Uniforms>;
 
     Program(gl::Context& context, const ProgramParameters& programParameters)
-        : ParentType(context, vertexSource(programParameters), fragmentSource(programParameters))
+        : ParentType(createProgram(context, programParameters))
         {}
-    
+
+    // Restores the program from the program cache when possible. Otherwise compiles and
+    // links it, and adds its binary to the cache.
+    static ParentType createProgram(gl::Context& context, const ProgramParameters& programParameters) {
+        const std::string vertexSource_ = vertexSource(programParameters);
+        const std::string fragmentSource_ = fragmentSource(programParameters);
+
+        const optional<std::string> cachePath = programParameters.cachePath(Shaders::name);
+        if (!cachePath || !context.supportsProgramBinaries()) {
+            return ParentType(context, vertexSource_, fragmentSource_);
+        }
+
+        const std::string identifier = BinaryProgram::identifierFor(vertexSource_, fragmentSource_);
+        if (optional<BinaryProgram> cached = BinaryProgram::load(*cachePath, identifier)) {
+            try {
+                return ParentType(context, cached->format(), cached->code());
+            } catch (const std::exception& error) {
+                Log::Info(Event::OpenGL, "Recompiling cached program %s: %s", cachePath->c_str(), error.what());
+            }
+        }
+
+        ParentType result(context, vertexSource_, fragmentSource_);
+        if (auto binary = result.getBinary(context)) {
+            BinaryProgram(binary->first, std::move(binary->second), identifier).save(*cachePath);
+        }
+        return result;
+    }
+
     static std::string pixelRatioDefine(const ProgramParameters& parameters) {
         std::ostringstream pixelRatioSS;
         pixelRatioSS.imbue(std::locale("C"));
@@ -0,0 +1,15 @@
+#include <mbgl/programs/program_parameters.hpp>
+#include <mbgl/util/string.hpp>
+
+namespace mbgl {
+
+optional<std::string> ProgramParameters::cachePath(const char* name) const {
+    if (!cacheDir) {
+        return {};
+    }
+
+    return *cacheDir + "/mbgl-program-" + name + "-" + util::toString(pixelRatio) +
+           (overdraw ? "-overdraw" : "") + ".bin";
+}
+
+} // namespace mbgl
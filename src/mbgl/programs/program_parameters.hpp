@@ -1,16 +1,27 @@
 #pragma once
 
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+
 namespace mbgl {
 
 class ProgramParameters {
 public:
-    ProgramParameters(float pixelRatio_ = 1.0, bool overdraw_ = false)
+    ProgramParameters(float pixelRatio_ = 1.0,
+                      bool overdraw_ = false,
+                      optional<std::string> cacheDir_ = {})
       : pixelRatio(pixelRatio_),
-        overdraw(overdraw_) {}
+        overdraw(overdraw_),
+        cacheDir(std::move(cacheDir_)) {}
+
+    // Returns where the linked binary of the named program is cached, or nothing when
+    // program binaries aren't cached.
+    optional<std::string> cachePath(const char* name) const;
 
     float pixelRatio;
     bool overdraw;
+    optional<std::string> cacheDir;
 };
 
 } // namespace mbgl
-
@@ -8,9 +8,40 @@
 #include <mbgl/programs/debug_program.hpp>
 #include <mbgl/programs/collision_box_program.hpp>
 #include <mbgl/programs/program_parameters.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <utility>
 
 namespace mbgl {
 
+// Builds the program the first time something is drawn with it, so that programs for layer
+// types a style doesn't use are never compiled.
+template <class P>
+class LazyProgram {
+public:
+    LazyProgram(gl::Context& context_, ProgramParameters programParameters_)
+        : context(context_),
+          programParameters(std::move(programParameters_)) {
+    }
+
+    template <class... Args>
+    void draw(Args&&... args) {
+        get().draw(std::forward<Args>(args)...);
+    }
+
+    P& get() {
+        if (!program) {
+            program.emplace(context, programParameters);
+        }
+        return *program;
+    }
+
+private:
+    gl::Context& context;
+    const ProgramParameters programParameters;
+    optional<P> program;
+};
+
 class Programs {
 public:
     Programs(gl::Context& context, const ProgramParameters& programParameters)
@@ -26,25 +57,25 @@ public:
           symbolIcon(context, programParameters),
           symbolIconSDF(context, programParameters),
           symbolGlyph(context, programParameters),
-          debug(context, ProgramParameters(programParameters.pixelRatio, false)),
-          collisionBox(context, ProgramParameters(programParameters.pixelRatio, false)) {
+          debug(context, ProgramParameters(programParameters.pixelRatio, false, programParameters.cacheDir)),
+          collisionBox(context, ProgramParameters(programParameters.pixelRatio, false, programParameters.cacheDir)) {
     }
 
-    CircleProgram circle;
-    FillProgram fill;
-    FillPatternProgram fillPattern;
-    FillOutlineProgram fillOutline;
-    FillOutlinePatternProgram fillOutlinePattern;
-    LineProgram line;
-    LineSDFProgram lineSDF;
-    LinePatternProgram linePattern;
-    RasterProgram raster;
-    SymbolIconProgram symbolIcon;
-    SymbolSDFProgram symbolIconSDF;
-    SymbolSDFProgram symbolGlyph;
-
-    DebugProgram debug;
-    CollisionBoxProgram collisionBox;
+    LazyProgram<CircleProgram> circle;
+    LazyProgram<FillProgram> fill;
+    LazyProgram<FillPatternProgram> fillPattern;
+    LazyProgram<FillOutlineProgram> fillOutline;
+    LazyProgram<FillOutlinePatternProgram> fillOutlinePattern;
+    LazyProgram<LineProgram> line;
+    LazyProgram<LineSDFProgram> lineSDF;
+    LazyProgram<LinePatternProgram> linePattern;
+    LazyProgram<RasterProgram> raster;
+    LazyProgram<SymbolIconProgram> symbolIcon;
+    LazyProgram<SymbolSDFProgram> symbolIconSDF;
+    LazyProgram<SymbolSDFProgram> symbolGlyph;
+
+    LazyProgram<DebugProgram> debug;
+    LazyProgram<CollisionBoxProgram> collisionBox;
 };
 
 } // namespace mbgl
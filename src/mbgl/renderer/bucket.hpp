@@ -4,6 +4,7 @@
 #include <mbgl/util/noncopyable.hpp>
 
 #include <atomic>
+#include <cstddef>
 
 namespace mbgl {
 
@@ -35,6 +36,9 @@ public:
 
     virtual bool hasData() const = 0;
 
+    // Approximate number of bytes of vertex, index and image data held by this bucket.
+    virtual std::size_t getByteSize() const = 0;
+
     bool needsUpload() const {
         return !uploaded;
     }
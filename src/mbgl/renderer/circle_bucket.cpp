@@ -30,6 +30,10 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::getByteSize() const {
+    return vertices.byteSize() + triangles.byteSize();
+}
+
 void CircleBucket::addGeometry(const GeometryCollection& geometryCollection) {
     constexpr const uint16_t vertexLength = 4;
 
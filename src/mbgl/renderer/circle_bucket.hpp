@@ -18,6 +18,7 @@ public:
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
     bool hasData() const override;
+    std::size_t getByteSize() const override;
     void addGeometry(const GeometryCollection&);
 
     gl::VertexVector<CircleVertex> vertices;
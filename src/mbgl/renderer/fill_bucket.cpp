@@ -111,4 +111,8 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+std::size_t FillBucket::getByteSize() const {
+    return vertices.byteSize() + lines.byteSize() + triangles.byteSize();
+}
+
 } // namespace mbgl
@@ -16,6 +16,7 @@ public:
     void upload(gl::Context&) override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
     bool hasData() const override;
+    std::size_t getByteSize() const override;
 
     void addGeometry(const GeometryCollection&);
 
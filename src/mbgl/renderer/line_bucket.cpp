@@ -451,4 +451,8 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::getByteSize() const {
+    return vertices.byteSize() + triangles.byteSize();
+}
+
 } // namespace mbgl
@@ -8,6 +8,7 @@
 #include <mbgl/map/view.hpp>
 
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/tracing.hpp>
 #include <mbgl/gl/debugging.hpp>
 
 #include <mbgl/style/style.hpp>
@@ -77,7 +78,10 @@ static gl::VertexVector<RasterVertex> rasterVertices() {
     return result;
 }
 
-Painter::Painter(gl::Context& context_, const TransformState& state_, float pixelRatio)
+Painter::Painter(gl::Context& context_,
+                 const TransformState& state_,
+                 float pixelRatio,
+                 const optional<std::string>& programCacheDir)
     : context(context_),
       state(state_),
       tileVertexBuffer(context.createVertexBuffer(tileVertices())),
@@ -91,11 +95,11 @@ Painter::Painter(gl::Context& context_, const TransformState& state_, float pixe
 
     gl::debugging::enable();
 
-    ProgramParameters programParameters{ pixelRatio, false };
+    ProgramParameters programParameters{ pixelRatio, false, programCacheDir };
     programs = std::make_unique<Programs>(context, programParameters);
 #ifndef NDEBUG
     
-    ProgramParameters programParametersOverdraw{ pixelRatio, true };
+    ProgramParameters programParametersOverdraw{ pixelRatio, true, programCacheDir };
     overdrawPrograms = std::make_unique<Programs>(context, programParametersOverdraw);
 #endif
 }
@@ -111,6 +115,20 @@ void Painter::cleanup() {
 }
 
 void Painter::render(const Style& style, const FrameData& frame_, View& view, SpriteAtlas& annotationSpriteAtlas) {
+    tracing::Scope traceFrame("render", "frame");
+
+    const TimePoint frameStart = Clock::now();
+    const gl::Context::Statistics contextStart = context.getStatistics();
+    stats = RenderStats();
+
+    // Measures one phase of the frame, both for `stats` and for the trace.
+    auto phase = [&] (const char* name, Duration& time, auto&& fn) {
+        tracing::Scope tracePhase("render", name);
+        const TimePoint start = Clock::now();
+        fn();
+        time += Clock::now() - start;
+    };
+
     frame = frame_;
     if (frame.contextMode == GLContextMode::Shared) {
         context.setDirtyState();
@@ -147,7 +165,7 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
-    {
+    phase("upload", stats.uploadTime, [&] {
         MBGL_DEBUG_GROUP("upload");
 
         spriteAtlas->upload(context, 0);
@@ -162,12 +180,12 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
                 item.bucket->upload(context);
             }
         }
-    }
+    });
 
     // - CLEAR -------------------------------------------------------------------------------------
     // Renders the backdrop of the OpenGL view. This also paints in areas where we don't have any
     // tiles whatsoever.
-    {
+    phase("clear", stats.clipTime, [&] {
         MBGL_DEBUG_GROUP("clear");
         view.bind();
         context.clear(paintMode() == PaintMode::Overdraw
@@ -175,11 +193,11 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
                         : renderData.backgroundColor,
                       1.0f,
                       0);
-    }
+    });
 
     // - CLIPPING MASKS ----------------------------------------------------------------------------
     // Draws the clipping masks to the stencil buffer.
-    {
+    phase("clip", stats.clipTime, [&] {
         MBGL_DEBUG_GROUP("clip");
 
         // Update all clipping IDs.
@@ -194,7 +212,7 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
             MBGL_DEBUG_GROUP(std::string{ "mask: " } + util::toString(stencil.first));
             renderClippingMask(stencil.first, stencil.second);
         }
-    }
+    });
 
 #if not MBGL_USE_GLES2 and not defined(NDEBUG)
     if (frame.debugOptions & MapDebugOptions::StencilClip) {
@@ -211,23 +229,27 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
     // - OPAQUE PASS -------------------------------------------------------------------------------
     // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
-    renderPass(parameters,
-               RenderPass::Opaque,
-               order.rbegin(), order.rend(),
-               0, 1);
+    phase("opaque", stats.opaqueTime, [&] {
+        renderPass(parameters,
+                   RenderPass::Opaque,
+                   order.rbegin(), order.rend(),
+                   0, 1);
+    });
 
     // - TRANSLUCENT PASS --------------------------------------------------------------------------
     // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
-    renderPass(parameters,
-               RenderPass::Translucent,
-               order.begin(), order.end(),
-               static_cast<uint32_t>(order.size()) - 1, -1);
+    phase("translucent", stats.translucentTime, [&] {
+        renderPass(parameters,
+                   RenderPass::Translucent,
+                   order.begin(), order.end(),
+                   static_cast<uint32_t>(order.size()) - 1, -1);
+    });
 
     if (debug::renderTree) { Log::Info(Event::Render, "}"); indent--; }
 
     // - DEBUG PASS --------------------------------------------------------------------------------
     // Renders debug overlays.
-    {
+    phase("debug", stats.debugTime, [&] {
         MBGL_DEBUG_GROUP("debug");
 
         // Finalize the rendering, e.g. by calling debug render calls per tile.
@@ -237,7 +259,7 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
         for (const auto& source : sources) {
             source->baseImpl->finishRender(*this);
         }
-    }
+    });
 
 #if not MBGL_USE_GLES2 and not defined(NDEBUG)
     if (frame.debugOptions & MapDebugOptions::DepthBuffer) {
@@ -257,6 +279,23 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
         context.vertexArrayObject = 0;
     }
+
+    for (const auto& source : sources) {
+        stats.tilesRendered[source->getID()] += source->baseImpl->getRenderTiles().size();
+    }
+
+    const gl::Context::Statistics& contextEnd = context.getStatistics();
+    stats.drawCalls = contextEnd.drawCalls - contextStart.drawCalls;
+    stats.stateChanges = contextEnd.stateChanges - contextStart.stateChanges;
+    stats.bufferBytesUploaded = contextEnd.bufferBytesUploaded - contextStart.bufferBytesUploaded;
+    stats.textureBytesUploaded = contextEnd.textureBytesUploaded - contextStart.textureBytesUploaded;
+
+    for (const auto type : { gl::BufferType::Vertex, gl::BufferType::Index }) {
+        const auto arena = context.getBufferArenaStatistics(type);
+        stats.bufferBytesAllocated += arena.used;
+        stats.bufferBytesCapacity += arena.capacity;
+    }
+    stats.totalTime = Clock::now() - frameStart;
 }
 
 template <class Iterator>
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/map/render_stats.hpp>
 
 #include <mbgl/tile/tile_id.hpp>
 
@@ -68,7 +69,7 @@ struct FrameData {
 
 class Painter : private util::noncopyable {
 public:
-    Painter(gl::Context&, const TransformState&, float pixelRatio);
+    Painter(gl::Context&, const TransformState&, float pixelRatio, const optional<std::string>& programCacheDir);
     ~Painter();
 
     void render(const style::Style&,
@@ -96,6 +97,11 @@ public:
 
     bool needsAnimation() const;
 
+    // Statistics about the most recent call to `render()`.
+    const RenderStats& getStats() const {
+        return stats;
+    }
+
 private:
     std::vector<RenderItem> determineRenderOrder(const style::Style&);
 
@@ -153,6 +159,8 @@ private:
 
     FrameHistory frameHistory;
 
+    RenderStats stats;
+
     std::unique_ptr<Programs> programs;
 #ifndef NDEBUG
     std::unique_ptr<Programs> overdrawPrograms;
@@ -30,6 +30,15 @@ void Painter::renderSymbol(PaintParameters& parameters,
 
     frameHistory.bind(context, 1);
 
+    // Each icon or glyph is a quad made up of two triangles.
+    auto quadCount = [] (const auto& segments) {
+        std::size_t indices = 0;
+        for (const auto& segment : segments) {
+            indices += segment.indexLength;
+        }
+        return indices / 6;
+    };
+
     auto draw = [&] (auto& program,
                      auto&& uniformValues,
                      const auto& buffers,
@@ -56,6 +65,8 @@ void Painter::renderSymbol(PaintParameters& parameters,
     };
 
     if (bucket.hasIconData()) {
+        stats.iconsRendered += quadCount(bucket.icon.segments);
+
         auto values = layer.impl->iconPropertyValues(layout);
 
         SpriteAtlas& atlas = *layer.impl->spriteAtlas;
@@ -88,6 +99,8 @@ void Painter::renderSymbol(PaintParameters& parameters,
     }
 
     if (bucket.hasTextData()) {
+        stats.glyphsRendered += quadCount(bucket.text.segments);
+
         glyphAtlas->bind(context, 0);
 
         auto values = layer.impl->textPropertyValues(layout);
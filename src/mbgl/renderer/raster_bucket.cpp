@@ -27,4 +27,10 @@ bool RasterBucket::hasData() const {
     return true;
 }
 
+std::size_t RasterBucket::getByteSize() const {
+    // The image is kept after upload, so it is counted alongside its texture.
+    const std::size_t textureBytes = texture ? texture->size.width * texture->size.height * 4 : 0;
+    return image.bytes() + textureBytes;
+}
+
 } // namespace mbgl
@@ -14,6 +14,7 @@ public:
     void upload(gl::Context&) override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
     bool hasData() const override;
+    std::size_t getByteSize() const override;
 
     UnassociatedImage image;
     optional<gl::Texture> texture;
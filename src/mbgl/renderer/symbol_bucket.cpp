@@ -47,6 +47,12 @@ bool SymbolBucket::hasData() const {
     return false;
 }
 
+std::size_t SymbolBucket::getByteSize() const {
+    return text.vertices.byteSize() + text.triangles.byteSize() +
+           icon.vertices.byteSize() + icon.triangles.byteSize() +
+           collisionBox.vertices.byteSize() + collisionBox.lines.byteSize();
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
@@ -0,0 +1,352 @@
+#include <mbgl/style/compiled_filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace mbgl {
+namespace style {
+
+// `in` and `!in` lists with more values than this are looked up in a hash set.
+static constexpr std::size_t maxLinearInValues = 8;
+
+// Whether the filter only checks `$type` or `$id`, which doesn't require a property lookup.
+class IsTypeOrIDFilter {
+public:
+    template <class T>
+    auto operator()(const T& filter) const -> decltype(void(filter.key), bool()) {
+        return filter.key == "$type" || filter.key == "$id";
+    }
+
+    bool operator()(const NullFilter&) const {
+        return true;
+    }
+
+    bool operator()(const AnyFilter&) const {
+        return false;
+    }
+
+    bool operator()(const AllFilter&) const {
+        return false;
+    }
+
+    bool operator()(const NoneFilter&) const {
+        return false;
+    }
+};
+
+class CompiledFilter::Compiler {
+public:
+    CompiledFilter& compiled;
+    const std::unordered_map<std::string, uint32_t>* keysMap;
+
+    void operator()(const NullFilter&) const {
+        emit(Op::True);
+    }
+
+    void operator()(const EqualsFilter& filter) const {
+        comparison(Op::Equals, Op::False, filter.key, filter.value);
+    }
+
+    void operator()(const NotEqualsFilter& filter) const {
+        comparison(Op::NotEquals, Op::True, filter.key, filter.value);
+    }
+
+    void operator()(const LessThanFilter& filter) const {
+        comparison(Op::LessThan, Op::False, filter.key, filter.value);
+    }
+
+    void operator()(const LessThanEqualsFilter& filter) const {
+        comparison(Op::LessThanEquals, Op::False, filter.key, filter.value);
+    }
+
+    void operator()(const GreaterThanFilter& filter) const {
+        comparison(Op::GreaterThan, Op::False, filter.key, filter.value);
+    }
+
+    void operator()(const GreaterThanEqualsFilter& filter) const {
+        comparison(Op::GreaterThanEquals, Op::False, filter.key, filter.value);
+    }
+
+    void operator()(const InFilter& filter) const {
+        membership(Op::In, Op::False, filter.key, filter.values);
+    }
+
+    void operator()(const NotInFilter& filter) const {
+        membership(Op::NotIn, Op::True, filter.key, filter.values);
+    }
+
+    void operator()(const AnyFilter& filter) const {
+        combination(Op::Any, filter.filters);
+    }
+
+    void operator()(const AllFilter& filter) const {
+        combination(Op::All, filter.filters);
+    }
+
+    void operator()(const NoneFilter& filter) const {
+        combination(Op::None, filter.filters);
+    }
+
+    void operator()(const HasFilter& filter) const {
+        Instruction instruction;
+        instruction.op = Op::Has;
+        if (resolve(filter.key, instruction)) {
+            compiled.program.push_back(instruction);
+        } else {
+            emit(Op::False);
+        }
+    }
+
+    void operator()(const NotHasFilter& filter) const {
+        Instruction instruction;
+        instruction.op = Op::NotHas;
+        if (resolve(filter.key, instruction)) {
+            compiled.program.push_back(instruction);
+        } else {
+            emit(Op::True);
+        }
+    }
+
+private:
+    void emit(Op op) const {
+        Instruction instruction;
+        instruction.op = op;
+        compiled.program.push_back(instruction);
+    }
+
+    // Returns false if no feature of the layer can have a value for the key.
+    bool resolve(const std::string& key, Instruction& instruction) const {
+        if (key == "$type") {
+            instruction.key = Key::Type;
+        } else if (key == "$id") {
+            instruction.key = Key::ID;
+        } else if (keysMap) {
+            auto it = keysMap->find(key);
+            if (it == keysMap->end()) {
+                return false;
+            }
+            instruction.key = Key::Indexed;
+            instruction.keyIndex = it->second;
+        } else {
+            instruction.key = Key::Named;
+            instruction.keyIndex = compiled.names.size();
+            compiled.names.push_back(key);
+        }
+        return true;
+    }
+
+    // `missing` is the result of the comparison for features without a value for the key.
+    void comparison(Op op, Op missing, const std::string& key, const Value& value) const {
+        Instruction instruction;
+        instruction.op = op;
+        if (!resolve(key, instruction)) {
+            emit(missing);
+            return;
+        }
+
+        instruction.operand = compiled.values.size();
+        instruction.count = 1;
+        compiled.values.push_back(value);
+        compiled.program.push_back(instruction);
+    }
+
+    void membership(Op op, Op missing, const std::string& key, const std::vector<Value>& list) const {
+        Instruction instruction;
+        instruction.op = op;
+        if (!resolve(key, instruction)) {
+            emit(missing);
+            return;
+        }
+
+        instruction.count = list.size();
+        if (list.size() <= maxLinearInValues) {
+            instruction.operand = compiled.values.size();
+            compiled.values.insert(compiled.values.end(), list.begin(), list.end());
+        } else {
+            instruction.operand = compiled.sets.size();
+            compiled.sets.emplace_back();
+            for (const auto& value : list) {
+                compiled.sets.back().insert(value);
+            }
+        }
+        compiled.program.push_back(instruction);
+    }
+
+    void combination(Op op, const std::vector<Filter>& filters) const {
+        auto& program = compiled.program;
+        const std::size_t start = program.size();
+        emit(op);
+
+        // Evaluate `$type` and `$id` checks first, so that they can short-circuit the
+        // comparatively expensive property lookups.
+        std::vector<std::reference_wrapper<const Filter>> ordered(filters.begin(), filters.end());
+        std::stable_partition(ordered.begin(), ordered.end(), [] (const Filter& filter) {
+            return Filter::visit(filter, IsTypeOrIDFilter());
+        });
+
+        uint32_t count = 0;
+        for (const Filter& filter : ordered) {
+            const std::size_t child = program.size();
+            Filter::visit(filter, *this);
+
+            const Op result = program[child].op;
+            if (result != Op::True && result != Op::False) {
+                ++count;
+                continue;
+            }
+
+            // Constant children don't need to be evaluated. If one decides the outcome of the
+            // whole combination, the combination is constant as well.
+            program.resize(child);
+            const bool value = result == Op::True;
+            if ((op == Op::Any && value) || (op == Op::All && !value) || (op == Op::None && value)) {
+                program.resize(start);
+                emit(op == Op::Any ? Op::True : Op::False);
+                return;
+            }
+        }
+
+        if (count == 0) {
+            program.resize(start);
+            emit(op == Op::Any ? Op::False : Op::True);
+            return;
+        }
+
+        program[start].count = count;
+        program[start].size = program.size() - start;
+    }
+};
+
+void CompiledFilter::ValueSet::insert(const Value& value) {
+    if (value.is<std::string>()) {
+        strings.insert(value.get<std::string>());
+    } else if (value.is<bool>()) {
+        (value.get<bool>() ? hasTrue : hasFalse) = true;
+    } else if (value.is<uint64_t>()) {
+        numbers.insert(double(value.get<uint64_t>()));
+    } else if (value.is<int64_t>()) {
+        numbers.insert(double(value.get<int64_t>()));
+    } else if (value.is<double>()) {
+        numbers.insert(value.get<double>());
+    }
+    // Other values never compare equal; see FilterComparator.
+}
+
+bool CompiledFilter::ValueSet::contains(const Value& value) const {
+    if (value.is<std::string>()) {
+        return strings.count(value.get<std::string>());
+    } else if (value.is<bool>()) {
+        return value.get<bool>() ? hasTrue : hasFalse;
+    } else if (value.is<uint64_t>()) {
+        return numbers.count(double(value.get<uint64_t>()));
+    } else if (value.is<int64_t>()) {
+        return numbers.count(double(value.get<int64_t>()));
+    } else if (value.is<double>()) {
+        return numbers.count(value.get<double>());
+    }
+    return false;
+}
+
+CompiledFilter::CompiledFilter(const Filter& filter, const GeometryTileLayer& layer) {
+    Filter::visit(filter, Compiler { *this, layer.getKeysMap() });
+}
+
+bool CompiledFilter::operator()(const GeometryTileFeature& feature) const {
+    return evaluate(0, feature);
+}
+
+optional<Value> CompiledFilter::getValue(const Instruction& instruction, const GeometryTileFeature& feature) const {
+    switch (instruction.key) {
+    case Key::Type:
+        return optional<Value>(uint64_t(feature.getType()));
+    case Key::ID: {
+        auto id = feature.getID();
+        if (!id) {
+            return optional<Value>();
+        }
+        return FeatureIdentifier::visit(*id, [] (auto id_) {
+            return Value(std::move(id_));
+        });
+    }
+    case Key::Indexed:
+        return feature.getIndexedValue(instruction.keyIndex);
+    case Key::Named:
+        return feature.getValue(names[instruction.keyIndex]);
+    }
+    return optional<Value>();
+}
+
+bool CompiledFilter::contains(const Instruction& instruction, const Value& value) const {
+    if (instruction.count > maxLinearInValues) {
+        return sets[instruction.operand].contains(value);
+    }
+
+    const auto begin = values.begin() + instruction.operand;
+    return std::any_of(begin, begin + instruction.count, [&] (const Value& v) {
+        return filterEqual(value, v);
+    });
+}
+
+bool CompiledFilter::evaluate(std::size_t pc, const GeometryTileFeature& feature) const {
+    const Instruction& instruction = program[pc];
+
+    switch (instruction.op) {
+    case Op::True:
+        return true;
+    case Op::False:
+        return false;
+    case Op::Any:
+    case Op::All:
+    case Op::None: {
+        std::size_t child = pc + 1;
+        for (uint32_t i = 0; i < instruction.count; ++i) {
+            const bool result = evaluate(child, feature);
+            if (instruction.op == Op::Any && result) {
+                return true;
+            } else if (instruction.op == Op::All && !result) {
+                return false;
+            } else if (instruction.op == Op::None && result) {
+                return false;
+            }
+            child += program[child].size;
+        }
+        return instruction.op != Op::Any;
+    }
+    default:
+        break;
+    }
+
+    const optional<Value> actual = getValue(instruction, feature);
+
+    switch (instruction.op) {
+    case Op::Equals:
+        return actual && filterEqual(*actual, values[instruction.operand]);
+    case Op::NotEquals:
+        return !actual || !filterEqual(*actual, values[instruction.operand]);
+    case Op::LessThan:
+        return actual && filterCompare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ < rhs_; });
+    case Op::LessThanEquals:
+        return actual && filterCompare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ <= rhs_; });
+    case Op::GreaterThan:
+        return actual && filterCompare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ > rhs_; });
+    case Op::GreaterThanEquals:
+        return actual && filterCompare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ >= rhs_; });
+    case Op::In:
+        return actual && contains(instruction, *actual);
+    case Op::NotIn:
+        return !actual || !contains(instruction, *actual);
+    case Op::Has:
+        return bool(actual);
+    case Op::NotHas:
+        return !actual;
+    default:
+        assert(false);
+        return false;
+    }
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace mbgl {
+
+class GeometryTileLayer;
+class GeometryTileFeature;
+
+namespace style {
+
+/*
+   A `Filter` compiled for evaluating it against the features of a single tile layer.
+
+   The filter tree is flattened into a program in prefix order. Property keys are resolved
+   once against the layer's interned key table (if it has one), so evaluation doesn't hash
+   key strings, and checks for keys that don't occur in the layer are folded into constants.
+   Within `any`, `all` and `none`, the cheap `$type` and `$id` checks run before property
+   checks, and large `in` and `!in` lists are looked up in hash sets.
+
+   Evaluating a compiled filter yields the same result as `Filter::operator()`.
+*/
+class CompiledFilter {
+public:
+    CompiledFilter(const Filter&, const GeometryTileLayer&);
+
+    bool operator()(const GeometryTileFeature&) const;
+
+private:
+    enum class Op : uint8_t {
+        True,
+        False,
+        Equals,
+        NotEquals,
+        LessThan,
+        LessThanEquals,
+        GreaterThan,
+        GreaterThanEquals,
+        In,
+        NotIn,
+        Has,
+        NotHas,
+        Any,
+        All,
+        None,
+    };
+
+    enum class Key : uint8_t {
+        Type,
+        ID,
+        Indexed, // `keyIndex` refers to the layer's key table
+        Named,   // `keyIndex` refers to `names`
+    };
+
+    class Instruction {
+    public:
+        Op op = Op::True;
+        Key key = Key::Named;
+        uint32_t keyIndex = 0;
+
+        // For comparisons and small `in`/`!in` lists, the range of operands in `values`; for
+        // large `in`/`!in` lists, the index into `sets`; for `any`/`all`/`none`, the number
+        // of child filters (with `operand` unused).
+        uint32_t operand = 0;
+        uint32_t count = 0;
+
+        // Number of instructions in the subtree rooted at this instruction.
+        uint32_t size = 1;
+    };
+
+    class ValueSet {
+    public:
+        void insert(const Value&);
+        bool contains(const Value&) const;
+
+    private:
+        std::unordered_set<std::string> strings;
+        std::unordered_set<double> numbers;
+        bool hasTrue = false;
+        bool hasFalse = false;
+    };
+
+    class Compiler;
+
+    bool evaluate(std::size_t pc, const GeometryTileFeature&) const;
+    optional<Value> getValue(const Instruction&, const GeometryTileFeature&) const;
+    bool contains(const Instruction&, const Value&) const;
+
+    std::vector<Instruction> program;
+    std::vector<std::string> names;
+    std::vector<Value> values;
+    std::vector<ValueSet> sets;
+};
+
+} // namespace style
+} // namespace mbgl
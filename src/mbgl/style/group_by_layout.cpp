@@ -32,7 +32,7 @@ std::string layoutKey(const Layer& layer) {
     return s.GetString();
 }
 
-std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>& layers) {
+std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::shared_ptr<const Layer>>& layers) {
     std::unordered_map<std::string, std::vector<const Layer*>> map;
     for (auto& layer : layers) {
         map[layoutKey(*layer)].push_back(layer.get());
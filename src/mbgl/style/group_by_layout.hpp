@@ -8,7 +8,7 @@ namespace style {
 
 class Layer;
 
-std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
+std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::shared_ptr<const Layer>>&);
 
 } // namespace style
 } // namespace mbgl
@@ -29,16 +29,22 @@ float Layer::getMinZoom() const {
     return baseImpl->minZoom;
 }
 
-void Layer::setMinZoom(float minZoom) const {
+void Layer::setMinZoom(float minZoom) {
+    if (minZoom == getMinZoom())
+        return;
     baseImpl->minZoom = minZoom;
+    baseImpl->observer->onLayerVisibilityChanged(*this);
 }
 
 float Layer::getMaxZoom() const {
     return baseImpl->maxZoom;
 }
 
-void Layer::setMaxZoom(float maxZoom) const {
+void Layer::setMaxZoom(float maxZoom) {
+    if (maxZoom == getMaxZoom())
+        return;
     baseImpl->maxZoom = maxZoom;
+    baseImpl->observer->onLayerVisibilityChanged(*this);
 }
 
 } // namespace style
@@ -42,7 +42,11 @@ const std::string& FillLayer::getSourceID() const {
 }
 
 void FillLayer::setSourceLayer(const std::string& sourceLayer) {
+    if (sourceLayer == getSourceLayer())
+        return;
     impl->sourceLayer = sourceLayer;
+    // Selects different features, just like a new filter does.
+    impl->observer->onLayerFilterChanged(*this);
 }
 
 const std::string& FillLayer::getSourceLayer() const {
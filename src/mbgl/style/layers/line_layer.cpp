@@ -43,7 +43,11 @@ const std::string& LineLayer::getSourceID() const {
 }
 
 void LineLayer::setSourceLayer(const std::string& sourceLayer) {
+    if (sourceLayer == getSourceLayer())
+        return;
     impl->sourceLayer = sourceLayer;
+    // Selects different features, just like a new filter does.
+    impl->observer->onLayerFilterChanged(*this);
 }
 
 const std::string& LineLayer::getSourceLayer() const {
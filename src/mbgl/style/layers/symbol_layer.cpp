@@ -43,7 +43,11 @@ const std::string& SymbolLayer::getSourceID() const {
 }
 
 void SymbolLayer::setSourceLayer(const std::string& sourceLayer) {
+    if (sourceLayer == getSourceLayer())
+        return;
     impl->sourceLayer = sourceLayer;
+    // Selects different features, just like a new filter does.
+    impl->observer->onLayerFilterChanged(*this);
 }
 
 const std::string& SymbolLayer::getSourceLayer() const {
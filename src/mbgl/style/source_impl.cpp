@@ -154,8 +154,11 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
                                    parameters.transformState.getPitch(),
                                    parameters.debugOptions & MapDebugOptions::Collision };
 
+    const LatLng center = parameters.transformState.getLatLng();
+
     for (auto& pair : tiles) {
         pair.second->setPlacementConfig(config);
+        pair.second->setViewportCenter(center);
     }
 }
 
@@ -256,6 +259,10 @@ void Source::Impl::setCacheSize(size_t size) {
     cache.setSize(size);
 }
 
+void Source::Impl::setCacheBudget(size_t budget) {
+    cache.setBudget(budget);
+}
+
 void Source::Impl::onLowMemory() {
     cache.clear();
 }
@@ -22,6 +22,7 @@ namespace mbgl {
 
 class Painter;
 class FileSource;
+class Scheduler;
 class TransformState;
 class RenderTile;
 
@@ -40,7 +41,7 @@ public:
     Impl(SourceType, std::string id, Source&);
     ~Impl() override;
 
-    virtual void loadDescription(FileSource&) = 0;
+    virtual void loadDescription(FileSource&, Scheduler&) = 0;
     bool isLoaded() const;
 
     // Called when the camera has changed. May load new tiles, unload obsolete tiles, or
@@ -69,6 +70,8 @@ public:
     queryRenderedFeatures(const QueryParameters&) const;
 
     void setCacheSize(size_t);
+    void setCacheBudget(size_t);
+    size_t getCacheBudget() const { return cache.getBudget(); }
     void onLowMemory();
 
     void setObserver(SourceObserver*);
@@ -0,0 +1,174 @@
+#include <mbgl/style/sources/geojson_reader.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <mapbox/geojson/rapidjson.hpp>
+
+#include <rapidjson/reader.h>
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+// A SAX handler that builds up values the way `JSDocument` does, except for the elements of
+// the top-level `features` array: each of them is converted to a feature as soon as it's
+// complete, and then dropped.
+class GeoJSONHandler {
+public:
+    GeoJSONHandler(const std::atomic<bool>* cancelled_)
+        : cancelled(cancelled_) {
+    }
+
+    bool Null() { return add(JSValue()); }
+    bool Bool(bool b) { return add(JSValue(b)); }
+    bool Int(int i) { return add(JSValue(i)); }
+    bool Uint(unsigned u) { return add(JSValue(u)); }
+    bool Int64(int64_t i) { return add(JSValue(i)); }
+    bool Uint64(uint64_t u) { return add(JSValue(u)); }
+    bool Double(double d) { return add(JSValue(d)); }
+
+    bool RawNumber(const char*, rapidjson::SizeType, bool) {
+        // Only reported with kParseNumbersAsStringsFlag.
+        return false;
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+        return add(JSValue(str, length, allocator));
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        if (isCancelled()) {
+            return false;
+        }
+        if (depth == 1) {
+            featuresKey = length == 8 && std::strncmp(str, "features", 8) == 0;
+        }
+        stack.emplace_back(str, length, allocator);
+        return true;
+    }
+
+    bool StartObject() {
+        ++depth;
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType memberCount) {
+        --depth;
+        JSValue object(rapidjson::kObjectType);
+        const auto begin = stack.end() - 2 * memberCount;
+        for (auto it = begin; it != stack.end(); it += 2) {
+            object.AddMember(*it, *(it + 1), allocator);
+        }
+        stack.erase(begin, stack.end());
+        return add(std::move(object));
+    }
+
+    bool StartArray() {
+        ++depth;
+        if (depth == 2 && featuresKey) {
+            streaming = true;
+        }
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType elementCount) {
+        --depth;
+        if (streaming && depth == 1) {
+            // Its elements were all taken out already; leave an empty array in their place.
+            streaming = false;
+            return add(JSValue(rapidjson::kArrayType));
+        }
+        JSValue array(rapidjson::kArrayType);
+        array.Reserve(elementCount, allocator);
+        const auto begin = stack.end() - elementCount;
+        for (auto it = begin; it != stack.end(); ++it) {
+            array.PushBack(*it, allocator);
+        }
+        stack.erase(begin, stack.end());
+        return add(std::move(array));
+    }
+
+    bool isCancelled() const {
+        return cancelled && cancelled->load(std::memory_order_relaxed);
+    }
+
+    conversion::Result<GeoJSON> finish() {
+        if (error) {
+            return *error;
+        }
+
+        assert(stack.size() == 1);
+        try {
+            GeoJSON geoJSON = mapbox::geojson::convert(stack.back());
+            if (geoJSON.is<FeatureCollection>()) {
+                // Only now do we know that the features really belonged to a FeatureCollection,
+                // rather than being a foreign member of some other object.
+                return GeoJSON { std::move(features) };
+            }
+            return geoJSON;
+        } catch (const std::exception& ex) {
+            return conversion::Error { ex.what() };
+        }
+    }
+
+private:
+    bool add(JSValue&& value) {
+        if (isCancelled()) {
+            return false;
+        }
+        if (streaming && depth == 2) {
+            // Keep reading after a conversion error, so that syntax errors further on are still
+            // reported first, as they would be when parsing into a document.
+            if (!error) {
+                try {
+                    features.push_back(mapbox::geojson::convert<mapbox::geojson::feature>(value));
+                } catch (const std::exception& ex) {
+                    error = conversion::Error { ex.what() };
+                    features.clear();
+                }
+            }
+            return true;
+        }
+        stack.push_back(std::move(value));
+        return true;
+    }
+
+    const std::atomic<bool>* const cancelled;
+    rapidjson::CrtAllocator allocator;
+    std::vector<JSValue> stack;
+    std::size_t depth = 0;
+    bool featuresKey = false;
+    bool streaming = false;
+    FeatureCollection features;
+    optional<conversion::Error> error;
+};
+
+} // namespace
+
+conversion::Result<GeoJSON> readGeoJSON(const std::string& text, const std::atomic<bool>* cancelled) {
+    GeoJSONHandler handler(cancelled);
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(text.c_str());
+
+    if (!reader.Parse<0>(stream, handler)) {
+        if (handler.isCancelled()) {
+            return conversion::Error { "cancelled" };
+        }
+        std::stringstream message;
+        message << reader.GetErrorOffset() << " - "
+                << rapidjson::GetParseError_En(reader.GetParseErrorCode());
+        throw std::runtime_error(message.str());
+    }
+
+    return handler.finish();
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/util/geojson.hpp>
+
+#include <atomic>
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+/*
+    Reads GeoJSON text without building a document for all of it first. The members
+    of a FeatureCollection's `features` array are converted one at a time as soon as
+    the parser has read them, so besides the text itself, only the converted features
+    and the JSON of a single feature are held in memory at any point.
+
+    Throws `std::runtime_error` if the text isn't valid JSON, and returns an `Error` if
+    it's JSON but not valid GeoJSON, mirroring what parsing into a document and then
+    calling `convertGeoJSON` reports.
+
+    When `cancelled` is given and becomes true, reading stops early and the result must
+    be ignored.
+*/
+conversion::Result<GeoJSON> readGeoJSON(const std::string&, const std::atomic<bool>* cancelled = nullptr);
+
+} // namespace style
+} // namespace mbgl
@@ -1,21 +1,18 @@
-#include <mbgl/util/logging.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/sources/geojson_source_worker.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/run_loop.hpp>
 
 #include <mapbox/geojson.hpp>
 #include <mapbox/geojson/rapidjson.hpp>
 #include <mapbox/geojsonvt.hpp>
-#include <mapbox/geojsonvt/convert.hpp>
 #include <supercluster.hpp>
 
-#include <rapidjson/error/en.h>
-
-#include <sstream>
-
 namespace mbgl {
 namespace style {
 namespace conversion {
@@ -34,7 +31,14 @@ GeoJSONSource::Impl::Impl(std::string id_, Source& base_, const GeoJSONOptions o
     : Source::Impl(SourceType::GeoJSON, std::move(id_), base_), options(options_) {
 }
 
-GeoJSONSource::Impl::~Impl() = default;
+GeoJSONSource::Impl::~Impl() {
+    // Destroying the worker waits for the message it is processing; make a parse in
+    // progress give up instead of finishing first.
+    if (workerCancelled) {
+        *workerCancelled = true;
+    }
+    worker.reset();
+}
 
 void GeoJSONSource::Impl::setURL(std::string url_) {
     url = std::move(url_);
@@ -43,6 +47,7 @@ void GeoJSONSource::Impl::setURL(std::string url_) {
     if (loaded || req) {
         loaded = false;
         req.reset();
+        ++correlationID;
         observer->onSourceDescriptionChanged(base);
     }
 }
@@ -54,34 +59,15 @@ optional<std::string> GeoJSONSource::Impl::getURL() const {
 
 void GeoJSONSource::Impl::setGeoJSON(const GeoJSON& geoJSON) {
     req.reset();
-    _setGeoJSON(geoJSON);
+    ++correlationID;
+    setIndex(GeoJSONSourceWorker::index(geoJSON, options));
 }
 
 //Private implementation
-void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
-    double scale = util::EXTENT / util::tileSize;
-
+void GeoJSONSource::Impl::setIndex(variant<GeoJSONVTPointer, SuperclusterPointer> index) {
     cache.clear();
 
-    if (options.cluster
-        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
-        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
-        clusterOptions.maxZoom = options.clusterMaxZoom;
-        clusterOptions.extent = util::EXTENT;
-        clusterOptions.radius = std::round(scale * options.clusterRadius);
-
-        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
-        geoJSONOrSupercluster =
-            std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
-    } else {
-        mapbox::geojsonvt::Options vtOptions;
-        vtOptions.maxZoom = options.maxzoom;
-        vtOptions.extent = util::EXTENT;
-        vtOptions.buffer = std::round(scale * options.buffer);
-        vtOptions.tolerance = scale * options.tolerance;
-        geoJSONOrSupercluster = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
-    }
+    geoJSONOrSupercluster = std::move(index);
 
     for (auto const &item : tiles) {
         GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
@@ -102,7 +88,7 @@ void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID&
     }
 }
 
-void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
+void GeoJSONSource::Impl::loadDescription(FileSource& fileSource, Scheduler& scheduler) {
     if (!url) {
         loaded = true;
         return;
@@ -112,6 +98,13 @@ void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
         return;
     }
 
+    if (!worker) {
+        mailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
+        workerCancelled = std::make_shared<std::atomic<bool>>(false);
+        worker = std::make_unique<Actor<GeoJSONSourceWorker>>(
+            scheduler, ActorRef<GeoJSONSource::Impl>(*this, mailbox), options, workerCancelled);
+    }
+
     req = fileSource.request(Resource::source(*url), [this](Response res) {
         if (res.error) {
             observer->onSourceError(
@@ -122,37 +115,34 @@ void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
             observer->onSourceError(
                 base, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
-            rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> d;
-            d.Parse<0>(res.data->c_str());
-
-            if (d.HasParseError()) {
-                std::stringstream message;
-                message << d.GetErrorOffset() << " - "
-                        << rapidjson::GetParseError_En(d.GetParseError());
-                observer->onSourceError(base,
-                                        std::make_exception_ptr(std::runtime_error(message.str())));
-                return;
-            }
-
-            invalidateTiles();
-
-            conversion::Result<GeoJSON> geoJSON = conversion::convertGeoJSON<JSValue>(d);
-            if (!geoJSON) {
-                Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
-                           geoJSON.error().message.c_str());
-                // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
-                // tiles to load.
-                _setGeoJSON(GeoJSON{ FeatureCollection{} });
-            } else {
-                _setGeoJSON(*geoJSON);
-            }
-
-            loaded = true;
-            observer->onSourceLoaded(base);
+            // Parsing and indexing a large file takes a while; keep showing the current data
+            // (if any) until the worker is done.
+            worker->invoke(&GeoJSONSourceWorker::parse, std::string(*res.data), ++correlationID);
         }
     });
 }
 
+void GeoJSONSource::Impl::onParsed(variant<GeoJSONVTPointer, SuperclusterPointer> index,
+                                   uint64_t resultCorrelationID) {
+    if (resultCorrelationID != correlationID) {
+        return;
+    }
+
+    invalidateTiles();
+    setIndex(std::move(index));
+
+    loaded = true;
+    observer->onSourceLoaded(base);
+}
+
+void GeoJSONSource::Impl::onParseError(std::exception_ptr error, uint64_t resultCorrelationID) {
+    if (resultCorrelationID != correlationID) {
+        return;
+    }
+
+    observer->onSourceError(base, error);
+}
+
 Range<uint8_t> GeoJSONSource::Impl::getZoomRange() {
     assert(loaded);
     return { 0, options.maxzoom };
@@ -5,12 +5,20 @@
 #include <mbgl/util/variant.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 
+#include <atomic>
+#include <exception>
+#include <memory>
+
 namespace mbgl {
 
 class AsyncRequest;
+class Mailbox;
+template <class> class Actor;
 
 namespace style {
 
+class GeoJSONSourceWorker;
+
 class GeoJSONSource::Impl : public Source::Impl {
 public:
     Impl(std::string id, Source&, const GeoJSONOptions);
@@ -22,14 +30,17 @@ public:
     void setGeoJSON(const GeoJSON&);
     void setTileData(GeoJSONTile&, const OverscaledTileID& tileID);
 
-    void loadDescription(FileSource&) final;
+    void loadDescription(FileSource&, Scheduler&) final;
+
+    void onParsed(variant<GeoJSONVTPointer, SuperclusterPointer>, uint64_t correlationID);
+    void onParseError(std::exception_ptr, uint64_t correlationID);
 
     uint16_t getTileSize() const final {
         return util::tileSize;
     }
 
 private:
-    void _setGeoJSON(const GeoJSON&);
+    void setIndex(variant<GeoJSONVTPointer, SuperclusterPointer>);
 
     Range<uint8_t> getZoomRange() final;
     std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) final;
@@ -38,6 +49,13 @@ private:
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
     variant<GeoJSONVTPointer, SuperclusterPointer> geoJSONOrSupercluster;
+
+    // Data loaded from the URL is parsed and indexed by the worker, which is created with the
+    // first request. Results that arrive after the data was replaced are dropped.
+    std::shared_ptr<Mailbox> mailbox;
+    std::shared_ptr<std::atomic<bool>> workerCancelled;
+    std::unique_ptr<Actor<GeoJSONSourceWorker>> worker;
+    uint64_t correlationID = 0;
 };
 
 } // namespace style
@@ -0,0 +1,76 @@
+#include <mbgl/style/sources/geojson_source_worker.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/sources/geojson_reader.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <mapbox/geojsonvt.hpp>
+#include <supercluster.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+namespace style {
+
+GeoJSONSourceWorker::GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>,
+                                         ActorRef<GeoJSONSource::Impl> parent_,
+                                         GeoJSONOptions options_,
+                                         std::shared_ptr<const std::atomic<bool>> cancelled_)
+    : parent(std::move(parent_)),
+      options(std::move(options_)),
+      cancelled(std::move(cancelled_)) {
+}
+
+void GeoJSONSourceWorker::parse(std::string data, uint64_t correlationID) {
+    try {
+        conversion::Result<GeoJSON> geoJSON = readGeoJSON(data, cancelled.get());
+
+        // The text isn't needed anymore; let go of it before indexing.
+        std::string().swap(data);
+
+        if (*cancelled) {
+            return;
+        }
+
+        if (!geoJSON) {
+            Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
+                       geoJSON.error().message.c_str());
+            // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
+            // tiles to load.
+            parent.invoke(&GeoJSONSource::Impl::onParsed, index(GeoJSON{ FeatureCollection{} }, options), correlationID);
+        } else {
+            parent.invoke(&GeoJSONSource::Impl::onParsed, index(*geoJSON, options), correlationID);
+        }
+    } catch (...) {
+        if (!*cancelled) {
+            parent.invoke(&GeoJSONSource::Impl::onParseError, std::current_exception(), correlationID);
+        }
+    }
+}
+
+variant<GeoJSONVTPointer, SuperclusterPointer> GeoJSONSourceWorker::index(const GeoJSON& geoJSON,
+                                                                          const GeoJSONOptions& options_) {
+    double scale = util::EXTENT / util::tileSize;
+
+    if (options_.cluster
+        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
+        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
+        mapbox::supercluster::Options clusterOptions;
+        clusterOptions.maxZoom = options_.clusterMaxZoom;
+        clusterOptions.extent = util::EXTENT;
+        clusterOptions.radius = std::round(scale * options_.clusterRadius);
+
+        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
+        return std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+    } else {
+        mapbox::geojsonvt::Options vtOptions;
+        vtOptions.maxZoom = options_.maxzoom;
+        vtOptions.extent = util::EXTENT;
+        vtOptions.buffer = std::round(scale * options_.buffer);
+        vtOptions.tolerance = scale * options_.tolerance;
+        return std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
+    }
+}
+
+} // namespace style
+} // namespace mbgl
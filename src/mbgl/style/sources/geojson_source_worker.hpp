@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/variant.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+// Parses and indexes GeoJSON loaded from a URL off the main thread, and hands the resulting
+// index back to the source. The source sets `cancelled` before it destroys the worker, so that
+// it doesn't have to wait for a large file to be parsed.
+class GeoJSONSourceWorker {
+public:
+    GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker> self,
+                        ActorRef<GeoJSONSource::Impl> parent,
+                        GeoJSONOptions,
+                        std::shared_ptr<const std::atomic<bool>> cancelled);
+
+    void parse(std::string, uint64_t correlationID);
+
+    // Builds the geojson-vt or supercluster index for the given data. Also used directly by
+    // the source for data that is set already parsed.
+    static variant<GeoJSONVTPointer, SuperclusterPointer> index(const GeoJSON&, const GeoJSONOptions&);
+
+private:
+    ActorRef<GeoJSONSource::Impl> parent;
+    const GeoJSONOptions options;
+    const std::shared_ptr<const std::atomic<bool>> cancelled;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -39,8 +39,9 @@ namespace style {
 
 static Observer nullObserver;
 
-Style::Style(FileSource& fileSource_, float pixelRatio)
-    : fileSource(fileSource_),
+Style::Style(Scheduler& scheduler_, FileSource& fileSource_, float pixelRatio)
+    : scheduler(scheduler_),
+      fileSource(fileSource_),
       glyphAtlas(std::make_unique<GlyphAtlas>(Size{ 2048, 2048 }, fileSource)),
       spriteAtlas(std::make_unique<SpriteAtlas>(Size{ 1024, 1024 }, pixelRatio)),
       lineAtlas(std::make_unique<LineAtlas>(Size{ 256, 512 })),
@@ -102,6 +103,8 @@ TransitionOptions Style::getTransitionOptions() const {
 void Style::setJSON(const std::string& json) {
     sources.clear();
     layers.clear();
+    layerSnapshots.clear();
+    layerSnapshot.reset();
     classes.clear();
     transitionOptions = {};
     updateBatch = {};
@@ -150,6 +153,7 @@ void Style::addSource(std::unique_ptr<Source> source) {
     }
 
     source->baseImpl->setObserver(this);
+    source->baseImpl->setCacheBudget(sourceCacheBudget);
     sources.emplace_back(std::move(source));
 }
 
@@ -221,6 +225,7 @@ Layer* Style::addLayer(std::unique_ptr<Layer> layer, optional<std::string> befor
     }
 
     layer->baseImpl->setObserver(this);
+    invalidateLayerSnapshot(layer->getID());
 
     return layers.emplace(before ? findLayer(*before) : layers.end(), std::move(layer))->get();
 }
@@ -240,9 +245,35 @@ std::unique_ptr<Layer> Style::removeLayer(const std::string& id) {
     }
 
     layers.erase(it);
+    layerSnapshots.erase(id);
+    layerSnapshot.reset();
     return layer;
 }
 
+std::shared_ptr<const Style::LayerSnapshot> Style::getLayerSnapshot() {
+    if (layerSnapshot) {
+        return layerSnapshot;
+    }
+
+    auto snapshot = std::make_shared<LayerSnapshot>();
+    snapshot->reserve(layers.size());
+    for (const auto& layer : layers) {
+        auto& copy = layerSnapshots[layer->getID()];
+        if (!copy) {
+            copy = layer->baseImpl->clone();
+        }
+        snapshot->push_back(copy);
+    }
+
+    layerSnapshot = std::move(snapshot);
+    return layerSnapshot;
+}
+
+void Style::invalidateLayerSnapshot(const std::string& id) {
+    layerSnapshots.erase(id);
+    layerSnapshot.reset();
+}
+
 std::string Style::getName() const {
     return name;
 }
@@ -341,7 +372,7 @@ void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
         if (Source* source = getSource(layer->baseImpl->source)) {
             source->baseImpl->enabled = true;
             if (!source->baseImpl->loaded) {
-                source->baseImpl->loadDescription(fileSource);
+                source->baseImpl->loadDescription(fileSource, scheduler);
             }
         }
     }
@@ -560,6 +591,13 @@ void Style::setSourceTileCacheSize(size_t size) {
     }
 }
 
+void Style::setSourceTileCacheBudget(size_t budget) {
+    sourceCacheBudget = budget;
+    for (const auto& source : sources) {
+        source->baseImpl->setCacheBudget(budget);
+    }
+}
+
 void Style::onLowMemory() {
     for (const auto& source : sources) {
         source->baseImpl->onLowMemory();
@@ -603,7 +641,7 @@ void Style::onSourceError(Source& source, std::exception_ptr error) {
 void Style::onSourceDescriptionChanged(Source& source) {
     observer->onSourceDescriptionChanged(source);
     if (!source.baseImpl->loaded) {
-        source.baseImpl->loadDescription(fileSource);
+        source.baseImpl->loadDescription(fileSource, scheduler);
     }
 }
 
@@ -649,11 +687,13 @@ struct QueueSourceReloadVisitor {
 };
 
 void Style::onLayerFilterChanged(Layer& layer) {
+    invalidateLayerSnapshot(layer.getID());
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::Layout);
 }
 
 void Style::onLayerVisibilityChanged(Layer& layer) {
+    invalidateLayerSnapshot(layer.getID());
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::RecalculateStyle | Update::Layout);
 }
@@ -663,6 +703,7 @@ void Style::onLayerPaintPropertyChanged(Layer&) {
 }
 
 void Style::onLayerLayoutPropertyChanged(Layer& layer, const char * property) {
+    invalidateLayerSnapshot(layer.getID());
     layer.accept(QueueSourceReloadVisitor { updateBatch });
 
     auto update = Update::Layout;
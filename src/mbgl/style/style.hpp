@@ -11,6 +11,7 @@
 #include <mbgl/map/zoom_history.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/feature.hpp>
@@ -19,11 +20,13 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
 
 class FileSource;
+class Scheduler;
 class GlyphAtlas;
 class SpriteAtlas;
 class LineAtlas;
@@ -41,7 +44,7 @@ class Style : public GlyphAtlasObserver,
               public LayerObserver,
               public util::noncopyable {
 public:
-    Style(FileSource&, float pixelRatio);
+    Style(Scheduler&, FileSource&, float pixelRatio);
     ~Style() override;
 
     void setJSON(const std::string&);
@@ -77,6 +80,12 @@ public:
                     optional<std::string> beforeLayerID = {});
     std::unique_ptr<Layer> removeLayer(const std::string& layerID);
 
+    // An immutable copy of the current layers, in style order, for use by tile workers.
+    // The snapshot is rebuilt lazily after a layer is added, removed, or changed in a way
+    // that affects layout; unchanged layers are shared between successive snapshots.
+    using LayerSnapshot = std::vector<std::shared_ptr<const Layer>>;
+    std::shared_ptr<const LayerSnapshot> getLayerSnapshot();
+
     std::string getName() const;
     LatLng getDefaultLatLng() const;
     double getDefaultZoom() const;
@@ -100,10 +109,12 @@ public:
     float getQueryRadius() const;
 
     void setSourceTileCacheSize(size_t);
+    void setSourceTileCacheBudget(size_t);
     void onLowMemory();
 
     void dumpDebugLogs() const;
 
+    Scheduler& scheduler;
     FileSource& fileSource;
     std::unique_ptr<GlyphAtlas> glyphAtlas;
     std::unique_ptr<SpriteAtlas> spriteAtlas;
@@ -112,9 +123,14 @@ public:
 private:
     std::vector<std::unique_ptr<Source>> sources;
     std::vector<std::unique_ptr<Layer>> layers;
+    std::unordered_map<std::string, std::shared_ptr<const Layer>> layerSnapshots;
+    std::shared_ptr<const LayerSnapshot> layerSnapshot;
     std::vector<std::string> classes;
     TransitionOptions transitionOptions;
 
+    // Applied to every source, including ones added after it was set.
+    size_t sourceCacheBudget = util::DEFAULT_TILE_CACHE_BUDGET;
+
     // Defaults
     std::string name;
     LatLng defaultLatLng;
@@ -124,6 +140,7 @@ private:
 
     std::vector<std::unique_ptr<Layer>>::const_iterator findLayer(const std::string& layerID) const;
     void reloadLayerSource(Layer&);
+    void invalidateLayerSnapshot(const std::string& layerID);
     void updateSymbolDependentTiles();
 
     // GlyphStoreObserver implementation.
@@ -0,0 +1,34 @@
+#include <mbgl/text/collision_grid.hpp>
+
+namespace mbgl {
+
+constexpr uint32_t CollisionGrid::none;
+
+CollisionGrid::CollisionGrid(const BBox& bounds, float cellSize)
+    : origin(bounds.min),
+      scale(1.0f / cellSize),
+      columns(util::max(1.0f, std::ceil((bounds.max.x - bounds.min.x) / cellSize))),
+      rows(util::max(1.0f, std::ceil((bounds.max.y - bounds.min.y) / cellSize))),
+      cells(columns * rows, none) {
+}
+
+void CollisionGrid::insert(const CollisionBox& box, const BBox& bbox, uint32_t feature) {
+    const auto element = uint32_t(boxes.size());
+    boxes.push_back({ box, feature });
+    bboxes.push_back(bbox);
+
+    const int32_t cx1 = cellX(bbox.min.x);
+    const int32_t cy1 = cellY(bbox.min.y);
+    const int32_t cx2 = cellX(bbox.max.x);
+    const int32_t cy2 = cellY(bbox.max.y);
+
+    for (int32_t y = cy1; y <= cy2; ++y) {
+        for (int32_t x = cx1; x <= cx2; ++x) {
+            uint32_t& head = cells[y * columns + x];
+            links.push_back({ element, head });
+            head = uint32_t(links.size() - 1);
+        }
+    }
+}
+
+} // namespace mbgl
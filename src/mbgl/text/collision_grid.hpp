@@ -0,0 +1,126 @@
+#pragma once
+
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/math/minmax.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mbgl {
+
+// A uniform grid holding the collision boxes of the features placed in a tile, similar to
+// GridIndex but with float coordinates and a collision box and feature per element. Elements
+// outside of the grid's bounds are kept in the outermost cells.
+//
+// Everything is stored in flat arrays: the boxes, their bounding boxes and their features
+// each in a vector indexed by element, and the cells as singly linked lists of elements
+// threaded through a single vector, so that inserting doesn't allocate per cell.
+class CollisionGrid {
+public:
+    using BBox = mapbox::geometry::box<float>;
+
+    // Covers `bounds` with square cells of `cellSize`.
+    CollisionGrid(const BBox& bounds, float cellSize);
+
+    // Inserts all boxes of a feature, with the bounding boxes returned by `getBBox(box)`.
+    template <class GetBBox>
+    void insert(const CollisionFeature& feature, GetBBox&& getBBox) {
+        const auto featureIndex = uint32_t(features.size());
+        features.push_back(feature.indexedFeature);
+
+        boxes.reserve(boxes.size() + feature.boxes.size());
+        bboxes.reserve(bboxes.size() + feature.boxes.size());
+        for (const auto& box : feature.boxes) {
+            insert(box, getBBox(box), featureIndex);
+        }
+    }
+
+    // Calls `fn(box, feature)` once for every box whose bounding box intersects `queryBBox`,
+    // until it returns false. Returns whether every box was visited.
+    template <class Fn>
+    bool query(const BBox& queryBBox, Fn&& fn) const {
+        const int32_t qx1 = cellX(queryBBox.min.x);
+        const int32_t qy1 = cellY(queryBBox.min.y);
+        const int32_t qx2 = cellX(queryBBox.max.x);
+        const int32_t qy2 = cellY(queryBBox.max.y);
+
+        for (int32_t y = qy1; y <= qy2; ++y) {
+            for (int32_t x = qx1; x <= qx2; ++x) {
+                for (uint32_t link = cells[y * columns + x]; link != none; link = links[link].next) {
+                    const uint32_t i = links[link].element;
+                    const BBox& bbox = bboxes[i];
+
+                    // A box is listed in every cell it covers. Only look at it in the first
+                    // of those that the query covers too.
+                    if (util::max(cellX(bbox.min.x), qx1) != x || util::max(cellY(bbox.min.y), qy1) != y) {
+                        continue;
+                    }
+
+                    if (queryBBox.min.x <= bbox.max.x &&
+                        queryBBox.min.y <= bbox.max.y &&
+                        queryBBox.max.x >= bbox.min.x &&
+                        queryBBox.max.y >= bbox.min.y &&
+                        !fn(boxes[i].box, features[boxes[i].feature])) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Calls `fn(box, feature)` for every box, in insertion order.
+    template <class Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& element : boxes) {
+            fn(element.box, features[element.feature]);
+        }
+    }
+
+    bool empty() const {
+        return boxes.empty();
+    }
+
+private:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    struct Element {
+        CollisionBox box;
+        uint32_t feature;
+    };
+
+    struct Link {
+        uint32_t element;
+        uint32_t next;
+    };
+
+    void insert(const CollisionBox&, const BBox&, uint32_t feature);
+
+    int32_t cellX(float x) const {
+        return util::max(0.0f, util::min(columns - 1.0f, std::floor((x - origin.x) * scale)));
+    }
+
+    int32_t cellY(float y) const {
+        return util::max(0.0f, util::min(rows - 1.0f, std::floor((y - origin.y) * scale)));
+    }
+
+    const mapbox::geometry::point<float> origin;
+    const float scale;
+    const int32_t columns;
+    const int32_t rows;
+
+    std::vector<Element> boxes;
+    std::vector<BBox> bboxes;
+    std::vector<IndexedSubfeature> features;
+
+    // The first link of every cell's list, and the links.
+    std::vector<uint32_t> cells;
+    std::vector<Link> links;
+};
+
+} // namespace mbgl
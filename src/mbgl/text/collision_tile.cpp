@@ -10,10 +10,40 @@
 #include <mapbox/geometry/multi_point.hpp>
 
 #include <cmath>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
-CollisionTile::CollisionTile(PlacementConfig config_) : config(std::move(config_)) {
+namespace {
+
+// The cells are about the size of a label at the tile's zoom level.
+constexpr float gridCellSize = util::EXTENT / 16;
+
+// Bounds of the tile in the rotated coordinates that collision boxes are placed in. Anchors
+// rarely fall outside, and the grid keeps boxes that do in its outermost cells.
+CollisionGrid::BBox rotatedTileBounds(float angle) {
+    const float angle_sin = std::sin(angle);
+    const float angle_cos = std::cos(angle);
+    const std::array<float, 4> matrix = { { angle_cos, -angle_sin, angle_sin, angle_cos } };
+
+    const Point<float> tl = util::matrixMultiply(matrix, Point<float>(0, 0));
+    const Point<float> tr = util::matrixMultiply(matrix, Point<float>(util::EXTENT, 0));
+    const Point<float> bl = util::matrixMultiply(matrix, Point<float>(0, util::EXTENT));
+    const Point<float> br = util::matrixMultiply(matrix, Point<float>(util::EXTENT, util::EXTENT));
+
+    return {
+        { util::min(tl.x, tr.x, bl.x, br.x), util::min(tl.y, tr.y, bl.y, br.y) },
+        { util::max(tl.x, tr.x, bl.x, br.x), util::max(tl.y, tr.y, bl.y, br.y) }
+    };
+}
+
+} // namespace
+
+CollisionTile::CollisionTile(PlacementConfig config_)
+    : config(std::move(config_)),
+      grid(rotatedTileBounds(config.angle), gridCellSize),
+      ignoredGrid(rotatedTileBounds(config.angle), gridCellSize) {
     // Compute the transformation matrix.
     const float angle_sin = std::sin(config.angle);
     const float angle_cos = std::cos(config.angle);
@@ -87,13 +117,13 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
         const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
 
         if (!allowOverlap) {
-            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
-                const CollisionBox& blocking = std::get<1>(*it);
+            const bool blocked = !grid.query(getGridBox(anchor, box), [&] (const CollisionBox& blocking, const IndexedSubfeature&) {
                 Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
 
                 minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, blockingAnchor, blocking));
-                if (minPlacementScale >= maxScale) return minPlacementScale;
-            }
+                return minPlacementScale < maxScale;
+            });
+            if (blocked) return minPlacementScale;
         }
 
         if (avoidEdges) {
@@ -124,15 +154,9 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
     }
 
     if (minPlacementScale < maxScale) {
-        std::vector<CollisionTreeBox> treeBoxes;
-        for (auto& box : feature.boxes) {
-            treeBoxes.emplace_back(getTreeBox(util::matrixMultiply(rotationMatrix, box.anchor), box), box, feature.indexedFeature);
-        }
-        if (ignorePlacement) {
-            ignoredTree.insert(treeBoxes.begin(), treeBoxes.end());
-        } else {
-            tree.insert(treeBoxes.begin(), treeBoxes.end());
-        }
+        (ignorePlacement ? ignoredGrid : grid).insert(feature, [&] (const CollisionBox& box) {
+            return getGridBox(util::matrixMultiply(rotationMatrix, box.anchor), box);
+        });
     }
 
 }
@@ -141,7 +165,7 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |(x1,y1)      |             | relative to the tile e.g. when zooming in,
 // |             |             | the symbol gets smaller relative to the tile.
 // |  (x1',y1')  v             |
-// |     +-------+-------+     | The boxes inserted into the tree represents
+// |     +-------+-------+     | The boxes inserted into the grid represent
 // |     |       |       |     | the bounds at the integer zoom level (where
 // |     |       |       |     | the symbol is biggest relative to the tile).
 // |     |       |       |     |
@@ -154,14 +178,14 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |             |             | calculating the bounds at current zoom level
 // |             |      (x2,y2)| we must unscale the box using its center as
 // +---------------------------+ transform origin.
-Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
+CollisionGrid::BBox CollisionTile::getGridBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
     assert(box.x1 <= box.x2 && box.y1 <= box.y2);
-    return Box{
-        CollisionPoint{
+    return CollisionGrid::BBox{
+        {
             anchor.x + box.x1 / scale,
             anchor.y + box.y1 / scale * yStretch
         },
-        CollisionPoint{
+        {
             anchor.x + box.x2 / scale,
             anchor.y + box.y2 / scale * yStretch
         }
@@ -170,7 +194,7 @@ Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& bo
 
 std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const GeometryCoordinates& queryGeometry, float scale) const {
     std::vector<IndexedSubfeature> result;
-    if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty())) {
+    if (queryGeometry.empty() || (grid.empty() && ignoredGrid.empty())) {
         return result;
     }
 
@@ -182,26 +206,11 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         polygon.push_back(convertPoint<int16_t>(rotated));
     }
 
-    // Predicate for ruling out already seen features.
-    std::unordered_map<std::string, std::unordered_set<std::size_t>> sourceLayerFeatures;
-    auto seenFeature = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const IndexedSubfeature& feature = std::get<2>(treeBox);
-        const auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
-        return seenFeatures.find(feature.index) == seenFeatures.end();
-    };
-
     // Account for the rounding done when updating symbol shader variables.
     const float roundedScale = std::pow(2.0f, std::ceil(util::log2(scale) * 10.0f) / 10.0f);
 
-    // Check if feature is rendered (collision free) at current scale.
-    auto visibleAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& box = std::get<1>(treeBox);
-        return roundedScale >= box.placementScale && roundedScale <= box.maxScale;
-    };
-
     // Check if query polygon intersects with the feature box at current scale.
-    auto intersectsAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& collisionBox = std::get<1>(treeBox);
+    auto intersectsAtScale = [&] (const CollisionBox& collisionBox) -> bool {
         const auto anchor = util::matrixMultiply(rotationMatrix, collisionBox.anchor);
         const int16_t x1 = anchor.x + collisionBox.x1 / scale;
         const int16_t y1 = anchor.y + collisionBox.y1 / scale * yStretch;
@@ -213,21 +222,29 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         return util::polygonIntersectsPolygon(polygon, bbox);
     };
 
-    auto predicates = bgi::satisfies(seenFeature)
-                   && bgi::satisfies(visibleAtScale)
-                   && bgi::satisfies(intersectsAtScale);
-
-    auto queryTree = [&](const auto& tree_) {
-        for (auto it = tree_.qbegin(predicates); it != tree_.qend(); ++it) {
-            const IndexedSubfeature& feature = std::get<2>(*it);
+    // Boxes are scaled around their anchor, so every box has to be looked at. Skip features
+    // that were already found, and boxes that aren't rendered (collision free) at the
+    // current scale.
+    std::unordered_map<std::string, std::unordered_set<std::size_t>> sourceLayerFeatures;
+    auto queryGrid = [&] (const CollisionGrid& grid_) {
+        grid_.forEach([&] (const CollisionBox& box, const IndexedSubfeature& feature) {
             auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
+            if (seenFeatures.find(feature.index) != seenFeatures.end()) {
+                return;
+            }
+            if (roundedScale < box.placementScale || roundedScale > box.maxScale) {
+                return;
+            }
+            if (!intersectsAtScale(box)) {
+                return;
+            }
             seenFeatures.insert(feature.index);
             result.push_back(feature);
-        }
+        });
     };
 
-    queryTree(tree);
-    queryTree(ignoredTree);
+    queryGrid(grid);
+    queryGrid(ignoredGrid);
 
     return result;
 }
@@ -14,6 +14,7 @@ static GlyphAtlasObserver nullObserver;
 
 GlyphAtlas::GlyphAtlas(const Size size, FileSource& fileSource_)
     : fileSource(fileSource_),
+      glyphSets(std::make_shared<const GlyphSets>()),
       observer(&nullObserver),
       bin(size.width, size.height),
       image(size),
@@ -40,6 +41,18 @@ bool GlyphAtlas::hasGlyphRanges(const FontStack& fontStack, const GlyphRangeSet&
         return true;
     }
 
+    // Once everything is loaded, answer from the snapshot without taking a lock.
+    {
+        const auto snapshot = std::atomic_load(&glyphSets);
+        const auto it = snapshot->parsedRanges.find(fontStack);
+        if (it != snapshot->parsedRanges.end() &&
+            std::all_of(glyphRanges.begin(), glyphRanges.end(), [&](const GlyphRange& range) {
+                return it->second.count(range);
+            })) {
+            return true;
+        }
+    }
+
     std::lock_guard<std::mutex> lock(rangesMutex);
     const auto& rangeSets = ranges[fontStack];
 
@@ -63,17 +76,30 @@ bool GlyphAtlas::hasGlyphRanges(const FontStack& fontStack, const GlyphRangeSet&
     return hasRanges;
 }
 
-util::exclusive<GlyphSet> GlyphAtlas::getGlyphSet(const FontStack& fontStack) {
-    auto lock = std::make_unique<std::lock_guard<std::mutex>>(glyphSetsMutex);
+std::shared_ptr<const GlyphSet> GlyphAtlas::getGlyphSet(const FontStack& fontStack) const {
+    static const auto empty = std::make_shared<const GlyphSet>();
 
-    auto it = glyphSets.find(fontStack);
-    if (it == glyphSets.end()) {
-        it = glyphSets.emplace(fontStack, std::make_unique<GlyphSet>()).first;
+    const auto snapshot = std::atomic_load(&glyphSets);
+    const auto it = snapshot->sets.find(fontStack);
+    return it != snapshot->sets.end() ? it->second : empty;
+}
+
+void GlyphAtlas::insertGlyphs(const FontStack& fontStack, const GlyphRange& range, std::vector<SDFGlyph>&& glyphs) {
+    std::lock_guard<std::mutex> lock(glyphSetsMutex);
+
+    auto snapshot = std::make_shared<GlyphSets>(*std::atomic_load(&glyphSets));
+
+    // Only copies pointers to the glyphs loaded so far.
+    auto glyphSet = std::make_shared<GlyphSet>(*getGlyphSet(fontStack));
+    for (auto& glyph : glyphs) {
+        const uint32_t id = glyph.id;
+        glyphSet->insert(id, std::move(glyph));
     }
 
-    // FIXME: We lock all GlyphSets, but what we should
-    // really do is lock only the one we are returning.
-    return { it->second.get(), std::move(lock) };
+    snapshot->sets[fontStack] = std::move(glyphSet);
+    snapshot->parsedRanges[fontStack].insert(range);
+
+    std::atomic_store(&glyphSets, std::shared_ptr<const GlyphSets>(std::move(snapshot)));
 }
 
 void GlyphAtlas::setObserver(GlyphAtlasObserver* observer_) {
@@ -88,7 +114,7 @@ void GlyphAtlas::addGlyphs(uintptr_t tileUID,
 {
     std::lock_guard<std::mutex> lock(mtx);
 
-    const std::map<uint32_t, SDFGlyph>& sdfs = glyphSet.getSDFs();
+    const std::map<uint32_t, std::shared_ptr<const SDFGlyph>>& sdfs = glyphSet.getSDFs();
 
     for (char16_t chr : text)
     {
@@ -97,7 +123,7 @@ void GlyphAtlas::addGlyphs(uintptr_t tileUID,
             continue;
         }
 
-        const SDFGlyph& sdf = sdf_it->second;
+        const SDFGlyph& sdf = *sdf_it->second;
         Rect<uint16_t> rect = addGlyph(tileUID, fontStack, sdf);
         face.emplace(chr, Glyph{rect, sdf.metrics});
     }
@@ -6,13 +6,13 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/font_stack.hpp>
-#include <mbgl/util/exclusive.hpp>
 #include <mbgl/util/work_queue.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/object.hpp>
 
 #include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
@@ -35,7 +35,15 @@ public:
     GlyphAtlas(Size, FileSource&);
     ~GlyphAtlas();
 
-    util::exclusive<GlyphSet> getGlyphSet(const FontStack&);
+    // Returns an immutable snapshot of the glyphs parsed so far for this font stack.
+    // Glyphs that arrive later are published in a new snapshot, so the returned set can be
+    // used for as long as needed without holding any lock. This method can be called from
+    // any thread.
+    std::shared_ptr<const GlyphSet> getGlyphSet(const FontStack&) const;
+
+    // Publishes the glyphs of a newly parsed range in a new snapshot of the font stack's
+    // GlyphSet.
+    void insertGlyphs(const FontStack&, const GlyphRange&, std::vector<SDFGlyph>&&);
 
     // Returns true if the set of GlyphRanges are available and parsed or false
     // if they are not. For the missing ranges, a request on the FileSource is
@@ -84,7 +92,14 @@ private:
     std::unordered_map<FontStack, std::map<GlyphRange, std::unique_ptr<GlyphPBF>>, FontStackHash> ranges;
     std::mutex rangesMutex;
 
-    std::unordered_map<FontStack, std::unique_ptr<GlyphSet>, FontStackHash> glyphSets;
+    // Everything parsed so far. Readers load the current snapshot atomically; writers,
+    // serialized by glyphSetsMutex, copy it, add to the copy and swap it in.
+    struct GlyphSets {
+        std::unordered_map<FontStack, std::shared_ptr<const GlyphSet>, FontStackHash> sets;
+        std::unordered_map<FontStack, GlyphRangeSet, FontStackHash> parsedRanges;
+    };
+
+    std::shared_ptr<const GlyphSets> glyphSets;
     std::mutex glyphSetsMutex;
 
     util::WorkQueue workQueue;
@@ -16,7 +16,8 @@ namespace mbgl {
 
 namespace {
 
-void parseGlyphPBF(GlyphSet& glyphSet, const GlyphRange& glyphRange, const std::string& data) {
+std::vector<SDFGlyph> parseGlyphPBF(const GlyphRange& glyphRange, const std::string& data) {
+    std::vector<SDFGlyph> result;
     protozero::pbf_reader glyphs_pbf(data);
 
     while (glyphs_pbf.next(1)) {
@@ -82,10 +83,12 @@ void parseGlyphPBF(GlyphSet& glyphSet, const GlyphRange& glyphRange, const std::
                 glyph.metrics.top >= -128 && glyph.metrics.top < 128 &&
                 glyph.metrics.advance < 256 && glyph.bitmap.size() == expectedBitmapSize &&
                 glyph.id >= glyphRange.first && glyph.id <= glyphRange.second) {
-                glyphSet.insert(glyph.id, std::move(glyph));
+                result.push_back(std::move(glyph));
             }
         }
     }
+
+    return result;
 }
 
 } // namespace
@@ -103,11 +106,12 @@ GlyphPBF::GlyphPBF(GlyphAtlas* atlas,
         } else if (res.notModified) {
             return;
         } else if (res.noContent) {
+            atlas->insertGlyphs(fontStack, glyphRange, {});
             parsed = true;
             observer->onGlyphsLoaded(fontStack, glyphRange);
         } else {
             try {
-                parseGlyphPBF(**atlas->getGlyphSet(fontStack), glyphRange, *res.data);
+                atlas->insertGlyphs(fontStack, glyphRange, parseGlyphPBF(glyphRange, *res.data));
             } catch (...) {
                 observer->onGlyphsError(fontStack, glyphRange, std::current_exception());
                 return;
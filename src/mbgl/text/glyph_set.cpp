@@ -14,15 +14,15 @@ void GlyphSet::insert(uint32_t id, SDFGlyph&& glyph) {
     auto it = sdfs.find(id);
     if (it == sdfs.end()) {
         // Glyph doesn't exist yet.
-        sdfs.emplace(id, std::move(glyph));
-    } else if (it->second.metrics == glyph.metrics) {
-        if (it->second.bitmap != glyph.bitmap) {
+        sdfs.emplace(id, std::make_shared<const SDFGlyph>(std::move(glyph)));
+    } else if (it->second->metrics == glyph.metrics) {
+        if (it->second->bitmap != glyph.bitmap) {
             // The actual bitmap was updated; this is unsupported.
             Log::Warning(Event::Glyph, "Modified glyph changed bitmap represenation");
         }
         // At least try to update it in case it's currently unsused.
         // If it is already used; we won't attempt to update the glyph atlas texture.
-        it->second.bitmap = std::move(glyph.bitmap);
+        it->second = std::make_shared<const SDFGlyph>(std::move(glyph));
     } else {
         // The metrics were updated; this is unsupported.
         Log::Warning(Event::Glyph, "Modified glyph has different metrics");
@@ -30,7 +30,7 @@ void GlyphSet::insert(uint32_t id, SDFGlyph&& glyph) {
     }
 }
 
-const std::map<uint32_t, SDFGlyph>& GlyphSet::getSDFs() const {
+const std::map<uint32_t, std::shared_ptr<const SDFGlyph>>& GlyphSet::getSDFs() const {
     return sdfs;
 }
 
@@ -79,7 +79,7 @@ void align(Shaping& shaping,
 
 // justify left = 0, right = 1, center = .5
 void justifyLine(std::vector<PositionedGlyph>& positionedGlyphs,
-                 const std::map<uint32_t, SDFGlyph>& sdfs,
+                 const std::map<uint32_t, std::shared_ptr<const SDFGlyph>>& sdfs,
                  std::size_t start,
                  std::size_t end,
                  float justify) {
@@ -90,7 +90,7 @@ void justifyLine(std::vector<PositionedGlyph>& positionedGlyphs,
     PositionedGlyph& glyph = positionedGlyphs[end];
     auto it = sdfs.find(glyph.glyph);
     if (it != sdfs.end()) {
-        const uint32_t lastAdvance = it->second.metrics.advance;
+        const uint32_t lastAdvance = it->second->metrics.advance;
         const float lineIndent = float(glyph.x + lastAdvance) * justify;
 
         for (std::size_t j = start; j <= end; j++) {
@@ -107,7 +107,7 @@ float GlyphSet::determineAverageLineWidth(const std::u16string& logicalInput,
     for (char16_t chr : logicalInput) {
         auto it = sdfs.find(chr);
         if (it != sdfs.end()) {
-            totalWidth += it->second.metrics.advance + spacing;
+            totalWidth += it->second->metrics.advance + spacing;
         }
     }
 
@@ -216,7 +216,7 @@ std::set<std::size_t> GlyphSet::determineLineBreaks(const std::u16string& logica
         const char16_t codePoint = logicalInput[i];
         auto it = sdfs.find(codePoint);
         if (it != sdfs.end() && !boost::algorithm::is_any_of(u" \t\n\v\f\r")(codePoint)) {
-            currentX += it->second.metrics.advance + spacing;
+            currentX += it->second->metrics.advance + spacing;
         }
         
         // Ideographic characters, spaces, and word-breaking punctuation that often appear without
@@ -265,7 +265,7 @@ void GlyphSet::shapeLines(Shaping& shaping,
                 continue;
             }
 
-            const SDFGlyph& glyph = it->second;
+            const SDFGlyph& glyph = *it->second;
             shaping.positionedGlyphs.emplace_back(chr, x, y);
             x += glyph.metrics.advance + spacing;
         }
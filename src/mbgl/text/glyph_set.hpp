@@ -4,12 +4,14 @@
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <memory>
+
 namespace mbgl {
 
 class GlyphSet {
 public:
     void insert(uint32_t id, SDFGlyph&&);
-    const std::map<uint32_t, SDFGlyph>& getSDFs() const;
+    const std::map<uint32_t, std::shared_ptr<const SDFGlyph>>& getSDFs() const;
     const Shaping getShaping(const std::u16string& string,
                              float maxWidth,
                              float lineHeight,
@@ -37,7 +39,9 @@ private:
                     float justify,
                     const Point<float>& translate) const;
 
-    std::map<uint32_t, SDFGlyph> sdfs;
+    // Glyphs are immutable and shared, so that copying a glyph set for a new snapshot doesn't
+    // copy their bitmaps.
+    std::map<uint32_t, std::shared_ptr<const SDFGlyph>> sdfs;
 };
 
 } // end namespace mbgl
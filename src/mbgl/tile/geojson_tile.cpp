@@ -73,6 +73,14 @@ public:
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
         return std::make_unique<GeoJSONTileFeature>(features[i]);
     }
+
+    void eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t)> fn) const override {
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            if (!fn(GeoJSONTileFeature(features[i]), i)) {
+                break;
+            }
+        }
+    }
 };
 
 GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
@@ -85,6 +93,8 @@ void GeoJSONTile::updateData(const mapbox::geometry::feature_collection<int16_t>
     setData(std::make_unique<GeoJSONTileData>(features));
 }
 
-void GeoJSONTile::setNecessity(Necessity) {}
+void GeoJSONTile::setNecessity(Necessity necessity) {
+    setWorkerPriority(necessity);
+}
 
 } // namespace mbgl
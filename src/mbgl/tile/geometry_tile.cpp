@@ -14,6 +14,8 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <unordered_set>
+
 namespace mbgl {
 
 using namespace style;
@@ -27,6 +29,7 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
       mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())),
       worker(parameters.workerScheduler,
              ActorRef<GeometryTile>(*this, mailbox),
+             parameters.workerScheduler,
              id_,
              *parameters.style.glyphAtlas,
              obsolete,
@@ -57,6 +60,10 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     redoLayout();
 }
 
+void GeometryTile::setWorkerPriority(Necessity necessity) {
+    worker.setPriority(workerPriority(necessity));
+}
+
 void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
     if (requestedConfig == desiredConfig) {
         return;
@@ -84,10 +91,10 @@ void GeometryTile::redoLayout() {
         availableData = DataAvailability::Some;
     }
 
-    std::vector<std::unique_ptr<Layer>> copy;
+    std::vector<std::shared_ptr<const Layer>> relevant;
 
-    for (const Layer* layer : style.getLayers()) {
-        // Avoid cloning and including irrelevant layers.
+    for (const auto& layer : *style.getLayerSnapshot()) {
+        // Avoid including irrelevant layers.
         if (layer->is<BackgroundLayer>() ||
             layer->is<CustomLayer>() ||
             layer->baseImpl->source != sourceID ||
@@ -97,11 +104,11 @@ void GeometryTile::redoLayout() {
             continue;
         }
 
-        copy.push_back(layer->baseImpl->clone());
+        relevant.push_back(layer);
     }
 
     ++correlationID;
-    worker.invoke(&GeometryTileWorker::setLayers, std::move(copy), correlationID);
+    worker.invoke(&GeometryTileWorker::setLayers, std::move(relevant), correlationID);
 }
 
 void GeometryTile::onLayout(LayoutResult result) {
@@ -137,6 +144,30 @@ Bucket* GeometryTile::getBucket(const Layer& layer) {
     return it->second.get();
 }
 
+std::size_t GeometryTile::getByteSize() const {
+    std::size_t result = 0;
+
+    // Layers that share a layout share a bucket; count each bucket once.
+    std::unordered_set<const Bucket*> counted;
+    for (const auto& buckets : { &nonSymbolBuckets, &symbolBuckets }) {
+        for (const auto& pair : *buckets) {
+            if (counted.insert(pair.second.get()).second) {
+                result += pair.second->getByteSize();
+            }
+        }
+    }
+
+    if (featureIndex) {
+        result += featureIndex->getByteSize();
+    }
+
+    if (data) {
+        result += data->getByteSize();
+    }
+
+    return result;
+}
+
 void GeometryTile::queryRenderedFeatures(
     std::unordered_map<std::string, std::vector<Feature>>& result,
     const GeometryCoordinates& queryGeometry,
@@ -39,6 +39,7 @@ public:
     void redoLayout() override;
 
     Bucket* getBucket(const style::Layer&) override;
+    std::size_t getByteSize() const override;
 
     void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -67,6 +68,9 @@ public:
 
     void onError(std::exception_ptr);
 
+protected:
+    void setWorkerPriority(Necessity);
+
 private:
     const std::string sourceID;
     style::Style& style;
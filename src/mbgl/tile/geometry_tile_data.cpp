@@ -5,6 +5,15 @@
 
 namespace mbgl {
 
+void GeometryTileLayer::eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t)> fn) const {
+    const std::size_t count = featureCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!fn(*getFeature(i), i)) {
+            break;
+        }
+    }
+}
+
 static double signedArea(const GeometryCoordinates& ring) {
     double sum = 0;
 
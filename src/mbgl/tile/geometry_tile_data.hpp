@@ -5,7 +5,9 @@
 #include <mbgl/util/optional.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -35,6 +37,10 @@ public:
     virtual ~GeometryTileFeature() = default;
     virtual FeatureType getType() const = 0;
     virtual optional<Value> getValue(const std::string& key) const = 0;
+
+    // Looks up a value by the index of its key in the layer's key table. Only called for
+    // features of layers that return a key table from GeometryTileLayer::getKeysMap().
+    virtual optional<Value> getIndexedValue(uint32_t) const { return {}; }
     virtual PropertyMap getProperties() const { return PropertyMap(); }
     virtual optional<FeatureIdentifier> getID() const { return {}; }
     virtual GeometryCollection getGeometries() const = 0;
@@ -46,6 +52,15 @@ public:
     virtual std::size_t featureCount() const = 0;
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
     virtual std::string getName() const = 0;
+
+    // Layers whose features share an interned table of property keys return it here, to
+    // allow resolving keys to indices once per layer instead of once per feature.
+    virtual const std::unordered_map<std::string, uint32_t>* getKeysMap() const { return nullptr; }
+
+    // Calls the function for each feature in order, until it returns false. Unlike with
+    // getFeature(), implementations may reuse a single feature object for all calls, so
+    // the reference must not be retained beyond the call.
+    virtual void eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t index)>) const;
 };
 
 class GeometryTileData {
@@ -53,6 +68,9 @@ public:
     virtual ~GeometryTileData() = default;
     virtual std::unique_ptr<GeometryTileData> clone() const = 0;
     virtual const GeometryTileLayer* getLayer(const std::string&) const = 0;
+
+    // Approximate number of bytes of source data held by this object.
+    virtual std::size_t getByteSize() const { return 0; }
 };
 
 // classifies an array of rings into polygons with outer rings and holes
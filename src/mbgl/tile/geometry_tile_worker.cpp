@@ -1,4 +1,5 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
+#include <mbgl/actor/fork_join.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/text/collision_tile.hpp>
@@ -13,6 +14,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/tracing.hpp>
 
 #include <unordered_set>
 
@@ -22,12 +24,14 @@ using namespace style;
 
 GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
+                                       Scheduler& scheduler_,
                                        OverscaledTileID id_,
                                        GlyphAtlas& glyphAtlas_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
+      scheduler(scheduler_),
       id(std::move(id_)),
       glyphAtlas(glyphAtlas_),
       obsolete(obsolete_),
@@ -76,6 +80,10 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
         data = std::move(data_);
         correlationID = correlationID_;
 
+        // Nothing laid out from the previous data can be reused.
+        layoutGroups.clear();
+        layoutLayers.clear();
+
         switch (state) {
         case Idle:
             redoLayout();
@@ -93,7 +101,7 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
     }
 }
 
-void GeometryTileWorker::setLayers(std::vector<std::unique_ptr<Layer>> layers_, uint64_t correlationID_) {
+void GeometryTileWorker::setLayers(std::vector<std::shared_ptr<const Layer>> layers_, uint64_t correlationID_) {
     try {
         layers = std::move(layers_);
         correlationID = correlationID_;
@@ -202,6 +210,8 @@ void GeometryTileWorker::redoLayout() {
         return;
     }
 
+    tracing::Scope trace("worker", tracing::isEnabled() ? "layout " + util::toString(id) : "");
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->is<SymbolLayer>()) {
@@ -209,54 +219,101 @@ void GeometryTileWorker::redoLayout() {
         }
     }
 
-    std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
-    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
-    auto featureIndex = std::make_unique<FeatureIndex>();
-    BucketParameters parameters { id, obsolete, *featureIndex, mode };
+    const auto layerGroups = groupByLayout(*layers);
+
+    // Groups are laid out in three passes. The first one, run serially, picks up the
+    // groups that can be reused from the previous layout, looks up the source layers
+    // (which are decoded on demand), and creates the symbol layouts. The second one
+    // builds the remaining buckets in parallel, one task per group; each group has a
+    // feature index of its own. The last one merges the results in layer order, so
+    // that the outcome doesn't depend on the order in which the tasks completed.
+    std::vector<LayoutGroup> results(layerGroups.size());
+    std::vector<const GeometryTileLayer*> geometryLayers(layerGroups.size(), nullptr);
+    std::vector<std::size_t> pendingBuckets;
 
-    std::vector<std::vector<const Layer*>> groups = groupByLayout(*layers);
-    for (auto& group : groups) {
+    for (std::size_t i = 0; *data && i < layerGroups.size(); ++i) {
         if (obsolete) {
             return;
         }
 
-        if (!*data) {
-            continue; // Tile has no data.
-        }
-
+        const auto& group = layerGroups[i];
         const Layer& leader = *group.at(0);
 
-        auto geometryLayer = (*data)->getLayer(leader.baseImpl->sourceLayer);
-        if (!geometryLayer) {
+        auto previous = layoutGroups.find(leader.getID());
+        if (previous != layoutGroups.end() && previous->second.layers == group) {
+            results[i] = std::move(previous->second);
+            continue;
+        }
+
+        geometryLayers[i] = (*data)->getLayer(leader.baseImpl->sourceLayer);
+        if (!geometryLayers[i]) {
             continue;
         }
 
+        results[i].layers = group;
+        results[i].featureIndex = std::make_unique<FeatureIndex>();
+
+        if (leader.is<SymbolLayer>()) {
+            std::vector<std::string> layerIDs;
+            for (const auto& layer : group) {
+                layerIDs.push_back(layer->getID());
+            }
+
+            BucketParameters parameters { id, obsolete, *results[i].featureIndex, mode };
+            results[i].symbolLayout = leader.as<SymbolLayer>()->impl->createLayout(parameters, *geometryLayers[i], layerIDs);
+        } else {
+            pendingBuckets.push_back(i);
+        }
+    }
+
+    forkJoin(scheduler, pendingBuckets.size(), [&] (std::size_t n) {
+        LayoutGroup& result = results[pendingBuckets[n]];
+        BucketParameters parameters { id, obsolete, *result.featureIndex, mode };
+        result.bucket = result.layers.at(0)->baseImpl->createBucket(parameters, *geometryLayers[pendingBuckets[n]]);
+    });
+
+    if (obsolete) {
+        return;
+    }
+
+    std::unordered_map<std::string, LayoutGroup> groups;
+    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+    auto featureIndex = std::make_unique<FeatureIndex>();
+
+    for (auto& result : results) {
+        if (result.layers.empty()) {
+            continue; // Tile has no data, or no data for this group's source layer.
+        }
+
+        const Layer& leader = *result.layers.at(0);
+
         std::vector<std::string> layerIDs;
-        for (const auto& layer : group) {
+        for (const auto& layer : result.layers) {
             layerIDs.push_back(layer->getID());
         }
 
         featureIndex->setBucketLayerIDs(leader.getID(), layerIDs);
+        featureIndex->insert(*result.featureIndex);
 
-        if (leader.is<SymbolLayer>()) {
-            symbolLayoutMap.emplace(leader.getID(),
-                leader.as<SymbolLayer>()->impl->createLayout(parameters, *geometryLayer, layerIDs));
-        } else {
-            std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, *geometryLayer);
-            if (!bucket->hasData()) {
-                continue;
-            }
-            for (const auto& layer : group) {
-                buckets.emplace(layer->getID(), bucket);
+        if (result.bucket && result.bucket->hasData()) {
+            for (const auto& layer : result.layers) {
+                buckets.emplace(layer->getID(), result.bucket);
             }
         }
+
+        groups.emplace(leader.getID(), std::move(result));
     }
 
+    featureIndex->build();
+
+    layoutGroups = std::move(groups);
+    layoutLayers = *layers;
+
     symbolLayouts.clear();
     for (const auto& symbolLayerID : symbolOrder) {
-        auto it = symbolLayoutMap.find(symbolLayerID);
-        if (it != symbolLayoutMap.end()) {
-            symbolLayouts.push_back(std::move(it->second));
+        auto it = layoutGroups.find(symbolLayerID);
+        if (it != layoutGroups.end() && it->second.symbolLayout) {
+            symbolLayouts.push_back(it->second.symbolLayout);
         }
     }
 
@@ -287,6 +344,8 @@ void GeometryTileWorker::attemptPlacement() {
         return;
     }
 
+    tracing::Scope trace("worker", tracing::isEnabled() ? "placement " + util::toString(id) : "");
+
     bool canPlace = true;
 
     // Prepare as many SymbolLayouts as possible.
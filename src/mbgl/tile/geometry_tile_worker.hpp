@@ -16,6 +16,9 @@ class GeometryTile;
 class GeometryTileData;
 class GlyphAtlas;
 class SymbolLayout;
+class Bucket;
+class FeatureIndex;
+class Scheduler;
 
 namespace style {
 class Layer;
@@ -25,13 +28,14 @@ class GeometryTileWorker {
 public:
     GeometryTileWorker(ActorRef<GeometryTileWorker> self,
                        ActorRef<GeometryTile> parent,
+                       Scheduler&,
                        OverscaledTileID,
                        GlyphAtlas&,
                        const std::atomic<bool>&,
                        const MapMode);
     ~GeometryTileWorker();
 
-    void setLayers(std::vector<std::unique_ptr<style::Layer>>, uint64_t correlationID);
+    void setLayers(std::vector<std::shared_ptr<const style::Layer>>, uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>, uint64_t correlationID);
     void setPlacementConfig(PlacementConfig, uint64_t correlationID);
     void symbolDependenciesChanged();
@@ -46,6 +50,10 @@ private:
     ActorRef<GeometryTileWorker> self;
     ActorRef<GeometryTile> parent;
 
+    // The scheduler this worker runs on; independent layer groups are laid out in
+    // parallel on it.
+    Scheduler& scheduler;
+
     const OverscaledTileID id;
     GlyphAtlas& glyphAtlas;
     const std::atomic<bool>& obsolete;
@@ -62,11 +70,27 @@ private:
     uint64_t correlationID = 0;
 
     // Outer optional indicates whether we've received it or not.
-    optional<std::vector<std::unique_ptr<style::Layer>>> layers;
+    optional<std::vector<std::shared_ptr<const style::Layer>>> layers;
     optional<std::unique_ptr<const GeometryTileData>> data;
     optional<PlacementConfig> placementConfig;
 
-    std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
+    std::vector<std::shared_ptr<SymbolLayout>> symbolLayouts;
+
+    // The result of laying out one group of layers that share a layout. Groups whose
+    // layers are unchanged since the previous layout (and whose data hasn't changed)
+    // are reused instead of being built again.
+    class LayoutGroup {
+    public:
+        std::vector<const style::Layer*> layers;
+        std::shared_ptr<Bucket> bucket;
+        std::unique_ptr<FeatureIndex> featureIndex;
+        std::shared_ptr<SymbolLayout> symbolLayout;
+    };
+
+    // Keyed by the ID of each group's leading layer. `layoutLayers` keeps the layers
+    // referenced by `layoutGroups` alive so that pointer comparisons stay meaningful.
+    std::unordered_map<std::string, LayoutGroup> layoutGroups;
+    std::vector<std::shared_ptr<const style::Layer>> layoutLayers;
 };
 
 } // namespace mbgl
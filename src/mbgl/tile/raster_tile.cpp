@@ -55,8 +55,17 @@ Bucket* RasterTile::getBucket(const style::Layer&) {
     return bucket.get();
 }
 
+std::size_t RasterTile::getByteSize() const {
+    return bucket ? bucket->getByteSize() : 0;
+}
+
 void RasterTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
+    worker.setPriority(workerPriority(necessity));
+}
+
+void RasterTile::setViewportCenter(const LatLng& center) {
+    loader.setViewportCenter(center);
 }
 
 } // namespace mbgl
@@ -22,6 +22,7 @@ public:
     ~RasterTile() final;
 
     void setNecessity(Necessity) final;
+    void setViewportCenter(const LatLng&) final;
 
     void setError(std::exception_ptr);
     void setData(std::shared_ptr<const std::string> data,
@@ -30,6 +31,7 @@ public:
 
     void cancel() override;
     Bucket* getBucket(const style::Layer&) override;
+    std::size_t getByteSize() const override;
 
     void onParsed(std::unique_ptr<Bucket> result);
     void onError(std::exception_ptr);
@@ -9,6 +9,7 @@
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/actor/scheduler.hpp>
 
 #include <string>
 #include <memory>
@@ -42,11 +43,19 @@ public:
 
     virtual void setNecessity(Necessity) = 0;
 
+    // Called whenever the viewport changes so that tiles still waiting for their data can be
+    // fetched in order of their distance from its center.
+    virtual void setViewportCenter(const LatLng&) {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
     virtual Bucket* getBucket(const style::Layer&) = 0;
 
+    // Approximate number of bytes held by this tile's buckets, index and data. Used to
+    // keep the tile cache within its memory budget.
+    virtual std::size_t getByteSize() const { return 0; }
+
     virtual void setPlacementConfig(const PlacementConfig&) {}
     virtual void symbolDependenciesChanged() {};
     virtual void redoLayout() {}
@@ -86,6 +95,13 @@ public:
     std::unique_ptr<DebugBucket> debugBucket;
 
 protected:
+    // Tiles in the ideal cover are laid out ahead of tiles that are only retained
+    // for backfill or held in the cache.
+    static Scheduler::Priority workerPriority(Necessity necessity) {
+        return necessity == Necessity::Required ? Scheduler::Priority::High
+                                                : Scheduler::Priority::Low;
+    }
+
     bool triedOptional = false;
 
     enum class DataAvailability : uint8_t {
@@ -7,14 +7,12 @@ namespace mbgl {
 
 void TileCache::setSize(size_t size_) {
     size = size_;
+    evict();
+}
 
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.pop_front();
-        tiles.erase(key);
-    }
-
-    assert(orderedKeys.size() <= size);
+void TileCache::setBudget(size_t budget_) {
+    budget = budget_;
+    evict();
 }
 
 void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
@@ -22,32 +20,32 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
         return;
     }
 
-    // insert new or query existing tile
-    if (tiles.emplace(key, std::move(tile)).second) {
-        // remove existing tile key
-        orderedKeys.remove(key);
-    }
-
-    // (re-)insert tile key as newest
-    orderedKeys.push_back(key);
-
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
+    auto it = index.find(key);
+    if (it != index.end()) {
+        // Keep the existing tile, but mark it as the newest.
+        entries.splice(entries.end(), entries, it->second);
+    } else {
+        const size_t tileSize = tile->getByteSize();
+        if (tileSize > budget) {
+            return; // Don't flush the whole cache for a tile that can't be retained anyway.
+        }
+        entries.push_back({ key, std::move(tile), tileSize });
+        index.emplace(key, std::prev(entries.end()));
+        byteSize += tileSize;
     }
 
-    assert(orderedKeys.size() <= size);
+    evict();
 }
 
 std::unique_ptr<Tile> TileCache::get(const OverscaledTileID& key) {
-
     std::unique_ptr<Tile> tile;
 
-    auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        tile = std::move(it->second);
-        tiles.erase(it);
-        orderedKeys.remove(key);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        tile = std::move(it->second->tile);
+        byteSize -= it->second->byteSize;
+        entries.erase(it->second);
+        index.erase(it);
         assert(tile->isRenderable());
     }
 
@@ -55,12 +53,23 @@ std::unique_ptr<Tile> TileCache::get(const OverscaledTileID& key) {
 }
 
 bool TileCache::has(const OverscaledTileID& key) {
-    return tiles.find(key) != tiles.end();
+    return index.find(key) != index.end();
 }
 
 void TileCache::clear() {
-    orderedKeys.clear();
-    tiles.clear();
+    index.clear();
+    entries.clear();
+    byteSize = 0;
+}
+
+void TileCache::evict() {
+    // Purge the oldest tiles until the cache fits both its tile count and its memory budget.
+    while (!entries.empty() && (entries.size() > size || byteSize > budget)) {
+        get(entries.front().key);
+    }
+
+    assert(entries.size() <= size);
+    assert(byteSize <= budget);
 }
 
 } // namespace mbgl
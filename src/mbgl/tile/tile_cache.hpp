@@ -1,31 +1,54 @@
 #pragma once
 
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
 
+#include <iterator>
 #include <list>
 #include <memory>
-#include <map>
+#include <unordered_map>
 
 namespace mbgl {
 
 class Tile;
 
+// A least-recently-used cache of tiles, bounded both by the number of tiles and by
+// their approximate memory footprint. All operations run in constant time.
 class TileCache {
 public:
-    TileCache(size_t size_ = 0) : size(size_) {}
+    TileCache(size_t size_ = 0, size_t budget_ = util::DEFAULT_TILE_CACHE_BUDGET)
+        : size(size_), budget(budget_) {}
 
     void setSize(size_t);
     size_t getSize() const { return size; };
+
+    // Maximum number of bytes that cached tiles may hold in total.
+    void setBudget(size_t);
+    size_t getBudget() const { return budget; }
+    size_t getByteSize() const { return byteSize; }
+
     void add(const OverscaledTileID& key, std::unique_ptr<Tile> data);
     std::unique_ptr<Tile> get(const OverscaledTileID& key);
     bool has(const OverscaledTileID& key);
     void clear();
 
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
-    std::list<OverscaledTileID> orderedKeys;
+    class Entry {
+    public:
+        OverscaledTileID key;
+        std::unique_ptr<Tile> tile;
+        size_t byteSize;
+    };
+
+    void evict();
+
+    // Ordered from least to most recently added.
+    std::list<Entry> entries;
+    std::unordered_map<OverscaledTileID, std::list<Entry>::iterator> index;
 
     size_t size;
+    size_t budget;
+    size_t byteSize = 0;
 };
 
 } // namespace mbgl
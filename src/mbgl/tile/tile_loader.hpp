@@ -10,6 +10,7 @@ class FileSource;
 class AsyncRequest;
 class Response;
 class Tileset;
+class LatLng;
 
 namespace style {
 class UpdateParameters;
@@ -34,9 +35,13 @@ public:
             } else {
                 makeOptional();
             }
+            updatePriority();
         }
     }
 
+    // Re-ranks the pending request by the tile's distance from the new center of the viewport.
+    void setViewportCenter(const LatLng&);
+
 private:
     // called when the tile is one of the ideal tiles that we want to show definitely. the tile source
     // should try to make every effort (e.g. fetch from internet, or revalidate existing resources).
@@ -51,8 +56,12 @@ private:
     void loadOptional();
     void loadedData(const Response&);
     void loadRequired();
+    void updatePriority();
+
+    float viewportDistance(const LatLng& center) const;
 
     T& tile;
+    const CanonicalTileID tileID;
     Necessity necessity;
     Resource resource;
     FileSource& fileSource;
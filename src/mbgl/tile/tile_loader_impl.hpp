@@ -4,8 +4,11 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/util/tileset.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
+#include <mbgl/map/transform_state.hpp>
 
 #include <cassert>
+#include <cmath>
 
 namespace mbgl {
 
@@ -15,6 +18,7 @@ TileLoader<T>::TileLoader(T& tile_,
                           const style::UpdateParameters& parameters,
                           const Tileset& tileset)
     : tile(tile_),
+      tileID(id.canonical),
       necessity(Necessity::Optional),
       resource(Resource::tile(
         tileset.tiles.at(0),
@@ -25,6 +29,9 @@ TileLoader<T>::TileLoader(T& tile_,
         tileset.scheme)),
       fileSource(parameters.fileSource) {
     assert(!request);
+
+    resource.viewportDistance = viewportDistance(parameters.transformState.getLatLng());
+
     if (fileSource.supportsOptionalRequests()) {
         // When supported, the first request is always optional, even if the TileLoader
         // is marked as required. That way, we can let the first optional request continue
@@ -47,6 +54,35 @@ TileLoader<T>::TileLoader(T& tile_,
 template <typename T>
 TileLoader<T>::~TileLoader() = default;
 
+template <typename T>
+float TileLoader<T>::viewportDistance(const LatLng& latLng) const {
+    const TileCoordinate center = TileCoordinate::fromLatLng(tileID.z, latLng);
+    const double tiles = std::pow(2.0, tileID.z);
+    double dx = tileID.x + 0.5 - center.p.x;
+    dx -= tiles * std::round(dx / tiles); // Measure across the antimeridian if that is closer.
+    const double dy = tileID.y + 0.5 - center.p.y;
+    return std::hypot(dx, dy);
+}
+
+template <typename T>
+void TileLoader<T>::setViewportCenter(const LatLng& center) {
+    const float distance = viewportDistance(center);
+    // Re-ranking costs a round trip to the file source; movements of less than half a tile
+    // rarely change which tile should be fetched next.
+    if (std::abs(distance - resource.viewportDistance) < 0.5f) {
+        return;
+    }
+    resource.viewportDistance = distance;
+    updatePriority();
+}
+
+template <typename T>
+void TileLoader<T>::updatePriority() {
+    if (request) {
+        fileSource.setRequestPriority(*request, necessity, resource.viewportDistance);
+    }
+}
+
 template <typename T>
 void TileLoader<T>::loadOptional() {
     assert(!request);
@@ -1,73 +1,87 @@
 #include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
-#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/logging.hpp>
 
 #include <protozero/pbf_reader.hpp>
 
-#include <unordered_map>
 #include <unordered_map>
 #include <functional>
 #include <utility>
 
 namespace mbgl {
 
-class VectorTileLayer;
-
 using packed_iter_type = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
 
+// A lightweight view of a single feature in a decoded VectorTileLayer. It doesn't own any
+// data and is cheap to construct, so it can be reused while iterating over a layer.
 class VectorTileFeature : public GeometryTileFeature {
 public:
-    VectorTileFeature(protozero::pbf_reader, const VectorTileLayer&);
+    VectorTileFeature(const VectorTileLayer&, std::size_t index);
 
-    FeatureType getType() const override { return type; }
+    FeatureType getType() const override;
     optional<Value> getValue(const std::string&) const override;
+    optional<Value> getIndexedValue(uint32_t) const override;
     std::unordered_map<std::string,Value> getProperties() const override;
     optional<FeatureIdentifier> getID() const override;
     GeometryCollection getGeometries() const override;
 
 private:
+    friend class VectorTileLayer;
+
     const VectorTileLayer& layer;
-    optional<FeatureIdentifier> id;
-    FeatureType type = FeatureType::Unknown;
-    packed_iter_type tags_iter;
-    packed_iter_type geometry_iter;
+    std::size_t index;
 };
 
+// A vector tile layer, decoded once into a columnar representation: all coordinates of all
+// features are stored in one flat array, delimited into rings by an array of offsets, and
+// the key/value index pairs of all features are stored in another flat array. Features
+// reference slices of these arrays.
 class VectorTileLayer : public GeometryTileLayer {
 public:
     VectorTileLayer(protozero::pbf_reader);
 
     std::size_t featureCount() const override { return features.size(); }
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override;
+    void eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t)>) const override;
     std::string getName() const override;
+    const std::unordered_map<std::string, uint32_t>* getKeysMap() const override { return &keysMap; }
 
 private:
-    friend class VectorTileData;
     friend class VectorTileFeature;
 
+    class FeatureRecord {
+    public:
+        optional<FeatureIdentifier> id;
+        FeatureType type = FeatureType::Unknown;
+
+        // Range of rings in `rings`, and range of key/value index pairs in `tags`.
+        uint32_t ringsBegin = 0;
+        uint32_t ringsEnd = 0;
+        uint32_t tagsBegin = 0;
+        uint32_t tagsEnd = 0;
+    };
+
+    void decodeFeature(protozero::pbf_reader);
+    void decodeTags(FeatureRecord&, packed_iter_type);
+    void decodeGeometry(FeatureRecord&, packed_iter_type);
+    GeometryCollection getGeometries(const FeatureRecord&) const;
+
     std::string name;
     uint32_t version = 1;
     uint32_t extent = 4096;
     std::unordered_map<std::string, uint32_t> keysMap;
-    std::vector<std::reference_wrapper<const std::string>> keys;
+    std::vector<std::string> keys;
     std::vector<Value> values;
-    std::vector<protozero::pbf_reader> features;
-};
-
-class VectorTileData : public GeometryTileData {
-public:
-    VectorTileData(std::shared_ptr<const std::string> data);
 
-    std::unique_ptr<GeometryTileData> clone() const override {
-        return std::make_unique<VectorTileData>(*this);
-    }
+    std::vector<FeatureRecord> features;
 
-    const GeometryTileLayer* getLayer(const std::string&) const override;
+    // Interleaved key and value indices.
+    std::vector<uint32_t> tags;
 
-private:
-    std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
-    mutable std::unordered_map<std::string, VectorTileLayer> layers;
+    // Ring `i` consists of `coordinates[rings[i]]` up to (excluding) `coordinates[rings[i + 1]]`.
+    std::vector<uint32_t> rings { 0 };
+    std::vector<GeometryCoordinate> coordinates;
 };
 
 VectorTile::VectorTile(const OverscaledTileID& id_,
@@ -80,6 +94,11 @@ VectorTile::VectorTile(const OverscaledTileID& id_,
 
 void VectorTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
+    setWorkerPriority(necessity);
+}
+
+void VectorTile::setViewportCenter(const LatLng& center) {
+    loader.setViewportCenter(center);
 }
 
 void VectorTile::setData(std::shared_ptr<const std::string> data_,
@@ -117,18 +136,151 @@ Value parseValue(protozero::pbf_reader data) {
     return false;
 }
 
-VectorTileFeature::VectorTileFeature(protozero::pbf_reader feature_pbf, const VectorTileLayer& layer_)
-    : layer(layer_) {
+VectorTileFeature::VectorTileFeature(const VectorTileLayer& layer_, std::size_t index_)
+    : layer(layer_),
+      index(index_) {
+}
+
+FeatureType VectorTileFeature::getType() const {
+    return layer.features[index].type;
+}
+
+optional<Value> VectorTileFeature::getValue(const std::string& key) const {
+    auto keyIter = layer.keysMap.find(key);
+    if (keyIter == layer.keysMap.end()) {
+        return optional<Value>();
+    }
+
+    return getIndexedValue(keyIter->second);
+}
+
+optional<Value> VectorTileFeature::getIndexedValue(uint32_t key) const {
+    const auto& feature = layer.features[index];
+    for (uint32_t i = feature.tagsBegin; i < feature.tagsEnd; i += 2) {
+        if (layer.tags[i] == key) {
+            return layer.values[layer.tags[i + 1]];
+        }
+    }
+
+    return optional<Value>();
+}
+
+std::unordered_map<std::string,Value> VectorTileFeature::getProperties() const {
+    std::unordered_map<std::string,Value> properties;
+    const auto& feature = layer.features[index];
+    for (uint32_t i = feature.tagsBegin; i < feature.tagsEnd; i += 2) {
+        properties[layer.keys[layer.tags[i]]] = layer.values[layer.tags[i + 1]];
+    }
+    return properties;
+}
+
+optional<FeatureIdentifier> VectorTileFeature::getID() const {
+    return layer.features[index].id;
+}
+
+GeometryCollection VectorTileFeature::getGeometries() const {
+    return layer.getGeometries(layer.features[index]);
+}
+
+VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
+    : data(std::move(data_)) {
+}
+
+static std::string layerName(protozero::pbf_reader layer_pbf) {
+    if (layer_pbf.next(1)) {
+        return layer_pbf.get_string();
+    }
+    return "";
+}
+
+const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
+    if (!parsed) {
+        parsed = true;
+        protozero::pbf_reader tile_pbf(*data);
+        while (tile_pbf.next(3)) {
+            auto layer_pbf = tile_pbf.get_message();
+            encodedLayers.emplace(layerName(layer_pbf), layer_pbf);
+        }
+    }
+
+    auto it = layers.find(name);
+    if (it != layers.end()) {
+        return it->second.get();
+    }
+
+    auto encoded = encodedLayers.find(name);
+    if (encoded != encodedLayers.end()) {
+        auto layer = std::make_shared<const VectorTileLayer>(encoded->second);
+        encodedLayers.erase(encoded);
+        return layers.emplace(name, std::move(layer)).first->second.get();
+    }
+
+    return nullptr;
+}
+
+VectorTileLayer::VectorTileLayer(protozero::pbf_reader layer_pbf) {
+    std::vector<protozero::pbf_reader> encodedFeatures;
+
+    while (layer_pbf.next()) {
+        switch (layer_pbf.tag()) {
+        case 1: // name
+            name = layer_pbf.get_string();
+            break;
+        case 2: // feature
+            encodedFeatures.push_back(layer_pbf.get_message());
+            break;
+        case 3: // keys
+            keys.push_back(layer_pbf.get_string());
+            keysMap.emplace(keys.back(), keys.size() - 1);
+            break;
+        case 4: // values
+            values.emplace_back(parseValue(layer_pbf.get_message()));
+            break;
+        case 5: // extent
+            extent = layer_pbf.get_uint32();
+            break;
+        case 15: // version
+            version = layer_pbf.get_uint32();
+            break;
+        default:
+            layer_pbf.skip();
+            break;
+        }
+    }
+
+    // Features can only be decoded once all keys and values are known. A malformed feature
+    // is dropped, together with whatever part of it was already stored.
+    features.reserve(encodedFeatures.size());
+    for (auto& feature_pbf : encodedFeatures) {
+        const std::size_t tagsSize = tags.size();
+        const std::size_t ringsSize = rings.size();
+        const std::size_t coordinatesSize = coordinates.size();
+        try {
+            decodeFeature(feature_pbf);
+        } catch (const std::exception& ex) {
+            Log::Warning(Event::ParseTile, "Skipping malformed feature in layer %s: %s", name.c_str(), ex.what());
+            tags.resize(tagsSize);
+            rings.resize(ringsSize);
+            coordinates.resize(coordinatesSize);
+        }
+    }
+}
+
+void VectorTileLayer::decodeFeature(protozero::pbf_reader feature_pbf) {
+    FeatureRecord feature;
+    packed_iter_type tags_iter;
+    packed_iter_type geometry_iter;
+
     while (feature_pbf.next()) {
         switch (feature_pbf.tag()) {
         case 1: // id
-            id = { feature_pbf.get_uint64() };
+            feature.id = { feature_pbf.get_uint64() };
             break;
         case 2: // tags
             tags_iter = feature_pbf.get_packed_uint32();
             break;
         case 3: // type
-            type = static_cast<FeatureType>(feature_pbf.get_enum());
+            feature.type = static_cast<FeatureType>(feature_pbf.get_enum());
             break;
         case 4: // geometry
             geometry_iter = feature_pbf.get_packed_uint32();
@@ -138,20 +290,21 @@ VectorTileFeature::VectorTileFeature(protozero::pbf_reader feature_pbf, const Ve
             break;
         }
     }
+
+    decodeTags(feature, tags_iter);
+    decodeGeometry(feature, geometry_iter);
+    features.push_back(std::move(feature));
 }
 
-optional<Value> VectorTileFeature::getValue(const std::string& key) const {
-    auto keyIter = layer.keysMap.find(key);
-    if (keyIter == layer.keysMap.end()) {
-        return optional<Value>();
-    }
+void VectorTileLayer::decodeTags(FeatureRecord& feature, packed_iter_type tags_iter) {
+    feature.tagsBegin = tags.size();
 
     auto start_itr = tags_iter.begin();
     const auto & end_itr = tags_iter.end();
     while (start_itr != end_itr) {
         uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
 
-        if (layer.keysMap.size() <= tag_key) {
+        if (keys.size() <= tag_key) {
             throw std::runtime_error("feature referenced out of range key");
         }
 
@@ -159,49 +312,27 @@ optional<Value> VectorTileFeature::getValue(const std::string& key) const {
             throw std::runtime_error("uneven number of feature tag ids");
         }
 
-        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);;
-        if (layer.values.size() <= tag_val) {
+        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
+        if (values.size() <= tag_val) {
             throw std::runtime_error("feature referenced out of range value");
         }
 
-        if (tag_key == keyIter->second) {
-            return layer.values[tag_val];
-        }
-    }
-
-    return optional<Value>();
-}
-
-std::unordered_map<std::string,Value> VectorTileFeature::getProperties() const {
-    std::unordered_map<std::string,Value> properties;
-    auto start_itr = tags_iter.begin();
-    const auto & end_itr = tags_iter.end();
-    while (start_itr != end_itr) {
-        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
-        if (start_itr == end_itr) {
-            throw std::runtime_error("uneven number of feature tag ids");
-        }
-        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
-        properties[layer.keys.at(tag_key)] = layer.values.at(tag_val);
+        tags.push_back(tag_key);
+        tags.push_back(tag_val);
     }
-    return properties;
-}
 
-optional<FeatureIdentifier> VectorTileFeature::getID() const {
-    return id;
+    feature.tagsEnd = tags.size();
 }
 
-GeometryCollection VectorTileFeature::getGeometries() const {
+void VectorTileLayer::decodeGeometry(FeatureRecord& feature, packed_iter_type geometry_iter) {
     uint8_t cmd = 1;
     uint32_t length = 0;
     int32_t x = 0;
     int32_t y = 0;
-    const float scale = float(util::EXTENT) / layer.extent;
+    const float scale = float(util::EXTENT) / extent;
 
-    GeometryCollection lines;
-
-    lines.emplace_back();
-    GeometryCoordinates* line = &lines.back();
+    // `rings.back()` always marks the start of the ring that is currently being decoded.
+    feature.ringsBegin = rings.size() - 1;
 
     auto g_itr = geometry_iter.begin();
     while (g_itr != geometry_iter.end()) {
@@ -217,16 +348,16 @@ GeometryCollection VectorTileFeature::getGeometries() const {
             x += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
             y += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
 
-            if (cmd == 1 && !line->empty()) { // moveTo
-                lines.emplace_back();
-                line = &lines.back();
+            if (cmd == 1 && coordinates.size() > rings.back()) { // moveTo
+                rings.push_back(coordinates.size());
             }
 
-            line->emplace_back(::round(x * scale), ::round(y * scale));
+            coordinates.emplace_back(::round(x * scale), ::round(y * scale));
 
         } else if (cmd == 7) { // closePolygon
-            if (!line->empty()) {
-                line->push_back((*line)[0]);
+            if (coordinates.size() > rings.back()) {
+                const GeometryCoordinate first = coordinates[rings.back()];
+                coordinates.push_back(first);
             }
 
         } else {
@@ -234,69 +365,51 @@ GeometryCollection VectorTileFeature::getGeometries() const {
         }
     }
 
-    if (layer.version >= 2 || type != FeatureType::Polygon) {
-        return lines;
+    rings.push_back(coordinates.size());
+    feature.ringsEnd = rings.size() - 1;
+
+    if (version >= 2 || feature.type != FeatureType::Polygon) {
+        return;
     }
 
-    return fixupPolygons(lines);
-}
+    // Legacy polygons are fixed up once while decoding, replacing the rings decoded above.
+    const GeometryCollection fixed = fixupPolygons(getGeometries(feature));
 
-VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
-    : data(std::move(data_)) {
+    coordinates.resize(rings[feature.ringsBegin]);
+    rings.resize(feature.ringsBegin + 1);
+    for (const auto& ring : fixed) {
+        coordinates.insert(coordinates.end(), ring.begin(), ring.end());
+        rings.push_back(coordinates.size());
+    }
+    feature.ringsEnd = rings.size() - 1;
 }
 
-const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
-    if (!parsed) {
-        parsed = true;
-        protozero::pbf_reader tile_pbf(*data);
-        while (tile_pbf.next(3)) {
-            VectorTileLayer layer(tile_pbf.get_message());
-            layers.emplace(layer.name, std::move(layer));
-        }
-    }
+GeometryCollection VectorTileLayer::getGeometries(const FeatureRecord& feature) const {
+    GeometryCollection lines;
+    lines.reserve(feature.ringsEnd - feature.ringsBegin);
 
-    auto it = layers.find(name);
-    if (it != layers.end()) {
-        return &it->second;
+    for (uint32_t ring = feature.ringsBegin; ring < feature.ringsEnd; ++ring) {
+        lines.emplace_back(coordinates.begin() + rings[ring],
+                           coordinates.begin() + rings[ring + 1]);
     }
-    return nullptr;
+
+    return lines;
 }
 
-VectorTileLayer::VectorTileLayer(protozero::pbf_reader layer_pbf) {
-    while (layer_pbf.next()) {
-        switch (layer_pbf.tag()) {
-        case 1: // name
-            name = layer_pbf.get_string();
-            break;
-        case 2: // feature
-            features.push_back(layer_pbf.get_message());
-            break;
-        case 3: // keys
-            {
-                auto iter = keysMap.emplace(layer_pbf.get_string(), keysMap.size());
-                keys.emplace_back(std::reference_wrapper<const std::string>(iter.first->first));
-            }
-            break;
-        case 4: // values
-            values.emplace_back(parseValue(layer_pbf.get_message()));
-            break;
-        case 5: // extent
-            extent = layer_pbf.get_uint32();
-            break;
-        case 15: // version
-            version = layer_pbf.get_uint32();
-            break;
-        default:
-            layer_pbf.skip();
+std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
+    return std::make_unique<VectorTileFeature>(*this, i);
+}
+
+void VectorTileLayer::eachFeature(std::function<bool (const GeometryTileFeature&, std::size_t)> fn) const {
+    VectorTileFeature feature(*this, 0);
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        feature.index = i;
+        if (!fn(feature, i)) {
             break;
         }
     }
 }
 
-std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
-    return std::make_unique<VectorTileFeature>(features.at(i), *this);
-}
-
 std::string VectorTileLayer::getName() const {
     return name;
 }
@@ -19,6 +19,7 @@ public:
                const Tileset&);
 
     void setNecessity(Necessity) final;
+    void setViewportCenter(const LatLng&) final;
     void setData(std::shared_ptr<const std::string> data,
                  optional<Timestamp> modified,
                  optional<Timestamp> expires);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <protozero/pbf_reader.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+class VectorTileLayer;
+
+class VectorTileData : public GeometryTileData {
+public:
+    VectorTileData(std::shared_ptr<const std::string> data);
+
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return std::make_unique<VectorTileData>(*this);
+    }
+
+    const GeometryTileLayer* getLayer(const std::string&) const override;
+
+    std::size_t getByteSize() const override {
+        return data ? data->size() : 0;
+    }
+
+private:
+    std::shared_ptr<const std::string> data;
+    mutable bool parsed = false;
+
+    // Layers are only decoded once they're requested. Decoded layers are immutable, so
+    // clones of this object share them.
+    mutable std::unordered_map<std::string, protozero::pbf_reader> encodedLayers;
+    mutable std::unordered_map<std::string, std::shared_ptr<const VectorTileLayer>> layers;
+};
+
+} // namespace mbgl
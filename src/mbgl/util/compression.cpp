@@ -2,6 +2,7 @@
 
 #include <zlib.h>
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -62,7 +63,9 @@ std::string decompress(const std::string &raw) {
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
     // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
+    // Adding 32 to the window size makes zlib detect and accept a gzip header as well as a
+    // zlib one; vector tiles are commonly stored gzipped, e.g. in MBTiles files.
+    if (inflateInit2(&inflate_stream, MAX_WBITS + 32) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
 
@@ -91,5 +94,9 @@ std::string decompress(const std::string &raw) {
 
     return result;
 }
+
+bool isGzip(const std::string& data) {
+    return data.size() >= 2 && static_cast<uint8_t>(data[0]) == 0x1F && static_cast<uint8_t>(data[1]) == 0x8B;
+}
 } // namespace util
 } // namespace mbgl
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mbgl/math/minmax.hpp>
+
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/box.hpp>
 
@@ -9,6 +11,9 @@
 
 namespace mbgl {
 
+// Elements are inserted first, and the cells are laid out by build(). The cells are stored
+// in a single array (compressed sparse rows): the elements in cell `i` are
+// `cellElements[cellOffsets[i]]` up to `cellElements[cellOffsets[i + 1]]`.
 template <class T>
 class GridIndex {
 public:
@@ -17,7 +22,53 @@ public:
     using BBox = mapbox::geometry::box<int16_t>;
 
     void insert(T&& t, const BBox&);
-    std::vector<T> query(const BBox&) const;
+
+    // Lays out the cells for the elements inserted so far. Needs to be called before querying.
+    void build();
+
+    // Calls `fn(element)` once for every element whose bounding box intersects `queryBBox`.
+    // Finds nothing while elements were inserted since the last call to build().
+    template <class Fn>
+    void query(const BBox& queryBBox, Fn&& fn) const {
+        if (!built) {
+            return;
+        }
+
+        const int32_t cx1 = convertToCellCoord(queryBBox.min.x);
+        const int32_t cy1 = convertToCellCoord(queryBBox.min.y);
+        const int32_t cx2 = convertToCellCoord(queryBBox.max.x);
+        const int32_t cy2 = convertToCellCoord(queryBBox.max.y);
+
+        for (int32_t x = cx1; x <= cx2; ++x) {
+            for (int32_t y = cy1; y <= cy2; ++y) {
+                const int32_t cellIndex = d * y + x;
+                for (uint32_t i = cellOffsets[cellIndex]; i < cellOffsets[cellIndex + 1]; ++i) {
+                    const auto& element = elements[cellElements[i]];
+                    const BBox& bbox = element.second;
+
+                    // An element is listed in every cell it covers. Only look at it in the
+                    // first of those that the query covers too.
+                    if (util::max(convertToCellCoord(bbox.min.x), cx1) != x ||
+                        util::max(convertToCellCoord(bbox.min.y), cy1) != y) {
+                        continue;
+                    }
+
+                    if (queryBBox.min.x <= bbox.max.x &&
+                        queryBBox.min.y <= bbox.max.y &&
+                        queryBBox.max.x >= bbox.min.x &&
+                        queryBBox.max.y >= bbox.min.y) {
+                        fn(element.first);
+                    }
+                }
+            }
+        }
+    }
+
+    // Every inserted element and its bounding box, in insertion order.
+    const std::vector<std::pair<T, BBox>>& getElements() const { return elements; }
+
+    // Approximate number of bytes used by the elements and cells.
+    std::size_t getByteSize() const;
 
 private:
     int32_t convertToCellCoord(int32_t x) const;
@@ -31,8 +82,9 @@ private:
     const int32_t max;
 
     std::vector<std::pair<T, BBox>> elements;
-    std::vector<std::vector<size_t>> cells;
-
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> cellElements;
+    bool built = false;
 };
 
 } // namespace mbgl
@@ -3,6 +3,8 @@
 #include <mbgl/util/interpolate.hpp>
 #include <mbgl/map/transform_state.hpp>
 
+#include <cassert>
+#include <cmath>
 #include <functional>
 
 namespace mbgl {
@@ -155,6 +157,46 @@ std::vector<UnwrappedTileID> tileCover(const LatLngBounds& bounds_, int32_t z) {
         z);
 }
 
+TileRange::TileRange(const LatLngBounds& bounds_, uint8_t z_) : z(z_) {
+    if (bounds_.isEmpty() ||
+        bounds_.south() >  util::LATITUDE_MAX ||
+        bounds_.north() < -util::LATITUDE_MAX) {
+        return;
+    }
+
+    LatLngBounds bounds = LatLngBounds::hull(
+        { std::max(bounds_.south(), -util::LATITUDE_MAX), bounds_.west() },
+        { std::min(bounds_.north(),  util::LATITUDE_MAX), bounds_.east() });
+
+    const Point<double> nw = TileCoordinate::fromLatLng(z, bounds.northwest()).p;
+    const Point<double> se = TileCoordinate::fromLatLng(z, bounds.southeast()).p;
+
+    // Bounds without height don't cover any tile; see scanTriangle().
+    if (se.y <= nw.y) {
+        return;
+    }
+
+    const double tiles = std::pow(2.0, z);
+
+    minX = std::floor(nw.x);
+    maxX = std::ceil(se.x);
+    minY = std::max(0.0, std::floor(nw.y));
+    maxY = std::min(tiles, std::ceil(se.y));
+}
+
+uint64_t TileRange::size() const {
+    if (maxX <= minX || maxY <= minY) {
+        return 0;
+    }
+    return uint64_t(maxX - minX) * uint64_t(maxY - minY);
+}
+
+UnwrappedTileID TileRange::operator[](uint64_t index) const {
+    assert(index < size());
+    const uint64_t height = maxY - minY;
+    return { z, minX + int64_t(index / height), minY + int64_t(index % height) };
+}
+
 std::vector<UnwrappedTileID> tileCover(const TransformState& state, int32_t z) {
     const double w = state.getSize().width;
     const double h = state.getSize().height;
@@ -18,5 +18,26 @@ int32_t coveringZoomLevel(double z, SourceType type, uint16_t tileSize);
 std::vector<UnwrappedTileID> tileCover(const TransformState&, int32_t z);
 std::vector<UnwrappedTileID> tileCover(const LatLngBounds&, int32_t z);
 
+// The tiles covering a LatLngBounds at a single zoom level. This is the same set of tiles
+// as tileCover(bounds, z) returns, but it is counted in constant time and enumerated on
+// demand, in the order x, then y, rather than materialized and sorted by distance from
+// the center.
+class TileRange {
+public:
+    TileRange(const LatLngBounds&, uint8_t z);
+
+    uint64_t size() const;
+
+    // `index` must be less than size().
+    UnwrappedTileID operator[](uint64_t index) const;
+
+private:
+    uint8_t z;
+
+    // Half-open ranges of tile coordinates. x is unwrapped, like the tiles tileCover() returns.
+    int64_t minX = 0, maxX = 0;
+    int64_t minY = 0, maxY = 0;
+};
+
 } // namespace util
 } // namespace mbgl
@@ -0,0 +1,117 @@
+#include <mbgl/util/tracing.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace tracing {
+
+namespace {
+
+class Event {
+public:
+    const char* category;
+    std::string name;
+    TimePoint begin;
+    TimePoint end;
+    std::thread::id thread;
+};
+
+class Recorder {
+public:
+    std::atomic<bool> enabled { false };
+
+    std::mutex mutex;
+    TimePoint origin;
+    std::vector<Event> events;
+};
+
+Recorder& recorder() {
+    static Recorder instance;
+    return instance;
+}
+
+} // namespace
+
+void start() {
+    Recorder& r = recorder();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.events.clear();
+    r.origin = Clock::now();
+    r.enabled = true;
+}
+
+std::string stop() {
+    Recorder& r = recorder();
+
+    std::vector<Event> events;
+    TimePoint origin;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.enabled = false;
+        events.swap(r.events);
+        origin = r.origin;
+    }
+
+    auto micros = [&] (Duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    // Chrome's viewer wants small integer thread IDs.
+    std::unordered_map<std::thread::id, uint64_t> threads;
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    for (const auto& event : events) {
+        auto thread = threads.emplace(event.thread, threads.size() + 1).first->second;
+
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(event.name.data(), rapidjson::SizeType(event.name.size()));
+        writer.Key("cat");
+        writer.String(event.category);
+        writer.Key("ph");
+        writer.String("X");
+        writer.Key("ts");
+        writer.Double(micros(event.begin - origin));
+        writer.Key("dur");
+        writer.Double(micros(event.end - event.begin));
+        writer.Key("pid");
+        writer.Uint(1);
+        writer.Key("tid");
+        writer.Uint64(thread);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.EndObject();
+
+    return { buffer.GetString(), buffer.GetSize() };
+}
+
+bool isEnabled() {
+    return recorder().enabled;
+}
+
+void record(const char* category, std::string name, TimePoint begin, TimePoint end) {
+    Recorder& r = recorder();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (!r.enabled) {
+        return;
+    }
+    r.events.push_back({ category, std::move(name), begin, end, std::this_thread::get_id() });
+}
+
+} // namespace tracing
+} // namespace mbgl
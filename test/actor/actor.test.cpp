@@ -6,6 +6,8 @@
 #include <chrono>
 #include <functional>
 #include <future>
+#include <thread>
+#include <vector>
 
 using namespace mbgl;
 using namespace std::chrono_literals;
@@ -102,6 +104,54 @@ TEST(Actor, OrderedMailbox) {
     endedFuture.wait();
 }
 
+TEST(Actor, OrderedMailboxWithConcurrentSenders) {
+    // Messages sent from several threads at once all arrive, in order per sender.
+
+    struct Test {
+        std::vector<int> last;
+        int remaining;
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, int senders, int remaining_, std::promise<void> promise_)
+            : last(senders, 0),
+              remaining(remaining_),
+              promise(std::move(promise_)) {
+        }
+
+        void receive(int sender, int i) {
+            EXPECT_EQ(i, last[sender] + 1);
+            last[sender] = i;
+            if (--remaining == 0) {
+                promise.set_value();
+            }
+        }
+    };
+
+    const int senders = 4;
+    const int messages = 10000;
+
+    ThreadPool pool { 2 };
+
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+    Actor<Test> test(pool, senders, senders * messages, std::move(endedPromise));
+
+    std::vector<std::thread> threads;
+    for (int sender = 0; sender < senders; ++sender) {
+        threads.emplace_back([&, sender] {
+            ActorRef<Test> ref = test.self();
+            for (int i = 1; i <= messages; ++i) {
+                ref.invoke(&Test::receive, sender, i);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    endedFuture.wait();
+}
+
 TEST(Actor, NonConcurrentMailbox) {
     // An individual actor is never itself concurrent.
 
@@ -137,3 +187,107 @@ TEST(Actor, NonConcurrentMailbox) {
     test.invoke(&Test::end);
     endedFuture.wait();
 }
+
+TEST(Actor, WorkStealingNonConcurrentMailbox) {
+    // Mailboxes stay ordered and non-concurrent when other threads steal their work.
+
+    struct Test {
+        int last = 0;
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, std::promise<void> promise_)
+            : promise(std::move(promise_))  {
+        }
+
+        void receive(int i) {
+            EXPECT_EQ(i, last + 1);
+            last = i;
+        }
+
+        void end() {
+            promise.set_value();
+        }
+    };
+
+    WorkStealingThreadPool pool { 4 };
+
+    std::vector<std::future<void>> endedFutures;
+    std::vector<std::unique_ptr<Actor<Test>>> tests;
+    for (auto i = 0; i < 16; ++i) {
+        std::promise<void> endedPromise;
+        endedFutures.push_back(endedPromise.get_future());
+        tests.push_back(std::make_unique<Actor<Test>>(pool, std::move(endedPromise)));
+    }
+
+    for (auto i = 1; i <= 100; ++i) {
+        for (auto& test : tests) {
+            test->invoke(&Test::receive, i);
+        }
+    }
+
+    for (auto& test : tests) {
+        test->invoke(&Test::end);
+    }
+
+    for (auto& endedFuture : endedFutures) {
+        endedFuture.wait();
+    }
+}
+
+TEST(Actor, WorkStealingPriority) {
+    // Mailboxes with a higher priority are processed first.
+
+    struct Blocker {
+        Blocker(ActorRef<Blocker>) {}
+
+        void wait(std::promise<void> entered, std::shared_future<void> release) {
+            entered.set_value();
+            release.wait();
+        }
+    };
+
+    struct Test {
+        std::vector<std::string>& log;
+        std::string name;
+
+        Test(ActorRef<Test>, std::vector<std::string>& log_, std::string name_)
+            : log(log_), name(std::move(name_)) {
+        }
+
+        void receive(std::promise<void> done) {
+            log.push_back(name);
+            done.set_value();
+        }
+    };
+
+    WorkStealingThreadPool pool { 1 };
+    std::vector<std::string> log;
+
+    Actor<Blocker> blocker(pool);
+    Actor<Test> low(pool, std::ref(log), "low");
+    Actor<Test> high(pool, std::ref(log), "high");
+    low.setPriority(Scheduler::Priority::Low);
+    high.setPriority(Scheduler::Priority::High);
+
+    std::promise<void> entered;
+    std::future<void> enteredFuture = entered.get_future();
+    std::promise<void> release;
+    blocker.invoke(&Blocker::wait, std::move(entered), release.get_future().share());
+    enteredFuture.wait();
+
+    std::promise<void> lowDone;
+    std::future<void> lowFuture = lowDone.get_future();
+    low.invoke(&Test::receive, std::move(lowDone));
+
+    std::promise<void> highDone;
+    std::future<void> highFuture = highDone.get_future();
+    high.invoke(&Test::receive, std::move(highDone));
+
+    release.set_value();
+    lowFuture.wait();
+    highFuture.wait();
+
+    ASSERT_EQ(2u, log.size());
+    EXPECT_EQ("high", log[0]);
+    EXPECT_EQ("low", log[1]);
+}
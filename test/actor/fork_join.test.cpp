@@ -0,0 +1,81 @@
+#include <mbgl/actor/fork_join.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ForkJoin, RunsEveryTaskOnce) {
+    WorkStealingThreadPool pool { 4 };
+
+    std::vector<int> counts(1000, 0);
+    forkJoin(pool, counts.size(), [&] (std::size_t i) {
+        ++counts[i];
+    });
+
+    for (int count : counts) {
+        EXPECT_EQ(1, count);
+    }
+}
+
+TEST(ForkJoin, RunsInlineOnOwnRunLoop) {
+    // The helpers can't run before the caller returns, so the caller has to do all of
+    // the work itself.
+    util::RunLoop loop;
+
+    std::size_t sum = 0;
+    forkJoin(*util::RunLoop::Get(), 10, [&] (std::size_t i) {
+        sum += i;
+    });
+
+    EXPECT_EQ(45u, sum);
+}
+
+TEST(ForkJoin, FromWithinSchedulerThread) {
+    // An actor forking work onto the single-threaded pool it's running on must not deadlock.
+
+    struct Test {
+        Test(ActorRef<Test>, Scheduler& scheduler_)
+            : scheduler(scheduler_) {
+        }
+
+        void run(std::promise<std::size_t> promise) {
+            std::atomic<std::size_t> sum { 0 };
+            forkJoin(scheduler, 100, [&] (std::size_t i) {
+                sum += i;
+            });
+            promise.set_value(sum);
+        }
+
+        Scheduler& scheduler;
+    };
+
+    WorkStealingThreadPool pool { 1 };
+    Actor<Test> test(pool, std::ref(pool));
+
+    std::promise<std::size_t> promise;
+    auto result = promise.get_future();
+    test.invoke(&Test::run, std::move(promise));
+    EXPECT_EQ(4950u, result.get());
+}
+
+TEST(ForkJoin, RethrowsTaskExceptions) {
+    WorkStealingThreadPool pool { 2 };
+
+    std::atomic<std::size_t> completed { 0 };
+    EXPECT_THROW(forkJoin(pool, 8, [&] (std::size_t i) {
+        if (i == 3) {
+            throw std::runtime_error("task failed");
+        }
+        ++completed;
+    }), std::runtime_error);
+
+    EXPECT_EQ(7u, completed);
+}
@@ -1,10 +1,16 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/stub_file_source.hpp>
+#include <mbgl/test/stub_tile_observer.hpp>
 
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
 #include <mbgl/sprite/sprite_image.hpp>
 #include <mbgl/map/map.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/style/update_parameters.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
 #include <mbgl/util/io.hpp>
@@ -165,6 +171,21 @@ TEST(Annotations, AddMultiple) {
     test.checkRendering("add_multiple");
 }
 
+TEST(Annotations, AddMultipleInBatch) {
+    AnnotationTest test;
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationIcon("default_marker", namedMarker("default_marker.png"));
+    AnnotationIDs ids = test.map.addAnnotations({
+        SymbolAnnotation { Point<double> { -10, 0 }, "default_marker" },
+        SymbolAnnotation { Point<double> { 10, 0 }, "default_marker" }
+    });
+    EXPECT_EQ(2u, ids.size());
+    EXPECT_NE(ids[0], ids[1]);
+
+    test.checkRendering("add_multiple");
+}
+
 TEST(Annotations, NonImmediateAdd) {
     AnnotationTest test;
 
@@ -193,6 +214,25 @@ TEST(Annotations, UpdateSymbolAnnotationGeometry) {
     test.checkRendering("update_point");
 }
 
+TEST(Annotations, UpdateSymbolAnnotationGeometryInBatch) {
+    AnnotationTest test;
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationIcon("default_marker", namedMarker("default_marker.png"));
+    AnnotationIDs points = test.map.addAnnotations({
+        SymbolAnnotation { Point<double> { 0, 0 }, "default_marker" },
+        SymbolAnnotation { Point<double> { 0, 0 }, "default_marker" }
+    });
+
+    test::render(test.map, test.view);
+
+    test.map.updateAnnotations({
+        { points[0], SymbolAnnotation { Point<double> { -10, 0 }, "default_marker" } },
+        { points[1], SymbolAnnotation { Point<double> { 10, 0 }, "default_marker" } }
+    });
+    test.checkRendering("add_multiple");
+}
+
 TEST(Annotations, UpdateSymbolAnnotationIcon) {
     AnnotationTest test;
 
@@ -288,6 +328,27 @@ TEST(Annotations, RemovePoint) {
     test.checkRendering("remove_point");
 }
 
+TEST(Annotations, RemoveInBatch) {
+    AnnotationTest test;
+
+    LineString<double> line = {{ { 0, 0 }, { 45, 45 } }};
+    LineAnnotation annotation { line };
+    annotation.color = Color::red();
+    annotation.width = { 5 };
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationIcon("default_marker", namedMarker("default_marker.png"));
+    AnnotationIDs ids = test.map.addAnnotations({
+        SymbolAnnotation { Point<double> { 0, 0 }, "default_marker" },
+        annotation
+    });
+
+    test::render(test.map, test.view);
+
+    test.map.removeAnnotations(ids);
+    test.checkRendering("remove_shape");
+}
+
 TEST(Annotations, RemoveShape) {
     AnnotationTest test;
 
@@ -305,6 +366,54 @@ TEST(Annotations, RemoveShape) {
     test.checkRendering("remove_shape");
 }
 
+TEST(Annotations, UpdateOnlyAffectedTiles) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    TransformState transformState;
+    ThreadPool threadPool { 1 };
+    AnnotationManager annotationManager { 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
+
+    style::UpdateParameters updateParameters {
+        1.0,
+        MapDebugOptions(),
+        transformState,
+        threadPool,
+        fileSource,
+        MapMode::Continuous,
+        annotationManager,
+        style
+    };
+
+    // A marker in the north western and one in the south eastern quarter of the world.
+    AnnotationID point = annotationManager.addAnnotation(SymbolAnnotation { Point<double> { -90, 45 }, "default_marker" }, 16);
+    annotationManager.addAnnotation(SymbolAnnotation { Point<double> { 90, -45 }, "default_marker" }, 16);
+    annotationManager.updateData();
+
+    StubTileObserver observer;
+    AnnotationTile northWest(OverscaledTileID(1, 0, 0), updateParameters);
+    AnnotationTile southEast(OverscaledTileID(1, 1, 1), updateParameters);
+    for (AnnotationTile* tile : { &northWest, &southEast }) {
+        tile->setObserver(&observer);
+        tile->setPlacementConfig({});
+    }
+
+    while (!northWest.isComplete() || !southEast.isComplete()) {
+        loop.runOnce();
+    }
+
+    // Giving a tile new data sends it back to the worker, so only the tile the marker moves
+    // within is pending again.
+    annotationManager.updateAnnotation(point, SymbolAnnotation { Point<double> { -80, 40 }, "default_marker" }, 16);
+    annotationManager.updateData();
+    EXPECT_FALSE(northWest.isComplete());
+    EXPECT_TRUE(southEast.isComplete());
+
+    while (!northWest.isComplete()) {
+        loop.runOnce();
+    }
+}
+
 TEST(Annotations, ImmediateRemoveShape) {
     AnnotationTest test;
 
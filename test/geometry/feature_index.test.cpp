@@ -0,0 +1,77 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_file_source.hpp>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+void addFeature(AnnotationTileData& data, const std::string& layer, AnnotationID id) {
+    data.layers.emplace(layer, layer).first->second.features.emplace_back(
+        id, FeatureType::Point, GeometryCollection { { { 100, 100 } } });
+}
+
+// The IDs of the features found for the given style layer, in the order they were found.
+std::vector<uint64_t> ids(const std::unordered_map<std::string, std::vector<Feature>>& result,
+                          const std::string& layerID) {
+    std::vector<uint64_t> found;
+    auto it = result.find(layerID);
+    if (it != result.end()) {
+        for (const auto& feature : it->second) {
+            found.push_back(feature.id->get<uint64_t>());
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+TEST(FeatureIndex, InsertIndex) {
+    util::RunLoop loop;
+
+    ThreadPool threadPool { 1 };
+    StubFileSource fileSource;
+    Style style { threadPool, fileSource, 1.0 };
+    // Symbol layers match features regardless of their geometry.
+    style.addLayer(std::make_unique<SymbolLayer>("A", "source"));
+    style.addLayer(std::make_unique<SymbolLayer>("B", "source"));
+
+    // Source layer "roads" holds features 1 and 2, "water" holds feature 3.
+    AnnotationTileData data;
+    addFeature(data, "roads", 1);
+    addFeature(data, "roads", 2);
+    addFeature(data, "water", 3);
+
+    const GeometryCollection geometry { { { 100, 100 } } };
+
+    FeatureIndex index;
+    index.insert(geometry, 0, "roads", "a");
+
+    // Lists the names in a different order than `index`, and comes back to one it already has.
+    FeatureIndex other;
+    other.insert(geometry, 0, "water", "b");
+    other.insert(geometry, 1, "roads", "a");
+    other.insert(geometry, 0, "water", "b");
+
+    index.insert(other);
+    index.setBucketLayerIDs("a", { "A" });
+    index.setBucketLayerIDs("b", { "B" });
+    index.build();
+
+    std::unordered_map<std::string, std::vector<Feature>> result;
+    index.query(result, { { 0, 0 }, { 8192, 8192 } }, 0, util::tileSize, 1, {},
+                data, CanonicalTileID(0, 0, 0), style, nullptr);
+
+    // Features of the inserted index come after the existing ones and are returned first.
+    EXPECT_EQ((std::vector<uint64_t>{ 2, 1 }), ids(result, "A"));
+    EXPECT_EQ((std::vector<uint64_t>{ 3, 3 }), ids(result, "B"));
+}
@@ -0,0 +1,105 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+
+TEST(GLBufferArena, Allocate) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    OffscreenView view(backend.getContext());
+
+    gl::Context context;
+    const std::vector<uint8_t> data(2048, 0);
+
+    gl::BufferArena arena(context, gl::BufferType::Vertex, 1024);
+
+    gl::BufferRange a = arena.allocate(data.data(), 100, 1);
+    gl::BufferRange b = arena.allocate(data.data(), 100, 12);
+    EXPECT_NE(0u, a.buffer);
+    EXPECT_EQ(a.buffer, b.buffer);
+    EXPECT_EQ(0u, a.offset);
+    EXPECT_EQ(108u, b.offset);
+
+    gl::BufferRange c = arena.allocate(data.data(), 256, 4);
+    EXPECT_EQ(a.buffer, c.buffer);
+    EXPECT_EQ(208u, c.offset);
+
+    auto stats = arena.getStatistics();
+    EXPECT_EQ(1u, stats.pages);
+    EXPECT_EQ(1024u, stats.capacity);
+    EXPECT_EQ(456u, stats.used);
+    EXPECT_EQ(2u, stats.freeRanges); // The alignment padding of `b`, and the rest of the page.
+    EXPECT_EQ(560u, stats.largestFreeRange);
+    EXPECT_NEAR(1 - 560.0 / 568.0, stats.fragmentation(), 1e-9);
+
+    // Freed ranges are merged with their free neighbours, and reused.
+    a = {};
+    stats = arena.getStatistics();
+    EXPECT_EQ(356u, stats.used);
+    EXPECT_EQ(2u, stats.freeRanges);
+
+    gl::BufferRange d = arena.allocate(data.data(), 104, 4);
+    EXPECT_EQ(b.buffer, d.buffer);
+    EXPECT_EQ(0u, d.offset);
+
+    // Allocations larger than a page get a page of their own.
+    gl::BufferRange e = arena.allocate(data.data(), 2048, 1);
+    EXPECT_NE(b.buffer, e.buffer);
+    EXPECT_EQ(0u, e.offset);
+    EXPECT_EQ(2u, arena.getStatistics().pages);
+    EXPECT_EQ(3072u, arena.getStatistics().capacity);
+
+    // Empty pages are only deleted on request.
+    e = {};
+    EXPECT_EQ(2u, arena.getStatistics().pages);
+    arena.releaseEmptyPages();
+    EXPECT_EQ(1u, arena.getStatistics().pages);
+    EXPECT_EQ(460u, arena.getStatistics().used);
+}
+
+TEST(GLBufferArena, ReleaseAllPages) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    OffscreenView view(backend.getContext());
+
+    gl::Context context;
+    const std::vector<uint8_t> data(256, 0);
+
+    gl::BufferArena arena(context, gl::BufferType::Vertex, 1024);
+    gl::BufferRange a = arena.allocate(data.data(), 100, 1);
+    gl::BufferRange b = arena.allocate(data.data(), 100, 1);
+
+    // Pages are deleted even though they are in use; returning their ranges afterwards
+    // doesn't touch the pages allocated since.
+    arena.releaseAllPages();
+    EXPECT_EQ(0u, arena.getStatistics().pages);
+
+    gl::BufferRange c = arena.allocate(data.data(), 200, 1);
+    a = {};
+    b = {};
+    EXPECT_EQ(1u, arena.getStatistics().pages);
+    EXPECT_EQ(200u, arena.getStatistics().used);
+    EXPECT_EQ(0u, c.offset);
+}
+
+TEST(GLBufferArena, ContextReset) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    OffscreenView view(backend.getContext());
+
+    gl::Context context;
+
+    gl::IndexVector<gl::Triangles> indexes;
+    indexes.emplace_back(0, 1, 2);
+    gl::IndexBuffer<gl::Triangles> buffer = context.createIndexBuffer(std::move(indexes));
+    EXPECT_EQ(1u, context.getBufferArenaStatistics(gl::BufferType::Index).pages);
+
+    // Resetting the context deletes the buffers that are still in use, too.
+    context.reset();
+    EXPECT_EQ(0u, context.getBufferArenaStatistics(gl::BufferType::Index).pages);
+    EXPECT_TRUE(context.empty());
+}
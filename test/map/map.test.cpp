@@ -15,6 +15,8 @@
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/async_task.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/source_impl.hpp>
 #include <mbgl/util/color.hpp>
 
 using namespace mbgl;
@@ -271,6 +273,103 @@ TEST(Map, RemoveLayer) {
     test::checkImage("test/fixtures/map/remove_layer", test::render(map, test.view));
 }
 
+TEST(Map, SourceTileCacheBudget) {
+    MapTest test;
+
+    // The budget is set before there is a style to apply it to.
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+    map.setSourceTileCacheBudget(1024);
+
+    map.setStyleJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "parsed": { "type": "geojson", "data": { "type": "FeatureCollection", "features": [] } }
+      },
+      "layers": []
+    })STYLE");
+    EXPECT_EQ(1024u, map.getSource("parsed")->baseImpl->getCacheBudget());
+
+    map.addSource(std::make_unique<GeoJSONSource>("added"));
+    EXPECT_EQ(1024u, map.getSource("added")->baseImpl->getCacheBudget());
+
+    // A new style keeps the budget.
+    map.setStyleJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "reloaded": { "type": "geojson", "data": { "type": "FeatureCollection", "features": [] } }
+      },
+      "layers": []
+    })STYLE");
+    EXPECT_EQ(1024u, map.getSource("reloaded")->baseImpl->getCacheBudget());
+}
+
+TEST(Map, RenderStats) {
+    MapTest test;
+
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+    EXPECT_EQ(0u, map.getRenderStats().drawCalls);
+
+    map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    auto layer = std::make_unique<BackgroundLayer>("background");
+    layer->setBackgroundColor({{ 1, 0, 0, 1 }});
+    map.addLayer(std::move(layer));
+
+    test::render(map, test.view);
+
+    RenderStats stats = map.getRenderStats();
+    EXPECT_GT(stats.drawCalls, 0u);
+    EXPECT_GT(stats.stateChanges, 0u);
+    EXPECT_GT(stats.bufferBytesUploaded, 0u);
+    EXPECT_GT(stats.bufferBytesAllocated, 0u);
+    EXPECT_GE(stats.bufferBytesCapacity, stats.bufferBytesAllocated);
+    EXPECT_GE(stats.totalTime, stats.opaqueTime + stats.translucentTime);
+    EXPECT_EQ(0u, stats.glyphsRendered);
+    EXPECT_TRUE(stats.tilesRendered.empty());
+}
+
+TEST(Map, RenderStillTiles) {
+    MapTest test;
+
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+    map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    auto layer = std::make_unique<BackgroundLayer>("background");
+    layer->setBackgroundColor({{ 1, 0, 0, 1 }});
+    map.addLayer(std::move(layer));
+
+    // A polygon that straddles the tile edges, so that each tile looks different.
+    FillAnnotation polygon { Polygon<double> {{ {{ { -20, -20 }, { 60, -10 }, { 40, 50 } }} }} };
+    polygon.color = Color::blue();
+    map.addAnnotation(polygon);
+
+    auto expected = test::render(map, test.view);
+
+    std::vector<PremultipliedImage> tiles;
+    map.renderStillTiles(test.view, { 2, 2 }, [&](std::exception_ptr error, std::vector<PremultipliedImage> result) {
+        ASSERT_FALSE(error);
+        tiles = std::move(result);
+        test.runLoop.stop();
+    });
+    test.runLoop.run();
+
+    ASSERT_EQ(4u, tiles.size());
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const auto& tile = tiles[i];
+        ASSERT_EQ(Size(128, 128), tile.size);
+        for (uint32_t row = 0; row < tile.size.height; ++row) {
+            const uint8_t* source = expected.data.get() +
+                ((i / 2) * tile.size.height + row) * expected.stride() + (i % 2) * tile.stride();
+            ASSERT_TRUE(std::equal(source, source + tile.stride(), tile.data.get() + row * tile.stride()));
+        }
+    }
+
+    map.renderStillTiles(test.view, { 3, 3 }, [&](std::exception_ptr error, std::vector<PremultipliedImage> result) {
+        EXPECT_TRUE(error);
+        EXPECT_TRUE(result.empty());
+    });
+}
+
 TEST(Map, DisabledSources) {
     MapTest test;
 
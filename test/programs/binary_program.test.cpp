@@ -0,0 +1,133 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/fixture_log_observer.hpp>
+
+#include <mbgl/programs/binary_program.hpp>
+#include <mbgl/programs/program_parameters.hpp>
+#include <mbgl/programs/programs.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(BinaryProgram, Serialization) {
+    const std::string identifier = BinaryProgram::identifierFor("vertex", "fragment");
+    const BinaryProgram binaryProgram(0x8741, std::string("binary\0code", 11), identifier);
+
+    const BinaryProgram restored(binaryProgram.serialize());
+    EXPECT_EQ(0x8741u, restored.format());
+    EXPECT_EQ(std::string("binary\0code", 11), restored.code());
+    EXPECT_EQ(identifier, restored.identifier());
+
+    EXPECT_THROW(BinaryProgram(std::string("garbage")), std::runtime_error);
+    EXPECT_THROW(BinaryProgram(binaryProgram.serialize().substr(0, 12)), std::runtime_error);
+
+    // Cut short in the code.
+    std::string data = binaryProgram.serialize();
+    EXPECT_THROW(BinaryProgram(data.substr(0, data.size() - 1)), std::runtime_error);
+
+    // Overwritten, or followed by parts of another binary.
+    data.back() = 'x';
+    EXPECT_THROW(BinaryProgram { data }, std::runtime_error);
+    EXPECT_THROW(BinaryProgram(binaryProgram.serialize() + "e"), std::runtime_error);
+}
+
+TEST(BinaryProgram, TEST_REQUIRES_WRITE(SaveAndLoad)) {
+    const std::string path = "test/fixtures/binary_program.bin";
+    const std::string identifier = BinaryProgram::identifierFor("vertex", "fragment");
+    BinaryProgram(0x8741, "code", identifier).save(path);
+
+    auto loaded = BinaryProgram::load(path, identifier);
+    ASSERT_TRUE(bool(loaded));
+    EXPECT_EQ("code", loaded->code());
+
+    EXPECT_FALSE(bool(BinaryProgram::load(path, BinaryProgram::identifierFor("vertex", "fragment2"))));
+
+    util::write_file(path, loaded->serialize().substr(0, 40));
+    EXPECT_FALSE(bool(BinaryProgram::load(path, identifier)));
+
+    util::deleteFile(path);
+    EXPECT_FALSE(bool(BinaryProgram::load(path, identifier)));
+}
+
+TEST(BinaryProgram, TEST_REQUIRES_WRITE(ConcurrentSave)) {
+    // Threads of one process caching the same program must not write to the same
+    // temporary file.
+    FixtureLog log;
+    const std::string path = "test/fixtures/binary_program_concurrent.bin";
+    const std::string identifier = BinaryProgram::identifierFor("vertex", "fragment");
+    const std::string code(1 << 20, 'x');
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 4; ++j) {
+                BinaryProgram(0x8741, std::string(code), identifier).save(path);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto loaded = BinaryProgram::load(path, identifier);
+    ASSERT_TRUE(bool(loaded));
+    EXPECT_EQ(code, loaded->code());
+    EXPECT_TRUE(log.empty());
+
+    util::deleteFile(path);
+}
+
+TEST(BinaryProgram, Identifier) {
+    EXPECT_EQ(BinaryProgram::identifierFor("vertex", "fragment"),
+              BinaryProgram::identifierFor("vertex", "fragment"));
+    EXPECT_NE(BinaryProgram::identifierFor("vertex", "fragment"),
+              BinaryProgram::identifierFor("vertex", "fragment2"));
+}
+
+TEST(BinaryProgram, CachePath) {
+    EXPECT_FALSE(ProgramParameters(1.0, false).cachePath("fill"));
+    EXPECT_EQ(std::string("cache/mbgl-program-fill-2-overdraw.bin"),
+              *ProgramParameters(2.0, true, std::string("cache")).cachePath("fill"));
+}
+
+TEST(BinaryProgram, TEST_REQUIRES_WRITE(LazyProgram)) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    OffscreenView view(backend.getContext());
+    gl::Context context;
+
+    const ProgramParameters parameters(1.0, false, std::string("test/fixtures"));
+    const std::string path = *parameters.cachePath("debug");
+    const std::string identifier = BinaryProgram::identifierFor(DebugProgram::vertexSource(parameters),
+                                                                DebugProgram::fragmentSource(parameters));
+    try {
+        util::deleteFile(path);
+    } catch (const util::IOException&) {
+    }
+
+    // Nothing is compiled until the program is used.
+    LazyProgram<DebugProgram> program(context, parameters);
+    EXPECT_FALSE(bool(BinaryProgram::load(path, identifier)));
+    program.get();
+
+    if (context.supportsProgramBinaries()) {
+        auto cached = BinaryProgram::load(path, identifier);
+        ASSERT_TRUE(bool(cached));
+
+        // A binary the driver rejects is replaced by one compiled from the sources.
+        BinaryProgram(cached->format(), "garbage", identifier).save(path);
+        LazyProgram<DebugProgram>(context, parameters).get();
+        auto recompiled = BinaryProgram::load(path, identifier);
+        ASSERT_TRUE(bool(recompiled));
+        EXPECT_NE("garbage", recompiled->code());
+
+        util::deleteFile(path);
+    }
+
+    backend.deactivate();
+}
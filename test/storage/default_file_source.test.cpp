@@ -1,9 +1,30 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 using namespace mbgl;
 
+namespace {
+
+const std::string cachePath = "test/fixtures/offline_database/write_behind.db";
+
+void deleteCache() {
+    try {
+        util::deleteFile(cachePath);
+    } catch (const util::IOException& ex) {
+        ASSERT_EQ(ENOENT, ex.code);
+    }
+}
+
+// Reads straight from the cache database, bypassing the file source's pending writes.
+optional<Response> getStored(const Resource& resource) {
+    return OfflineDatabase(cachePath).get(resource);
+}
+
+} // namespace
+
 TEST(DefaultFileSource, TEST_REQUIRES_SERVER(CacheResponse)) {
     util::RunLoop loop;
     DefaultFileSource fs(":memory:", ".");
@@ -460,3 +481,197 @@ TEST(DefaultFileSource, TEST_REQUIRES_SERVER(NoCacheRefreshModifiedModified)) {
 
     loop.run();
 }
+
+TEST(DefaultFileSource, TEST_REQUIRES_SERVER(PendingWriteServedFromQueue)) {
+    deleteCache();
+
+    util::RunLoop loop;
+    DefaultFileSource fs(cachePath, ".");
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/cache" };
+    Resource optionalResource = resource;
+    optionalResource.necessity = Resource::Optional;
+
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+
+    req1 = fs.request(resource, [&](Response res) {
+        req1.reset();
+        ASSERT_TRUE(res.data.get());
+        const std::string data = *res.data;
+
+        // The response is queued rather than written to the database right away...
+        EXPECT_FALSE(bool(getStored(resource)));
+
+        // ...but it is already used to answer requests.
+        req2 = fs.request(optionalResource, [&, data](Response res2) {
+            req2.reset();
+            EXPECT_EQ(nullptr, res2.error);
+            ASSERT_TRUE(res2.data.get());
+            EXPECT_EQ(data, *res2.data);
+            EXPECT_TRUE(bool(res2.expires));
+            loop.stop();
+        });
+    });
+
+    loop.run();
+}
+
+TEST(DefaultFileSource, TEST_REQUIRES_SERVER(PendingWritesCoalesce)) {
+    deleteCache();
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/revalidate-etag" };
+    Resource optionalResource = resource;
+    optionalResource.necessity = Resource::Optional;
+    std::string latest;
+
+    {
+        util::RunLoop loop;
+        DefaultFileSource fs(cachePath, ".");
+
+        std::unique_ptr<AsyncRequest> req1;
+        std::unique_ptr<AsyncRequest> req2;
+        std::unique_ptr<AsyncRequest> req3;
+        uint16_t counter = 0;
+
+        req1 = fs.request(resource, [&](Response res) {
+            req1.reset();
+            ASSERT_TRUE(res.data.get());
+            const std::string first = *res.data;
+
+            // Answered from the queue first, then revalidated with a new response that replaces
+            // the queued one.
+            req2 = fs.request(resource, [&, first](Response res2) {
+                if (counter++ == 0) {
+                    ASSERT_TRUE(res2.data.get());
+                    EXPECT_EQ(first, *res2.data);
+                    return;
+                }
+
+                req2.reset();
+                ASSERT_TRUE(res2.data.get());
+                EXPECT_NE(first, *res2.data);
+                latest = *res2.data;
+
+                req3 = fs.request(optionalResource, [&](Response res3) {
+                    req3.reset();
+                    ASSERT_TRUE(res3.data.get());
+                    EXPECT_EQ(latest, *res3.data);
+                    loop.stop();
+                });
+            });
+        });
+
+        loop.run();
+    }
+
+    // Shutting down the file source writes out what was still queued: only the newest response.
+    auto stored = getStored(resource);
+    ASSERT_TRUE(bool(stored));
+    ASSERT_TRUE(stored->data.get());
+    EXPECT_EQ(latest, *stored->data);
+}
+
+TEST(DefaultFileSource, TEST_REQUIRES_SERVER(PendingWriteNotModified)) {
+    deleteCache();
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/revalidate-same" };
+    Resource optionalResource = resource;
+    optionalResource.necessity = Resource::Optional;
+
+    {
+        util::RunLoop loop;
+        DefaultFileSource fs(cachePath, ".");
+
+        std::unique_ptr<AsyncRequest> req1;
+        std::unique_ptr<AsyncRequest> req2;
+        std::unique_ptr<AsyncRequest> req3;
+        uint16_t counter = 0;
+
+        req1 = fs.request(resource, [&](Response res) {
+            req1.reset();
+            EXPECT_FALSE(bool(res.expires));
+
+            req2 = fs.request(resource, [&](Response res2) {
+                if (counter++ == 0) {
+                    return;
+                }
+
+                req2.reset();
+                EXPECT_TRUE(res2.notModified);
+                ASSERT_TRUE(bool(res2.expires));
+                const Timestamp expires = *res2.expires;
+
+                // The 304 only moves the expiration of the queued response; its data stays.
+                req3 = fs.request(optionalResource, [&, expires](Response res3) {
+                    req3.reset();
+                    EXPECT_FALSE(res3.notModified);
+                    ASSERT_TRUE(res3.data.get());
+                    EXPECT_EQ("Response", *res3.data);
+                    EXPECT_EQ("snowfall", *res3.etag);
+                    EXPECT_EQ(expires, *res3.expires);
+                    loop.stop();
+                });
+            });
+        });
+
+        loop.run();
+    }
+
+    auto stored = getStored(resource);
+    ASSERT_TRUE(bool(stored));
+    ASSERT_TRUE(stored->data.get());
+    EXPECT_EQ("Response", *stored->data);
+    EXPECT_EQ("snowfall", *stored->etag);
+    EXPECT_TRUE(bool(stored->expires));
+}
+
+TEST(DefaultFileSource, TEST_REQUIRES_SERVER(PutFlushesPendingWrites)) {
+    deleteCache();
+
+    util::RunLoop loop;
+    DefaultFileSource fs(cachePath, ".");
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/cache" };
+    std::unique_ptr<AsyncRequest> req;
+
+    req = fs.request(resource, [&](Response) {
+        req.reset();
+        loop.stop();
+    });
+
+    loop.run();
+
+    Response response;
+    response.data = std::make_shared<std::string>("Put");
+    fs.put({ Resource::Unknown, "http://127.0.0.1:3000/put" }, response);
+
+    EXPECT_TRUE(bool(getStored(resource)));
+}
+
+TEST(DefaultFileSource, TEST_REQUIRES_SERVER(SetRegionDownloadStateFlushesPendingWrites)) {
+    deleteCache();
+
+    OfflineRegionDefinition definition { "http://127.0.0.1:3000/style", LatLngBounds::hull({1, 2}, {3, 4}), 0, 0, 1.0 };
+    OfflineRegion region = OfflineDatabase(cachePath).createRegion(definition, {});
+
+    util::RunLoop loop;
+    DefaultFileSource fs(cachePath, ".");
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/cache" };
+    std::unique_ptr<AsyncRequest> req;
+
+    req = fs.request(resource, [&](Response) {
+        req.reset();
+        fs.setOfflineRegionDownloadState(region, OfflineRegionDownloadState::Inactive);
+
+        // Runs after the state change on the file source thread.
+        fs.getOfflineRegionStatus(region, [&](std::exception_ptr, optional<OfflineRegionStatus>) {
+            loop.stop();
+        });
+    });
+
+    loop.run();
+
+    EXPECT_TRUE(bool(getStored(resource)));
+}
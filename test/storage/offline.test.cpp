@@ -52,3 +52,18 @@ TEST(OfflineTilePyramidRegionDefinition, TileCoverWrapped) {
     EXPECT_EQ((std::vector<CanonicalTileID>{ { 0, 0, 0 } }),
               region.tileCover(SourceType::Vector, 512, { 0, 22 }));
 }
+
+TEST(OfflineTilePyramidRegionDefinition, TileCount) {
+    OfflineTilePyramidRegionDefinition region("", sanFrancisco, 0, 22, 1.0);
+
+    EXPECT_EQ(0u, OfflineTilePyramidRegionDefinition("", LatLngBounds::empty(), 0, 20, 1.0)
+                      .tileCount(SourceType::Vector, 512, { 0, 22 }));
+    EXPECT_EQ(region.tileCover(SourceType::Vector, 512, { 0, 16 }).size(),
+              region.tileCount(SourceType::Vector, 512, { 0, 16 }));
+    EXPECT_EQ(region.tileCover(SourceType::Raster, 256, { 4, 14 }).size(),
+              region.tileCount(SourceType::Raster, 256, { 4, 14 }));
+
+    // Counting doesn't enumerate the tiles.
+    EXPECT_EQ(366503875925u, OfflineTilePyramidRegionDefinition("", LatLngBounds::world(), 0, 19, 1.0)
+                                 .tileCount(SourceType::Vector, 512, { 0, 22 }));
+}
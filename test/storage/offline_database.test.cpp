@@ -415,6 +415,63 @@ TEST(OfflineDatabase, PutReturnsSize) {
     EXPECT_EQ(0u, db.put(Resource::style("http://example.com/noContent"), noContent).second);
 }
 
+TEST(OfflineDatabase, PutBatch) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    Response style;
+    style.data = std::make_shared<std::string>("style");
+
+    Response tile;
+    tile.data = randomString(1024);
+
+    Response error;
+    error.error = std::make_unique<Response::Error>(Response::Error::Reason::Server, "boom");
+
+    std::vector<std::pair<Resource, Response>> batch;
+    batch.emplace_back(Resource::style("http://example.com/style"), style);
+    batch.emplace_back(Resource::tile("http://example.com/{z}/{x}/{y}.pbf", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), tile);
+    batch.emplace_back(Resource::style("http://example.com/error"), error);
+
+    auto results = db.put(batch);
+    ASSERT_EQ(3u, results.size());
+    EXPECT_TRUE(results[0].first);
+    EXPECT_EQ(5u, results[0].second);
+    EXPECT_TRUE(results[1].first);
+    EXPECT_EQ(1024u, results[1].second);
+    EXPECT_FALSE(results[2].first);
+
+    EXPECT_EQ("style", *db.get(Resource::style("http://example.com/style"))->data);
+    EXPECT_EQ(*tile.data, *db.get(Resource::tile("http://example.com/{z}/{x}/{y}.pbf", 1.0, 0, 0, 0, Tileset::Scheme::XYZ))->data);
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/error"))));
+
+    // Storing the batch again updates the existing entries.
+    results = db.put(batch);
+    EXPECT_FALSE(results[0].first);
+    EXPECT_FALSE(results[1].first);
+}
+
+TEST(OfflineDatabase, PutBatchEvictsLeastRecentlyUsedResources) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:", 1024 * 100);
+
+    Response response;
+    response.data = randomString(1024);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        std::vector<std::pair<Resource, Response>> batch;
+        for (uint32_t j = 1; j <= 10; j++) {
+            batch.emplace_back(Resource::style("http://example.com/"s + util::toString(i * 10 + j)), response);
+        }
+        db.put(batch);
+        EXPECT_TRUE(bool(db.get(batch.back().first))) << i;
+    }
+
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+}
+
 TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     using namespace mbgl;
 
@@ -549,6 +606,191 @@ TEST(OfflineDatabase, HasRegionResourceTile) {
 
 }
 
+TEST(OfflineDatabase, RegionDownloadCursor) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region1 = db.createRegion(definition, OfflineRegionMetadata());
+    OfflineRegion region2 = db.createRegion(definition, OfflineRegionMetadata());
+
+    EXPECT_FALSE(bool(db.getRegionDownloadCursor(region1.getID(), "http://example.com/{z}-{x}-{y}.vector.pbf")));
+
+    OfflineDownloadCursor cursor;
+    cursor.tileCount = 100;
+    cursor.tileIndex = 40;
+    cursor.completedSize = 4096;
+    db.putRegionDownloadCursor(region1.getID(), "http://example.com/{z}-{x}-{y}.vector.pbf", cursor);
+
+    auto stored = db.getRegionDownloadCursor(region1.getID(), "http://example.com/{z}-{x}-{y}.vector.pbf");
+    ASSERT_TRUE(bool(stored));
+    EXPECT_EQ(100u, stored->tileCount);
+    EXPECT_EQ(40u, stored->tileIndex);
+    EXPECT_EQ(4096u, stored->completedSize);
+
+    // Cursors are per region and per source.
+    EXPECT_FALSE(bool(db.getRegionDownloadCursor(region2.getID(), "http://example.com/{z}-{x}-{y}.vector.pbf")));
+    EXPECT_FALSE(bool(db.getRegionDownloadCursor(region1.getID(), "http://example.com/{z}-{x}-{y}.png")));
+
+    // Storing a cursor replaces the previous one.
+    cursor.tileIndex = 60;
+    db.putRegionDownloadCursor(region1.getID(), "http://example.com/{z}-{x}-{y}.vector.pbf", cursor);
+    EXPECT_EQ(60u, db.getRegionDownloadCursor(region1.getID(), "http://example.com/{z}-{x}-{y}.vector.pbf")->tileIndex);
+
+    // Deleting the region deletes its cursors.
+    const int64_t regionID = region1.getID();
+    db.deleteRegion(std::move(region1));
+    EXPECT_FALSE(bool(db.getRegionDownloadCursor(regionID, "http://example.com/{z}-{x}-{y}.vector.pbf")));
+}
+
+TEST(OfflineDatabase, HasRegionTiles) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    const std::vector<Resource> tiles = {
+        Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, 0, 0, 0, Tileset::Scheme::XYZ),
+        Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, 0, 0, 1, Tileset::Scheme::XYZ),
+        Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, 0, 1, 1, Tileset::Scheme::XYZ),
+    };
+
+    Response response;
+    response.data = std::make_shared<std::string>("first");
+    db.put(tiles[0], response);
+    response.data = std::make_shared<std::string>("third!");
+    db.put(tiles[2], response);
+
+    EXPECT_EQ(0u, db.getRegionCompletedStatus(region.getID()).completedTileCount);
+
+    const std::vector<optional<int64_t>> sizes = db.hasRegionTiles(region.getID(), tiles);
+    ASSERT_EQ(3u, sizes.size());
+    EXPECT_EQ(5, *sizes[0]);
+    EXPECT_FALSE(bool(sizes[1]));
+    EXPECT_EQ(6, *sizes[2]);
+
+    // The stored tiles are now part of the region.
+    EXPECT_EQ(2u, db.getRegionCompletedStatus(region.getID()).completedTileCount);
+
+    EXPECT_TRUE(db.hasRegionTiles(region.getID(), {}).empty());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportDatabase)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/import.db");
+
+    const Resource tile = Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    const Resource style = Resource::style("http://example.com/style.json");
+
+    {
+        OfflineDatabase source("test/fixtures/offline_database/import.db");
+        Response response;
+        response.data = std::make_shared<std::string>("tile");
+        source.put(tile, response);
+        response.data = std::make_shared<std::string>("style");
+        source.put(style, response);
+    }
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    EXPECT_EQ(2u, db.importDatabase(region.getID(), "test/fixtures/offline_database/import.db"));
+    EXPECT_EQ(4, *db.hasRegionResource(region.getID(), tile));
+    EXPECT_EQ(5, *db.hasRegionResource(region.getID(), style));
+
+    OfflineRegionStatus status = db.getRegionCompletedStatus(region.getID());
+    EXPECT_EQ(2u, status.completedResourceCount);
+    EXPECT_EQ(1u, status.completedTileCount);
+
+    // Importing again doesn't add anything.
+    EXPECT_EQ(0u, db.importDatabase(region.getID(), "test/fixtures/offline_database/import.db"));
+
+    deleteFile("test/fixtures/offline_database/missing.db");
+    EXPECT_THROW(db.importDatabase(region.getID(), "test/fixtures/offline_database/missing.db"),
+                 mapbox::sqlite::Exception);
+}
+
+static void createMBTiles(const std::string& path) {
+    mapbox::sqlite::Database mbtiles(path, mapbox::sqlite::ReadWrite | mapbox::sqlite::Create);
+    mbtiles.exec("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)");
+    mbtiles.exec("INSERT INTO tiles VALUES (0, 0, 0, 'world'), (1, 0, 0, 'southwest')");
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportMBTiles)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/import.mbtiles");
+    createMBTiles("test/fixtures/offline_database/import.mbtiles");
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    EXPECT_EQ(2u, db.importMBTiles(region.getID(), "test/fixtures/offline_database/import.mbtiles",
+                                   "http://example.com/{z}-{x}-{y}.vector.pbf", 1.0));
+
+    // MBTiles rows count from the bottom.
+    auto tile = db.getRegionResource(region.getID(),
+        Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, 0, 1, 1, Tileset::Scheme::XYZ));
+    ASSERT_TRUE(bool(tile));
+    EXPECT_EQ("southwest", *tile->first.data);
+
+    EXPECT_EQ(2u, db.getRegionCompletedStatus(region.getID()).completedTileCount);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportGzippedMBTiles)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/import.mbtiles");
+    {
+        mapbox::sqlite::Database mbtiles("test/fixtures/offline_database/import.mbtiles",
+                                         mapbox::sqlite::ReadWrite | mapbox::sqlite::Create);
+        mbtiles.exec("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)");
+        // gzip of "gzipped world".
+        mbtiles.exec("INSERT INTO tiles VALUES (0, 0, 0, "
+                     "X'1f8b08000000000002034bafca2c28484d5128cf2fca490100a038f1830d000000')");
+    }
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    EXPECT_EQ(1u, db.importMBTiles(region.getID(), "test/fixtures/offline_database/import.mbtiles",
+                                   "http://example.com/{z}-{x}-{y}.vector.pbf", 1.0));
+
+    auto tile = db.getRegionResource(region.getID(),
+        Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, 0, 0, 0, Tileset::Scheme::XYZ));
+    ASSERT_TRUE(bool(tile));
+    EXPECT_EQ("gzipped world", *tile->first.data);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportMBTilesExceedingMapboxTileCountLimit)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/import.mbtiles");
+    createMBTiles("test/fixtures/offline_database/import.mbtiles");
+
+    OfflineDatabase db(":memory:");
+    db.setOfflineMapboxTileCountLimit(1);
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    EXPECT_THROW(db.importMBTiles(region.getID(), "test/fixtures/offline_database/import.mbtiles",
+                                  "mapbox://tiles/{z}-{x}-{y}.vector.pbf", 1.0),
+                 std::runtime_error);
+
+    // Nothing was imported.
+    EXPECT_EQ(0u, db.getRegionCompletedStatus(region.getID()).completedTileCount);
+    EXPECT_EQ(0u, db.getOfflineMapboxTileCount());
+}
+
 TEST(OfflineDatabase, OfflineMapboxTileCount) {
     using namespace mbgl;
 
@@ -620,6 +862,13 @@ static int databaseUserVersion(const std::string& path) {
     return stmt.get<int>(0);
 }
 
+static int databaseTileBlobCount(const std::string& path) {
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt = db.prepare("SELECT COUNT(*) FROM tile_blobs");
+    stmt.run();
+    return stmt.get<int>(0);
+}
+
 static std::string databaseJournalMode(const std::string& path) {
     mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
     mapbox::sqlite::Statement stmt = db.prepare("pragma journal_mode");
@@ -639,19 +888,19 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
 
     // v2.db is a v2 database containing a single offline region with a small number of resources.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v2.db"));
+    deleteFile("test/fixtures/offline_database/migrated.db");
+    writeFile("test/fixtures/offline_database/migrated.db", util::read_file("test/fixtures/offline_database/v2.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v5.db"),
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_LT(databasePageCount("test/fixtures/offline_database/migrated.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
 
@@ -660,18 +909,18 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
 
     // v3.db is a v3 database, migrated from v2.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v3.db"));
+    deleteFile("test/fixtures/offline_database/migrated.db");
+    writeFile("test/fixtures/offline_database/migrated.db", util::read_file("test/fixtures/offline_database/v3.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -679,22 +928,102 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
 
     // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL` and `synchronous = NORMAL`.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v4.db"));
+    deleteFile("test/fixtures/offline_database/migrated.db");
+    writeFile("test/fixtures/offline_database/migrated.db", util::read_file("test/fixtures/offline_database/v4.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+
+    // Journal mode should be DELETE after migration to v5 and later.
+    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/migrated.db"));
+
+    // Synchronous setting should be FULL (2) after migration to v5 and later.
+    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/migrated.db"));
+}
+
+TEST(OfflineDatabase, MigrateFromV6Schema) {
+    using namespace mbgl;
+
+    // v6.db is a v6 database with a region of four tiles, two of which have the same data,
+    // and one without content. A tile outside the region has the same data too.
+
+    deleteFile("test/fixtures/offline_database/migrated.db");
+    writeFile("test/fixtures/offline_database/migrated.db", util::read_file("test/fixtures/offline_database/v6.db"));
+
+    {
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
+
+        auto tile = [](int32_t x, int32_t y, int8_t z) {
+            return Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, x, y, z, Tileset::Scheme::XYZ);
+        };
+
+        EXPECT_EQ("ocean", *db.get(tile(0, 0, 0))->data);
+        EXPECT_EQ("ocean", *db.get(tile(1, 1, 1))->data);
+        EXPECT_EQ("land", *db.get(tile(1, 0, 1))->data);
+        EXPECT_EQ("land", *db.get(tile(1, 0, 1))->etag);
+        EXPECT_TRUE(db.get(tile(0, 1, 1))->noContent);
+
+        auto regions = db.listRegions();
+        ASSERT_EQ(1u, regions.size());
+        OfflineRegionStatus status = db.getRegionCompletedStatus(regions[0].getID());
+        EXPECT_EQ(4u, status.completedTileCount);
+        EXPECT_EQ(14u, status.completedTileSize);
+    }
+
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(2, databaseTileBlobCount("test/fixtures/offline_database/migrated.db"));
+}
 
-    // Journal mode should be DELETE after migration to v5.
-    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/v5.db"));
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(PutTileSharesData)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+
+    auto tile = [](int32_t x) {
+        return Resource::tile("http://example.com/{z}-{x}-{y}.vector.pbf", 1.0, x, 0, 1, Tileset::Scheme::XYZ);
+    };
+
+    Response ocean;
+    ocean.data = std::make_shared<std::string>("ocean");
+    Response land;
+    land.data = std::make_shared<std::string>("land");
+
+    {
+        OfflineDatabase db("test/fixtures/offline_database/offline.db");
+        OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+        OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+        db.putRegionResource(region.getID(), tile(0), ocean);
+        db.putRegionResource(region.getID(), tile(1), ocean);
+        db.put(tile(2), land);
+
+        // Each tile counts in full towards the size of the region.
+        EXPECT_EQ(10u, db.getRegionCompletedStatus(region.getID()).completedTileSize);
+
+        // Updating a tile leaves the others that shared its data alone.
+        db.put(tile(0), land);
+        EXPECT_EQ("land", *db.get(tile(0))->data);
+        EXPECT_EQ("ocean", *db.get(tile(1))->data);
+    }
+
+    EXPECT_EQ(2, databaseTileBlobCount("test/fixtures/offline_database/offline.db"));
+
+    {
+        OfflineDatabase db("test/fixtures/offline_database/offline.db");
+        Response noContent;
+        noContent.noContent = true;
+        db.put(tile(1), noContent);
+        EXPECT_TRUE(db.get(tile(1))->noContent);
+    }
 
-    // Synchronous setting should be FULL (2) after migration to v5.
-    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/v5.db"));
+    // Data no tile uses anymore is deleted.
+    EXPECT_EQ(1, databaseTileBlobCount("test/fixtures/offline_database/offline.db"));
 }
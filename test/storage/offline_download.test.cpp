@@ -9,9 +9,11 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/timer.hpp>
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <set>
 
 using namespace mbgl;
 using namespace std::literals::string_literals;
@@ -570,7 +572,9 @@ TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
 
     test.loop.run();
 
-    ASSERT_EQ(4u, statusesAfterReactivate.size());
+    // The tile isn't checked again; the download cursor saved by the first download
+    // accounts for it as soon as the style is in.
+    ASSERT_EQ(3u, statusesAfterReactivate.size());
 
     EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[0].downloadState);
     EXPECT_FALSE(statusesAfterReactivate[0].requiredResourceCountIsPrecise);
@@ -580,12 +584,118 @@ TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
     EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[1].downloadState);
     EXPECT_TRUE(statusesAfterReactivate[1].requiredResourceCountIsPrecise);
     EXPECT_EQ(2u, statusesAfterReactivate[1].requiredResourceCount);
-    EXPECT_EQ(1u, statusesAfterReactivate[1].completedResourceCount);
+    EXPECT_EQ(2u, statusesAfterReactivate[1].completedResourceCount);
+    EXPECT_EQ(1u, statusesAfterReactivate[1].completedTileCount);
 
-    EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[2].downloadState);
-    EXPECT_TRUE(statusesAfterReactivate[2].requiredResourceCountIsPrecise);
-    EXPECT_EQ(2u, statusesAfterReactivate[2].requiredResourceCount);
-    EXPECT_EQ(2u, statusesAfterReactivate[2].completedResourceCount);
+    EXPECT_EQ(OfflineRegionDownloadState::Inactive, statusesAfterReactivate[2].downloadState);
+}
+
+TEST(OfflineDownload, ResumeFromDownloadCursor) {
+    OfflineTest test;
+    OfflineRegion region = test.createRegion();
+    OfflineDownload download(
+        region.getID(),
+        OfflineTilePyramidRegionDefinition("http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 1.0, 1.0),
+        test.db, test.fileSource);
+
+    // An earlier download stored the first two of the five tiles at z0 and z1.
+    OfflineDownloadCursor cursor;
+    cursor.tileCount = 5;
+    cursor.tileIndex = 2;
+    cursor.completedSize = 1000;
+    test.db.putRegionDownloadCursor(region.getID(), "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf", cursor);
+
+    test.fileSource.styleResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("http://127.0.0.1:3000/style.json", resource.url);
+        return test.response("inline_source.style.json");
+    };
+
+    std::set<CanonicalTileID> requestedTiles;
+    test.fileSource.tileResponse = [&] (const Resource& resource) {
+        const Resource::TileData& tile = *resource.tileData;
+        requestedTiles.emplace(tile.z, tile.x, tile.y);
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(6u, status.completedResourceCount);
+            EXPECT_EQ(5u, status.completedTileCount);
+            EXPECT_EQ(test.size + 1000, status.completedResourceSize);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_EQ((std::set<CanonicalTileID>{ { 1, 0, 1 }, { 1, 1, 0 }, { 1, 1, 1 } }), requestedTiles);
+
+    auto saved = test.db.getRegionDownloadCursor(region.getID(), "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf");
+    ASSERT_TRUE(bool(saved));
+    EXPECT_EQ(5u, saved->tileIndex);
+}
+
+TEST(OfflineDownload, PendingTilesBounded) {
+    OfflineTest test;
+    OfflineRegion region = test.createRegion();
+    OfflineDownload download(
+        region.getID(),
+        OfflineTilePyramidRegionDefinition("http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 5.0, 1.0),
+        test.db, test.fileSource);
+
+    test.fileSource.styleResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("http://127.0.0.1:3000/style.json", resource.url);
+        return test.response("inline_source.style.json");
+    };
+
+    // The z0 tile, which is the first in the cover, is held back until the tiles after it
+    // have piled up.
+    bool released = false;
+    std::set<CanonicalTileID> requestedTiles;
+    test.fileSource.tileResponse = [&] (const Resource& resource) -> optional<Response> {
+        const Resource::TileData& tile = *resource.tileData;
+        requestedTiles.emplace(tile.z, tile.x, tile.y);
+        if (tile.z == 0 && !released) {
+            return {};
+        }
+        Response response;
+        response.data = std::make_shared<std::string>("tile");
+        return response;
+    };
+
+    util::Timer timer;
+    auto observer = std::make_unique<MockObserver>();
+
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(1365u, status.completedTileCount);
+            test.loop.stop();
+        } else if (status.completedTileCount == 511) {
+            // Everything but the held back tile is stored; give the download a moment to
+            // request tiles past the limit of 512 pending ones.
+            timer.start(Milliseconds(50), Duration::zero(), [&] {
+                EXPECT_EQ(512u, requestedTiles.size());
+                released = true;
+            });
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_TRUE(released);
+    EXPECT_EQ(1365u, requestedTiles.size());
+
+    auto saved = test.db.getRegionDownloadCursor(region.getID(), "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf");
+    ASSERT_TRUE(bool(saved));
+    EXPECT_EQ(1365u, saved->tileIndex);
 }
 
 TEST(OfflineDownload, Deactivate) {
@@ -1,5 +1,6 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/run_loop.hpp>
@@ -414,3 +415,98 @@ TEST(OnlineFileSource, ChangeAPIBaseURL){
     fs.setAPIBaseURL(customURL);
     EXPECT_EQ(customURL, fs.getAPIBaseURL());
 }
+
+// When all connections are in use, queued requests are started in priority order: the style
+// first, then tiles by ascending zoom and by distance from the center of the viewport.
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(PendingRequestPriority)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    // Occupy all but one connection for longer than the test takes, and the last one briefly,
+    // so that the queued requests run one at a time once it frees up.
+    std::vector<std::unique_ptr<AsyncRequest>> blockers;
+    for (uint32_t i = 0; i + 1 < HTTPFileSource::maximumConcurrentRequests(); i++) {
+        blockers.push_back(fs.request({ Resource::Unknown, "http://127.0.0.1:3000/delayed/5000" },
+                                      [](Response) { FAIL() << "Should never be called"; }));
+    }
+    blockers.push_back(fs.request({ Resource::Unknown, "http://127.0.0.1:3000/delayed" },
+                                  [](Response) {}));
+
+    std::vector<std::string> order;
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+
+    auto request = [&](Resource resource, std::string name) {
+        requests.push_back(fs.request(resource, [&, name](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            order.push_back(name);
+            if (order.size() == 4) {
+                loop.stop();
+            }
+        }));
+    };
+
+    auto tile = [](int8_t z, float distance, int number) {
+        Resource resource { Resource::Tile, "http://127.0.0.1:3000/load/" + std::to_string(number),
+                            Resource::TileData { "", 1, 0, 0, z } };
+        resource.viewportDistance = distance;
+        return resource;
+    };
+
+    request(tile(14, 5, 1), "far");
+    request(tile(14, 0, 2), "near");
+    request(tile(12, 3, 3), "low");
+    request(Resource::style("http://127.0.0.1:3000/load/4"), "style");
+
+    loop.run();
+
+    EXPECT_EQ((std::vector<std::string>{ "style", "low", "near", "far" }), order);
+}
+
+// A queued request moves to its new place in the queue when its priority changes, e.g.
+// because the viewport has moved or the tile has become required.
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(SetRequestPriority)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    std::vector<std::unique_ptr<AsyncRequest>> blockers;
+    for (uint32_t i = 0; i + 1 < HTTPFileSource::maximumConcurrentRequests(); i++) {
+        blockers.push_back(fs.request({ Resource::Unknown, "http://127.0.0.1:3000/delayed/5000" },
+                                      [](Response) { FAIL() << "Should never be called"; }));
+    }
+    blockers.push_back(fs.request({ Resource::Unknown, "http://127.0.0.1:3000/delayed" },
+                                  [](Response) {}));
+
+    std::vector<std::string> order;
+
+    auto request = [&](float distance, Resource::Necessity necessity, int number, std::string name) {
+        Resource resource { Resource::Tile, "http://127.0.0.1:3000/load/" + std::to_string(number),
+                            Resource::TileData { "", 1, 0, 0, 14 }, necessity };
+        resource.viewportDistance = distance;
+        return fs.request(resource, [&, name](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            order.push_back(name);
+            if (order.size() == 4) {
+                loop.stop();
+            }
+        });
+    };
+
+    auto a = request(1, Resource::Required, 1, "a");
+    auto b = request(2, Resource::Required, 2, "b");
+    auto c = request(3, Resource::Required, 3, "c");
+    auto d = request(0, Resource::Optional, 4, "d");
+
+    // The requests are queued once their timers fire; re-rank them after that.
+    util::Timer timer;
+    timer.start(Milliseconds(50), Duration::zero(), [&] {
+        fs.setRequestPriority(*c, Resource::Required, 0);
+        fs.setRequestPriority(*a, Resource::Required, 5);
+        fs.setRequestPriority(*d, Resource::Required, 4);
+    });
+
+    loop.run();
+
+    EXPECT_EQ((std::vector<std::string>{ "c", "b", "d", "a" }), order);
+}
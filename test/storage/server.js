@@ -133,6 +133,12 @@ app.get('/delayed', function(req, res) {
     }, 200);
 });
 
+app.get('/delayed/:ms(\\d+)', function(req, res) {
+    setTimeout(function() {
+        res.status(200).send('Response');
+    }, parseInt(req.params.ms, 10));
+});
+
 
 app.get('/load/:number(\\d+)', function(req, res) {
     res.send('Request ' + req.params.number);
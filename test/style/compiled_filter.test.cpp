@@ -0,0 +1,149 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <mbgl/style/compiled_filter.hpp>
+#include <mbgl/style/filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/rapidjson_conversion.hpp>
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/style/conversion/filter.hpp>
+
+#include <rapidjson/document.h>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+Filter parseFilter(const char * expression) {
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+    doc.Parse<0>(expression);
+    return *conversion::convert<Filter>(doc);
+}
+
+class StubFeature : public GeometryTileFeature {
+public:
+    StubFeature(FeatureType type_, optional<FeatureIdentifier> id_, PropertyMap properties_)
+        : type(type_), id(std::move(id_)), properties(std::move(properties_)) {
+    }
+
+    FeatureType getType() const override { return type; }
+    optional<FeatureIdentifier> getID() const override { return id; }
+    GeometryCollection getGeometries() const override { return {}; }
+
+    optional<Value> getValue(const std::string& key) const override {
+        auto it = properties.find(key);
+        if (it == properties.end()) {
+            return {};
+        }
+        return it->second;
+    }
+
+    optional<Value> getIndexedValue(uint32_t key) const override {
+        return getValue((*keys)[key]);
+    }
+
+    FeatureType type;
+    optional<FeatureIdentifier> id;
+    PropertyMap properties;
+    const std::vector<std::string>* keys = nullptr;
+};
+
+// A layer that optionally provides an interned key table, like vector tile layers do.
+class StubLayer : public GeometryTileLayer {
+public:
+    StubLayer(std::vector<StubFeature> features_, bool interned_)
+        : features(std::move(features_)), interned(interned_) {
+        for (auto& feature : features) {
+            for (const auto& property : feature.properties) {
+                if (keysMap.emplace(property.first, keys.size()).second) {
+                    keys.push_back(property.first);
+                }
+            }
+            feature.keys = &keys;
+        }
+    }
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubFeature>(features[i]);
+    }
+    std::string getName() const override { return "stub"; }
+    const std::unordered_map<std::string, uint32_t>* getKeysMap() const override {
+        return interned ? &keysMap : nullptr;
+    }
+
+    std::vector<StubFeature> features;
+    std::unordered_map<std::string, uint32_t> keysMap;
+    std::vector<std::string> keys;
+    bool interned;
+};
+
+std::vector<StubFeature> stubFeatures() {
+    return {
+        { FeatureType::Point, { uint64_t(1) }, {{ "class", std::string("street") }, { "rank", int64_t(3) }} },
+        { FeatureType::LineString, { uint64_t(2) }, {{ "class", std::string("motorway") }, { "rank", uint64_t(1) }, { "oneway", true }} },
+        { FeatureType::LineString, {}, {{ "class", std::string("path") }, { "rank", double(7.5) }} },
+        { FeatureType::Polygon, { std::string("a") }, {{ "class", std::string("park") }, { "oneway", false }} },
+        { FeatureType::Polygon, { int64_t(-5) }, {} },
+    };
+}
+
+} // namespace
+
+TEST(CompiledFilter, MatchesFilterEvaluator) {
+    const char* expressions[] = {
+        R"(["all"])",
+        R"(["==", "class", "street"])",
+        R"(["!=", "class", "street"])",
+        R"(["==", "missing", "street"])",
+        R"(["!=", "missing", "street"])",
+        R"(["<", "rank", 3])",
+        R"(["<=", "rank", 3])",
+        R"([">", "rank", 3])",
+        R"([">=", "rank", 3])",
+        R"([">", "missing", 3])",
+        R"(["==", "$type", "LineString"])",
+        R"(["in", "$type", "LineString", "Polygon"])",
+        R"(["==", "$id", 1])",
+        R"(["!=", "$id", "a"])",
+        R"(["in", "class", "street", "path"])",
+        R"(["!in", "class", "street", "path"])",
+        R"(["in", "class", "a", "b", "c", "d", "e", "f", "g", "h", "i", "motorway"])",
+        R"(["!in", "class", "a", "b", "c", "d", "e", "f", "g", "h", "i", "motorway"])",
+        R"(["in", "rank", 0, 2, 4, 6, 8, 10, 12, 14, 16, 3])",
+        R"(["in", "oneway", "a", "b", "c", "d", "e", "f", "g", "h", "i", true])",
+        R"(["in", "missing", "a"])",
+        R"(["!in", "missing", "a"])",
+        R"(["has", "oneway"])",
+        R"(["!has", "oneway"])",
+        R"(["has", "missing"])",
+        R"(["!has", "missing"])",
+        R"(["has", "$id"])",
+        R"(["all", ["==", "class", "street"], ["==", "$type", "Point"]])",
+        R"(["all", ["==", "class", "street"], ["has", "missing"]])",
+        R"(["all", ["!has", "missing"]])",
+        R"(["any", ["==", "class", "park"], ["<", "rank", 2]])",
+        R"(["any", ["==", "missing", 1], ["==", "$type", "Polygon"]])",
+        R"(["any", ["!=", "missing", 1], ["==", "class", "park"]])",
+        R"(["none", ["==", "class", "park"], ["<", "rank", 2]])",
+        R"(["none", ["has", "missing"]])",
+        R"(["all", ["any", ["==", "class", "street"], ["has", "oneway"]], ["none", [">", "rank", 5]], ["!=", "$type", "Point"]])",
+    };
+
+    for (bool interned : { true, false }) {
+        StubLayer layer(stubFeatures(), interned);
+
+        for (const char* expression : expressions) {
+            const Filter filter = parseFilter(expression);
+            const CompiledFilter compiled(filter, layer);
+
+            for (const auto& feature : layer.features) {
+                const bool expected = filter(feature.getType(), feature.getID(), [&] (const std::string& key) {
+                    return feature.getValue(key);
+                });
+                EXPECT_EQ(expected, compiled(feature)) << expression;
+            }
+        }
+    }
+}
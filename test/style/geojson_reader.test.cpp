@@ -0,0 +1,85 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/sources/geojson_reader.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+TEST(GeoJSONReader, FeatureCollection) {
+    auto result = readGeoJSON(R"({
+        "features": [
+            { "properties": { "name": "a" }, "geometry": { "coordinates": [1, 2], "type": "Point" }, "type": "Feature" },
+            { "type": "Feature", "id": 7, "geometry": { "type": "LineString", "coordinates": [[0, 0], [1, 1]] } }
+        ],
+        "type": "FeatureCollection"
+    })");
+    ASSERT_TRUE(bool(result));
+    ASSERT_TRUE((*result).is<FeatureCollection>());
+
+    const auto& features = (*result).get<FeatureCollection>();
+    ASSERT_EQ(2u, features.size());
+
+    ASSERT_TRUE(features[0].geometry.is<mapbox::geometry::point<double>>());
+    EXPECT_EQ(1.0, features[0].geometry.get<mapbox::geometry::point<double>>().x);
+    EXPECT_EQ(2.0, features[0].geometry.get<mapbox::geometry::point<double>>().y);
+    EXPECT_EQ(std::string("a"), features[0].properties.at("name").get<std::string>());
+
+    ASSERT_TRUE(features[1].geometry.is<mapbox::geometry::line_string<double>>());
+    EXPECT_EQ(2u, features[1].geometry.get<mapbox::geometry::line_string<double>>().size());
+    ASSERT_TRUE(bool(features[1].id));
+}
+
+TEST(GeoJSONReader, Feature) {
+    auto result = readGeoJSON(R"({ "type": "Feature", "geometry": { "type": "Point", "coordinates": [1, 2] } })");
+    ASSERT_TRUE(bool(result));
+    ASSERT_TRUE((*result).is<mapbox::geometry::feature<double>>());
+}
+
+TEST(GeoJSONReader, Geometry) {
+    auto result = readGeoJSON(R"({ "type": "Point", "coordinates": [1, 2] })");
+    ASSERT_TRUE(bool(result));
+    ASSERT_TRUE((*result).is<mapbox::geometry::geometry<double>>());
+}
+
+TEST(GeoJSONReader, ForeignFeaturesMember) {
+    // A "features" member of anything but a FeatureCollection isn't part of the data.
+    auto result = readGeoJSON(R"({
+        "features": [{ "type": "Feature", "geometry": { "type": "Point", "coordinates": [1, 2] } }],
+        "type": "Feature",
+        "geometry": { "type": "Point", "coordinates": [3, 4] }
+    })");
+    ASSERT_TRUE(bool(result));
+    ASSERT_TRUE((*result).is<mapbox::geometry::feature<double>>());
+    EXPECT_EQ(3.0, (*result).get<mapbox::geometry::feature<double>>().geometry.get<mapbox::geometry::point<double>>().x);
+}
+
+TEST(GeoJSONReader, InvalidGeoJSON) {
+    EXPECT_FALSE(bool(readGeoJSON(R"({ "type": "FeatureCollection" })")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({ "type": "FeatureCollection", "features": [{ "type": "Feature" }] })")));
+}
+
+TEST(GeoJSONReader, InvalidJSON) {
+    try {
+        readGeoJSON(R"({ "type": "FeatureCollection", "features": [{ "type": "Feature", )");
+        FAIL() << "Should throw";
+    } catch (const std::runtime_error&) {
+    }
+
+    try {
+        readGeoJSON("CORRUPTED");
+        FAIL() << "Should throw";
+    } catch (const std::runtime_error& ex) {
+        EXPECT_EQ(std::string("0 - Invalid value."), ex.what());
+    }
+}
+
+TEST(GeoJSONReader, Cancelled) {
+    const std::string text = R"({ "type": "Point", "coordinates": [1, 2] })";
+
+    std::atomic<bool> cancelled { false };
+    EXPECT_TRUE(bool(readGeoJSON(text, &cancelled)));
+
+    // Stops at the first value, without throwing as it would for truncated text.
+    cancelled = true;
+    EXPECT_FALSE(bool(readGeoJSON(text, &cancelled)));
+}
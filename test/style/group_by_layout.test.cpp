@@ -9,7 +9,7 @@ using namespace mbgl;
 using namespace mbgl::style;
 
 TEST(GroupByLayout, Related) {
-    std::vector<std::unique_ptr<Layer>> layers;
+    std::vector<std::shared_ptr<const Layer>> layers;
     layers.push_back(std::make_unique<LineLayer>("a", "source"));
     layers.push_back(std::make_unique<LineLayer>("b", "source"));
     auto result = groupByLayout(layers);
@@ -18,7 +18,7 @@ TEST(GroupByLayout, Related) {
 }
 
 TEST(GroupByLayout, UnrelatedType) {
-    std::vector<std::unique_ptr<Layer>> layers;
+    std::vector<std::shared_ptr<const Layer>> layers;
     layers.push_back(std::make_unique<BackgroundLayer>("background"));
     layers.push_back(std::make_unique<CircleLayer>("circle", "source"));
     auto result = groupByLayout(layers);
@@ -26,19 +26,21 @@ TEST(GroupByLayout, UnrelatedType) {
 }
 
 TEST(GroupByLayout, UnrelatedFilter) {
-    std::vector<std::unique_ptr<Layer>> layers;
-    layers.push_back(std::make_unique<LineLayer>("a", "source"));
+    std::vector<std::shared_ptr<const Layer>> layers;
+    auto a = std::make_unique<LineLayer>("a", "source");
+    a->setFilter(EqualsFilter());
+    layers.push_back(std::move(a));
     layers.push_back(std::make_unique<LineLayer>("b", "source"));
-    layers[0]->as<LineLayer>()->setFilter(EqualsFilter());
     auto result = groupByLayout(layers);
     ASSERT_EQ(2u, result.size());
 }
 
 TEST(GroupByLayout, UnrelatedLayout) {
-    std::vector<std::unique_ptr<Layer>> layers;
-    layers.push_back(std::make_unique<LineLayer>("a", "source"));
+    std::vector<std::shared_ptr<const Layer>> layers;
+    auto a = std::make_unique<LineLayer>("a", "source");
+    a->setLineCap(LineCapType::Square);
+    layers.push_back(std::move(a));
     layers.push_back(std::make_unique<LineLayer>("b", "source"));
-    layers[0]->as<LineLayer>()->setLineCap(LineCapType::Square);
     auto result = groupByLayout(layers);
     ASSERT_EQ(2u, result.size());
 }
@@ -33,7 +33,7 @@ public:
     TransformState transformState;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
 
     style::UpdateParameters updateParameters {
         1.0,
@@ -85,7 +85,7 @@ TEST(Source, LoadingFail) {
 
     VectorSource source("source", "url");
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     test.run();
 }
@@ -108,7 +108,7 @@ TEST(Source, LoadingCorrupt) {
 
     VectorSource source("source", "url");
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     test.run();
 }
@@ -136,7 +136,7 @@ TEST(Source, RasterTileEmpty) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -165,7 +165,7 @@ TEST(Source, VectorTileEmpty) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -194,7 +194,7 @@ TEST(Source, RasterTileFail) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -223,7 +223,7 @@ TEST(Source, VectorTileFail) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -251,7 +251,7 @@ TEST(Source, RasterTileCorrupt) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -283,7 +283,7 @@ TEST(Source, VectorTileCorrupt) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -310,7 +310,7 @@ TEST(Source, RasterTileCancel) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -337,7 +337,7 @@ TEST(Source, VectorTileCancel) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -376,7 +376,7 @@ TEST(Source, RasterTileAttribution) {
 
     RasterSource source("source", "url", 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -405,7 +405,7 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
     source.baseImpl->setObserver(&test.observer);
 
     //Load initial, so the source state will be loaded=true
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     //Schedule an update
     test.loop.invoke([&] () {
@@ -415,3 +415,60 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
 
     test.run();
 }
+
+TEST(Source, GeoJSONSourceURLLoading) {
+    SourceTest test;
+
+    test.fileSource.sourceResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("url", resource.url);
+        Response response;
+        response.data = std::make_unique<std::string>(
+            R"({"features":[{"geometry":{"coordinates":[0,0],"type":"Point"},"type":"Feature"}],"type":"FeatureCollection"})");
+        return response;
+    };
+
+    test.observer.sourceLoaded = [&] (Source& source) {
+        EXPECT_EQ("source", source.getID());
+        EXPECT_TRUE(source.baseImpl->isLoaded());
+        test.end();
+    };
+
+    test.observer.sourceError = [&] (Source&, std::exception_ptr) {
+        FAIL() << "Should never be called";
+    };
+
+    GeoJSONSource source("source");
+    source.setURL("url");
+    source.baseImpl->setObserver(&test.observer);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    test.run();
+}
+
+TEST(Source, GeoJSONSourceURLLoadingCorrupt) {
+    SourceTest test;
+
+    test.fileSource.sourceResponse = [&] (const Resource&) {
+        Response response;
+        response.data = std::make_unique<std::string>("CORRUPTED");
+        return response;
+    };
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        FAIL() << "Should never be called";
+    };
+
+    test.observer.sourceError = [&] (Source& source, std::exception_ptr error) {
+        EXPECT_EQ("source", source.getID());
+        EXPECT_EQ("0 - Invalid value.", util::toString(error));
+        EXPECT_FALSE(source.baseImpl->isLoaded());
+        test.end();
+    };
+
+    GeoJSONSource source("source");
+    source.setURL("url");
+    source.baseImpl->setObserver(&test.observer);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    test.run();
+}
@@ -5,8 +5,10 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 
 #include <memory>
 
@@ -16,8 +18,9 @@ using namespace mbgl::style;
 TEST(Style, UnusedSource) {
     util::RunLoop loop;
 
+    ThreadPool threadPool { 1 };
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    Style style { threadPool, fileSource, 1.0 };
 
     auto now = Clock::now();
 
@@ -53,8 +56,9 @@ TEST(Style, UnusedSource) {
 TEST(Style, UnusedSourceActiveViaClassUpdate) {
     util::RunLoop loop;
 
+    ThreadPool threadPool { 1 };
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    Style style { threadPool, fileSource, 1.0 };
 
     style.setJSON(util::read_file("test/fixtures/resources/style-unused-sources.json"));
     EXPECT_TRUE(style.addClass("visible"));
@@ -86,8 +90,9 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
 TEST(Style, Properties) {
     util::RunLoop loop;
 
+    ThreadPool threadPool { 1 };
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    Style style { threadPool, fileSource, 1.0 };
 
     style.setJSON(R"STYLE({"name": "Test"})STYLE");
     ASSERT_EQ("Test", style.getName());
@@ -120,8 +125,9 @@ TEST(Style, Properties) {
 TEST(Style, DuplicateSource) {
     util::RunLoop loop;
 
+    ThreadPool threadPool { 1 };
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    Style style { threadPool, fileSource, 1.0 };
 
     style.setJSON(util::read_file("test/fixtures/resources/style-unused-sources.json"));
 
@@ -134,3 +140,54 @@ TEST(Style, DuplicateSource) {
         //Expected
     }
 }
+
+TEST(Style, LayerSnapshot) {
+    util::RunLoop loop;
+
+    ThreadPool threadPool { 1 };
+    StubFileSource fileSource;
+    Style style { threadPool, fileSource, 1.0 };
+
+    style.addLayer(std::make_unique<LineLayer>("a", "source"));
+    style.addLayer(std::make_unique<LineLayer>("b", "source"));
+
+    auto first = style.getLayerSnapshot();
+    ASSERT_EQ(2u, first->size());
+    EXPECT_EQ("a", first->at(0)->getID());
+    EXPECT_EQ("b", first->at(1)->getID());
+
+    // Unchanged styles share a single snapshot.
+    EXPECT_EQ(first, style.getLayerSnapshot());
+
+    // Paint properties don't participate in layout.
+    style.getLayer("a")->as<LineLayer>()->setLineWidth(2.0f);
+    EXPECT_EQ(first, style.getLayerSnapshot());
+
+    // Only the modified layer is copied again.
+    style.getLayer("b")->as<LineLayer>()->setLineCap(LineCapType::Square);
+    auto second = style.getLayerSnapshot();
+    ASSERT_NE(first, second);
+    ASSERT_EQ(2u, second->size());
+    EXPECT_EQ(first->at(0), second->at(0));
+    EXPECT_NE(first->at(1), second->at(1));
+    EXPECT_EQ(LineCapType::Square, second->at(1)->as<LineLayer>()->getLineCap().asConstant());
+    EXPECT_TRUE(first->at(1)->as<LineLayer>()->getLineCap().isUndefined());
+
+    style.getLayer("a")->setMinZoom(5);
+    auto third = style.getLayerSnapshot();
+    EXPECT_NE(second->at(0), third->at(0));
+    EXPECT_EQ(second->at(1), third->at(1));
+    EXPECT_EQ(5, third->at(0)->getMinZoom());
+
+    style.getLayer("b")->as<LineLayer>()->setSourceLayer("roads");
+    auto fourth = style.getLayerSnapshot();
+    EXPECT_EQ(third->at(0), fourth->at(0));
+    EXPECT_NE(third->at(1), fourth->at(1));
+    EXPECT_EQ("roads", fourth->at(1)->as<LineLayer>()->getSourceLayer());
+    EXPECT_EQ("", third->at(1)->as<LineLayer>()->getSourceLayer());
+
+    style.removeLayer("a");
+    auto fifth = style.getLayerSnapshot();
+    ASSERT_EQ(1u, fifth->size());
+    EXPECT_EQ(fourth->at(1), fifth->at(0));
+}
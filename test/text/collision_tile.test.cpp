@@ -0,0 +1,72 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/geometry/anchor.hpp>
+#include <mbgl/style/types.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+CollisionFeature pointLabel(float x, float y, std::size_t index) {
+    return CollisionFeature(GeometryCoordinates(), Anchor(x, y, 0, 0.5f), -50, 50, -100, 100, 1, 0,
+                            style::SymbolPlacementType::Point,
+                            IndexedSubfeature { index, "layer", "bucket", index }, false);
+}
+
+float place(CollisionTile& tile, CollisionFeature feature) {
+    const float scale = tile.placeFeature(feature, false, false);
+    tile.insertFeature(feature, scale, false);
+    return scale;
+}
+
+} // namespace
+
+TEST(CollisionTile, PlaceFeature) {
+    CollisionTile tile(PlacementConfig{});
+
+    EXPECT_FLOAT_EQ(0.5f, place(tile, pointLabel(1000, 1000, 0)));
+
+    // Overlaps the first label until it is zoomed in to twice the size.
+    EXPECT_FLOAT_EQ(1.0f, place(tile, pointLabel(1100, 1000, 1)));
+
+    EXPECT_FLOAT_EQ(0.5f, place(tile, pointLabel(5000, 5000, 2)));
+
+    // Outside of the tile.
+    EXPECT_FLOAT_EQ(0.5f, place(tile, pointLabel(-3000, -3000, 3)));
+    EXPECT_FLOAT_EQ(1.0f, place(tile, pointLabel(-2950, -3000, 4)));
+
+    // Labels that may overlap don't get pushed out.
+    auto overlapping = pointLabel(1000, 1000, 5);
+    EXPECT_FLOAT_EQ(0.5f, tile.placeFeature(overlapping, true, false));
+}
+
+TEST(CollisionTile, PlaceFeatureRotated) {
+    CollisionTile tile(PlacementConfig{ float(M_PI / 4) });
+
+    EXPECT_FLOAT_EQ(0.5f, place(tile, pointLabel(1000, 1000, 0)));
+    EXPECT_GT(place(tile, pointLabel(1100, 1000, 1)), 0.5f);
+    EXPECT_FLOAT_EQ(0.5f, place(tile, pointLabel(5000, 5000, 2)));
+}
+
+TEST(CollisionTile, QueryRenderedSymbols) {
+    CollisionTile tile(PlacementConfig{});
+    place(tile, pointLabel(1000, 1000, 0));
+    place(tile, pointLabel(1100, 1000, 1));
+    place(tile, pointLabel(5000, 5000, 2));
+
+    const GeometryCoordinates query { { 990, 990 }, { 1010, 990 }, { 1010, 1010 }, { 990, 1010 } };
+
+    auto result = tile.queryRenderedSymbols(query, 1);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(0u, result[0].index);
+    EXPECT_EQ(1u, result[1].index);
+
+    // The second label isn't shown yet at this scale.
+    result = tile.queryRenderedSymbols(query, 0.5);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(0u, result[0].index);
+}
@@ -143,6 +143,40 @@ TEST(GlyphAtlas, LoadingCancel) {
         {{0, 255}});
 }
 
+TEST(GlyphAtlas, GlyphSetSnapshots) {
+    GlyphAtlasTest test;
+    const FontStack fontStack {{"Test Stack"}};
+
+    auto before = test.glyphAtlas.getGlyphSet(fontStack);
+    ASSERT_TRUE(before->getSDFs().empty());
+
+    std::vector<SDFGlyph> glyphs;
+    glyphs.push_back(SDFGlyph{ 65 /* ASCII 'A' */,
+                               std::string(7 * 7, 'x'),
+                               { 1 /* width */, 1 /* height */, 0 /* left */, 0 /* top */,
+                                 0 /* advance */ } });
+    test.glyphAtlas.insertGlyphs(fontStack, { 0, 255 }, std::move(glyphs));
+
+    // Loaded ranges are answered from the snapshot, without issuing requests.
+    EXPECT_TRUE(test.glyphAtlas.hasGlyphRanges(fontStack, {{0, 255}}));
+    EXPECT_FALSE(test.glyphAtlas.hasGlyphRanges(fontStack, {{0, 255}, {256, 511}}));
+
+    // Snapshots taken earlier are not modified.
+    EXPECT_TRUE(before->getSDFs().empty());
+
+    auto after = test.glyphAtlas.getGlyphSet(fontStack);
+    EXPECT_EQ(1u, after->getSDFs().count(65));
+
+    // Later snapshots share the glyphs loaded before rather than copying them.
+    std::vector<SDFGlyph> more;
+    more.push_back(SDFGlyph{ 256, std::string(7 * 7, 'x'), { 1, 1, 0, 0, 0 } });
+    test.glyphAtlas.insertGlyphs(fontStack, { 256, 511 }, std::move(more));
+
+    auto latest = test.glyphAtlas.getGlyphSet(fontStack);
+    EXPECT_EQ(2u, latest->getSDFs().size());
+    EXPECT_EQ(after->getSDFs().at(65).get(), latest->getSDFs().at(65).get());
+}
+
 TEST(GlyphAtlas, InvalidSDFGlyph) {
     GlyphSet glyphSet;
     glyphSet.insert(65, SDFGlyph{ 65 /* ASCII 'A' */,
@@ -51,7 +51,7 @@ TEST(GlyphPBF, Parsing) {
 
         EXPECT_TRUE(sdfs.size() == 1);
         EXPECT_TRUE(sdfs.find(69) != sdfs.end());
-        auto& sdf = sdfs[69];
+        auto& sdf = *sdfs[69];
         EXPECT_EQ("xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"s, sdf.bitmap);
         EXPECT_EQ(1u, sdf.metrics.width);
         EXPECT_EQ(1u, sdf.metrics.height);
@@ -10,6 +10,8 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 
 #include <memory>
@@ -24,7 +26,7 @@ public:
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     style::UpdateParameters updateParameters {
@@ -70,3 +72,57 @@ TEST(GeoJSONTile, Issue7648) {
         test.loop.runOnce();
     }
 }
+
+TEST(GeoJSONTile, IncrementalLayout) {
+    GeoJSONTileTest test;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.updateParameters);
+
+    test.style.addLayer(std::make_unique<FillLayer>("fill", "source"));
+    test.style.addLayer(std::make_unique<LineLayer>("line", "source"));
+
+    StubTileObserver observer;
+    tile.setObserver(&observer);
+    tile.setPlacementConfig({});
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::polygon<int16_t> {
+            { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 } }
+        }
+    });
+
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    Layer& fill = *test.style.getLayer("fill");
+    Layer& line = *test.style.getLayer("line");
+
+    Bucket* fillBucket = tile.getBucket(fill);
+    Bucket* lineBucket = tile.getBucket(line);
+    ASSERT_NE(nullptr, fillBucket);
+    ASSERT_NE(nullptr, lineBucket);
+
+    // Changing the line layout rebuilds only the line bucket.
+    line.as<LineLayer>()->setLineCap(LineCapType::Square);
+    tile.redoLayout();
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(fillBucket, tile.getBucket(fill));
+    EXPECT_NE(nullptr, tile.getBucket(line));
+    EXPECT_NE(lineBucket, tile.getBucket(line));
+
+    // New data rebuilds everything.
+    fillBucket = tile.getBucket(fill);
+    lineBucket = tile.getBucket(line);
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_NE(fillBucket, tile.getBucket(fill));
+    EXPECT_NE(lineBucket, tile.getBucket(line));
+}
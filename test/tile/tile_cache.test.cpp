@@ -0,0 +1,95 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/tile/tile.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+namespace {
+
+class StubTile : public Tile {
+public:
+    StubTile(const OverscaledTileID& id_, std::size_t byteSize_ = 0)
+        : Tile(id_), byteSize(byteSize_) {
+        availableData = DataAvailability::All;
+    }
+
+    void setNecessity(Necessity) override {}
+    void cancel() override {}
+    Bucket* getBucket(const style::Layer&) override { return nullptr; }
+    std::size_t getByteSize() const override { return byteSize; }
+
+private:
+    const std::size_t byteSize;
+};
+
+std::unique_ptr<Tile> makeTile(const OverscaledTileID& id, std::size_t byteSize = 0) {
+    return std::make_unique<StubTile>(id, byteSize);
+}
+
+} // namespace
+
+TEST(TileCache, EvictsLeastRecentlyAdded) {
+    TileCache cache(2);
+    const OverscaledTileID a(1, 0, 0), b(1, 0, 1), c(1, 1, 0);
+
+    cache.add(a, makeTile(a));
+    cache.add(b, makeTile(b));
+    cache.add(a, makeTile(a)); // Refreshes `a`.
+    cache.add(c, makeTile(c));
+
+    EXPECT_TRUE(cache.has(a));
+    EXPECT_FALSE(cache.has(b));
+    EXPECT_TRUE(cache.has(c));
+
+    cache.setSize(1);
+    EXPECT_FALSE(cache.has(a));
+    EXPECT_TRUE(cache.has(c));
+}
+
+TEST(TileCache, Get) {
+    TileCache cache(2);
+    const OverscaledTileID a(1, 0, 0);
+
+    cache.add(a, makeTile(a, 10));
+    EXPECT_EQ(10u, cache.getByteSize());
+
+    auto tile = cache.get(a);
+    ASSERT_TRUE(tile.get());
+    EXPECT_EQ(a, tile->id);
+    EXPECT_FALSE(cache.has(a));
+    EXPECT_EQ(0u, cache.getByteSize());
+    EXPECT_FALSE(cache.get(a).get());
+}
+
+TEST(TileCache, Budget) {
+    TileCache cache(10, 100);
+    const OverscaledTileID a(1, 0, 0), b(1, 0, 1), c(1, 1, 0);
+
+    cache.add(a, makeTile(a, 40));
+    cache.add(b, makeTile(b, 40));
+    EXPECT_EQ(80u, cache.getByteSize());
+
+    // Adding `c` exceeds the budget, so the oldest tile is evicted.
+    cache.add(c, makeTile(c, 40));
+    EXPECT_FALSE(cache.has(a));
+    EXPECT_TRUE(cache.has(b));
+    EXPECT_TRUE(cache.has(c));
+    EXPECT_EQ(80u, cache.getByteSize());
+
+    cache.setBudget(50);
+    EXPECT_FALSE(cache.has(b));
+    EXPECT_TRUE(cache.has(c));
+    EXPECT_EQ(40u, cache.getByteSize());
+
+    // Tiles larger than the whole budget are not retained.
+    cache.add(a, makeTile(a, 60));
+    EXPECT_FALSE(cache.has(a));
+    EXPECT_EQ(40u, cache.getByteSize());
+
+    cache.clear();
+    EXPECT_FALSE(cache.has(c));
+    EXPECT_EQ(0u, cache.getByteSize());
+}
@@ -1,6 +1,7 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
 #include <mbgl/util/default_thread_pool.hpp>
@@ -18,6 +19,58 @@
 
 using namespace mbgl;
 
+namespace {
+
+// Just enough of a protocol buffer encoder to write vector tiles by hand.
+std::string varint(uint64_t value) {
+    std::string result;
+    while (value >= 0x80) {
+        result += char((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    result += char(value);
+    return result;
+}
+
+std::string field(uint32_t tag, uint64_t value) {
+    return varint(tag << 3) + varint(value);
+}
+
+std::string field(uint32_t tag, const std::string& bytes) {
+    return varint((tag << 3) | 2) + varint(bytes.size()) + bytes;
+}
+
+std::string packed(uint32_t tag, const std::vector<uint32_t>& values) {
+    std::string bytes;
+    for (uint32_t value : values) {
+        bytes += varint(value);
+    }
+    return field(tag, bytes);
+}
+
+uint32_t command(uint32_t id, uint32_t count) {
+    return (count << 3) | id;
+}
+
+uint32_t zigzag(int32_t value) {
+    return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+}
+
+std::string feature(uint64_t id, FeatureType type, const std::vector<uint32_t>& geometry,
+                    const std::vector<uint32_t>& tags = {}) {
+    return field(2, field(1, id) + packed(2, tags) + field(3, uint64_t(type)) + packed(4, geometry));
+}
+
+// A tile with a single layer "layer" with key "key", values "a" and "b", and the given features.
+VectorTileData tile(const std::string& features, uint32_t version = 2) {
+    const std::string layer = field(15, uint64_t(version)) + field(1, std::string("layer")) +
+        field(3, std::string("key")) + field(4, field(1, std::string("a"))) +
+        field(4, field(1, std::string("b"))) + field(5, uint64_t(util::EXTENT)) + features;
+    return VectorTileData(std::make_shared<const std::string>(field(3, layer)));
+}
+
+} // namespace
+
 class VectorTileTest {
 public:
     FakeFileSource fileSource;
@@ -25,7 +78,7 @@ public:
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     style::UpdateParameters updateParameters {
@@ -82,3 +135,98 @@ TEST(VectorTile, Issue7615) {
 
     EXPECT_EQ(symbolBucket.get(), tile.getBucket(symbolLayer));
 }
+
+TEST(VectorTile, DecodeClosePolygon) {
+    auto data = tile(feature(1, FeatureType::Polygon, {
+        command(1, 1), zigzag(0), zigzag(0),
+        command(2, 2), zigzag(10), zigzag(0), zigzag(0), zigzag(10),
+        command(7, 1)
+    }));
+
+    auto layer = data.getLayer("layer");
+    ASSERT_NE(nullptr, layer);
+    ASSERT_EQ(1u, layer->featureCount());
+    EXPECT_EQ((GeometryCollection { { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 0 } } }),
+              layer->getFeature(0)->getGeometries());
+}
+
+TEST(VectorTile, DecodeRepeatedMoveTo) {
+    auto data = tile(
+        // A line string with two parts.
+        feature(1, FeatureType::LineString, {
+            command(1, 1), zigzag(0), zigzag(0),
+            command(2, 1), zigzag(5), zigzag(0),
+            command(1, 1), zigzag(5), zigzag(10),
+            command(2, 1), zigzag(5), zigzag(0)
+        }) +
+        // Multiple points, from a single repeated moveTo.
+        feature(2, FeatureType::Point, {
+            command(1, 3), zigzag(1), zigzag(1), zigzag(1), zigzag(1), zigzag(1), zigzag(1)
+        }));
+
+    auto layer = data.getLayer("layer");
+    ASSERT_EQ(2u, layer->featureCount());
+    EXPECT_EQ((GeometryCollection { { { 0, 0 }, { 5, 0 } }, { { 10, 10 }, { 15, 10 } } }),
+              layer->getFeature(0)->getGeometries());
+    EXPECT_EQ((GeometryCollection { { { 1, 1 } }, { { 2, 2 } }, { { 3, 3 } } }),
+              layer->getFeature(1)->getGeometries());
+}
+
+TEST(VectorTile, DecodeVersion1Polygon) {
+    // A square with a wrongly wound ring; tiles before version 2 don't specify the winding order.
+    const std::vector<uint32_t> square {
+        command(1, 1), zigzag(0), zigzag(0),
+        command(2, 3), zigzag(0), zigzag(10), zigzag(10), zigzag(0), zigzag(0), zigzag(-10),
+        command(7, 1)
+    };
+
+    const GeometryCollection original { { { 0, 0 }, { 0, 10 }, { 10, 10 }, { 10, 0 }, { 0, 0 } } };
+
+    auto v2 = tile(feature(1, FeatureType::Polygon, square), 2);
+    EXPECT_EQ(original, v2.getLayer("layer")->getFeature(0)->getGeometries());
+
+    auto v1 = tile(feature(1, FeatureType::Polygon, square), 1);
+    const GeometryCollection fixed = v1.getLayer("layer")->getFeature(0)->getGeometries();
+    EXPECT_EQ(fixupPolygons(original), fixed);
+
+    // The fixed up rings don't disturb the features decoded after them.
+    auto both = tile(feature(1, FeatureType::Polygon, square) + feature(2, FeatureType::Polygon, square), 1);
+    EXPECT_EQ(fixed, both.getLayer("layer")->getFeature(0)->getGeometries());
+    EXPECT_EQ(fixed, both.getLayer("layer")->getFeature(1)->getGeometries());
+}
+
+TEST(VectorTile, EachFeatureStopsEarly) {
+    const std::vector<uint32_t> point { command(1, 1), zigzag(1), zigzag(1) };
+    auto data = tile(feature(1, FeatureType::Point, point) +
+                     feature(2, FeatureType::Point, point) +
+                     feature(3, FeatureType::Point, point));
+
+    std::vector<std::size_t> visited;
+    data.getLayer("layer")->eachFeature([&](const GeometryTileFeature& feature_, std::size_t index) {
+        visited.push_back(index);
+        EXPECT_EQ(FeatureIdentifier(uint64_t(index + 1)), *feature_.getID());
+        return index < 1;
+    });
+    EXPECT_EQ((std::vector<std::size_t>{ 0, 1 }), visited);
+}
+
+TEST(VectorTile, SkipMalformedFeature) {
+    const std::vector<uint32_t> point { command(1, 1), zigzag(1), zigzag(1) };
+    auto data = tile(feature(1, FeatureType::Point, point, { 0, 0 }) +
+                     // The second key is out of range, after a valid pair was read.
+                     feature(2, FeatureType::Point, point, { 0, 1, 1, 0 }) +
+                     feature(3, FeatureType::Point, { command(1, 1), zigzag(2), zigzag(2) }, { 0, 1 }));
+
+    auto layer = data.getLayer("layer");
+    ASSERT_EQ(2u, layer->featureCount());
+
+    auto first = layer->getFeature(0);
+    EXPECT_EQ(FeatureIdentifier(uint64_t(1)), *first->getID());
+    EXPECT_EQ(Value(std::string("a")), *first->getValue("key"));
+
+    auto second = layer->getFeature(1);
+    EXPECT_EQ(FeatureIdentifier(uint64_t(3)), *second->getID());
+    EXPECT_EQ(Value(std::string("b")), *second->getValue("key"));
+    EXPECT_EQ(1u, second->getProperties().size());
+    EXPECT_EQ((GeometryCollection { { { 2, 2 } } }), second->getGeometries());
+}
@@ -0,0 +1,78 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/grid_index.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+namespace {
+
+using Grid = GridIndex<FeatureIndex::Entry>;
+
+Grid::BBox box(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    return { { x1, y1 }, { x2, y2 } };
+}
+
+void insert(Grid& grid, uint32_t index, const Grid::BBox& bbox) {
+    grid.insert(FeatureIndex::Entry { index, index, 0, 0 }, bbox);
+}
+
+std::vector<uint32_t> query(const Grid& grid, const Grid::BBox& bbox) {
+    std::vector<uint32_t> result;
+    grid.query(bbox, [&](const FeatureIndex::Entry& entry) {
+        result.push_back(entry.index);
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST(GridIndex, Query) {
+    // 16 × 16 cells of 256 units each.
+    Grid grid(4096, 16, 0);
+    insert(grid, 0, box(10, 10, 20, 20));
+    insert(grid, 1, box(300, 300, 310, 310));
+    insert(grid, 2, box(4000, 10, 4090, 20));
+    grid.build();
+
+    EXPECT_EQ((std::vector<uint32_t>{ 0 }), query(grid, box(0, 0, 100, 100)));
+    EXPECT_EQ((std::vector<uint32_t>{ 0, 1 }), query(grid, box(15, 15, 305, 305)));
+    EXPECT_EQ((std::vector<uint32_t>{}), query(grid, box(30, 30, 290, 290)));
+    EXPECT_EQ((std::vector<uint32_t>{ 0, 1, 2 }), query(grid, box(0, 0, 4096, 4096)));
+}
+
+TEST(GridIndex, QuerySpanningCells) {
+    Grid grid(4096, 16, 0);
+    // Covers 4 × 3 cells.
+    insert(grid, 0, box(200, 200, 1000, 700));
+    insert(grid, 1, box(600, 600, 610, 610));
+    grid.build();
+
+    // Found once, no matter how many of its cells the query covers.
+    EXPECT_EQ((std::vector<uint32_t>{ 0, 1 }), query(grid, box(0, 0, 4096, 4096)));
+    EXPECT_EQ((std::vector<uint32_t>{ 0 }), query(grid, box(900, 650, 1100, 800)));
+    EXPECT_EQ((std::vector<uint32_t>{ 0 }), query(grid, box(0, 0, 210, 210)));
+
+    // In a cell of the element, but outside of its bounding box.
+    EXPECT_EQ((std::vector<uint32_t>{}), query(grid, box(1010, 710, 1020, 720)));
+}
+
+TEST(GridIndex, QueryBeforeBuild) {
+    Grid grid(4096, 16, 0);
+    EXPECT_EQ((std::vector<uint32_t>{}), query(grid, box(0, 0, 4096, 4096)));
+
+    insert(grid, 0, box(10, 10, 20, 20));
+    EXPECT_EQ((std::vector<uint32_t>{}), query(grid, box(0, 0, 4096, 4096)));
+
+    grid.build();
+    EXPECT_EQ((std::vector<uint32_t>{ 0 }), query(grid, box(0, 0, 4096, 4096)));
+
+    // Inserting invalidates the cells until the next build.
+    insert(grid, 1, box(30, 30, 40, 40));
+    EXPECT_EQ((std::vector<uint32_t>{}), query(grid, box(0, 0, 4096, 4096)));
+    grid.build();
+    EXPECT_EQ((std::vector<uint32_t>{ 0, 1 }), query(grid, box(0, 0, 4096, 4096)));
+}
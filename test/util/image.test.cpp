@@ -3,6 +3,7 @@
 #include <mbgl/util/premultiply.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 
 using namespace mbgl;
 
@@ -34,6 +35,45 @@ TEST(Image, PNGRoundTripAlpha) {
     EXPECT_EQ(128, image.data[3]);
 }
 
+TEST(Image, PNGRoundTripOptions) {
+    // Tall enough to be split into several strips, with a mix of opaque and translucent pixels.
+    PremultipliedImage rgba({ 300, 300 });
+    for (size_t i = 0; i < rgba.bytes(); i += 4) {
+        const uint8_t alpha = (i / 4) % 3 ? 255 : 64;
+        rgba.data[i + 0] = ((i / 4) % 300) * alpha / 300;
+        rgba.data[i + 1] = ((i / 4) / 300) * alpha / 300;
+        rgba.data[i + 2] = 0;
+        rgba.data[i + 3] = alpha;
+    }
+
+    // The encoder stores unpremultiplied pixels and decoding premultiplies them again, so every
+    // compression level must give back exactly that, regardless of how the rows were filtered.
+    PremultipliedImage copy(rgba.size);
+    std::copy(rgba.data.get(), rgba.data.get() + rgba.bytes(), copy.data.get());
+    const PremultipliedImage expected = util::premultiply(util::unpremultiply(std::move(copy)));
+
+    // An opaque and a translucent pixel, for reference.
+    const std::size_t opaque = 4 * 299;
+    EXPECT_EQ(254, expected.data[opaque + 0]);
+    EXPECT_EQ(255, expected.data[opaque + 3]);
+    const std::size_t translucent = 4 * (150 * 300 + 150);
+    EXPECT_EQ(32, expected.data[translucent + 0]);
+    EXPECT_EQ(32, expected.data[translucent + 1]);
+    EXPECT_EQ(64, expected.data[translucent + 3]);
+
+    WorkStealingThreadPool pool { 4 };
+    for (int level = 0; level <= 9; level += 3) {
+        PNGEncodeOptions options;
+        options.compressionLevel = level;
+        options.scheduler = &pool;
+
+        PremultipliedImage image = decodeImage(encodePNG(rgba, options));
+        ASSERT_EQ(rgba.size, image.size) << level;
+        EXPECT_TRUE(std::equal(image.data.get(), image.data.get() + image.bytes(),
+                               expected.data.get())) << level;
+    }
+}
+
 TEST(Image, PNGReadNoProfile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/no_profile.png"));
     EXPECT_EQ(128, image.data[0]);
@@ -7,6 +7,8 @@
 
 #include <mbgl/util/offscreen_texture.hpp>
 
+#include <cstring>
+
 using namespace mbgl;
 
 TEST(OffscreenTexture, EmptyRed) {
@@ -21,6 +23,64 @@ TEST(OffscreenTexture, EmptyRed) {
     test::checkImage("test/fixtures/offscreen_texture/empty-red", image, 0, 0);
 }
 
+TEST(OffscreenTexture, AsyncReadback) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    auto& context = backend.getContext();
+    OffscreenView view(context, { 512, 256 });
+    view.bind();
+
+    std::vector<PremultipliedImage> expected;
+    std::vector<PremultipliedImage> actual;
+
+    const Color colors[] = { Color::red(), Color::green(), Color::blue() };
+    for (const auto& color : colors) {
+        // Give each frame a distinct bottom half, so that a missing flip shows.
+        context.clear(Color::black(), {}, {});
+        MBGL_CHECK_ERROR(glEnable(GL_SCISSOR_TEST));
+        MBGL_CHECK_ERROR(glScissor(0, 0, 512, 128));
+        context.clear(color, {}, {});
+        MBGL_CHECK_ERROR(glDisable(GL_SCISSOR_TEST));
+
+        expected.push_back(view.readStillImage());
+        view.readStillImage([&](PremultipliedImage image) {
+            actual.push_back(std::move(image));
+        });
+    }
+
+    view.flushStillImages();
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i].size, actual[i].size);
+        EXPECT_EQ(0, std::memcmp(expected[i].data.get(), actual[i].data.get(), expected[i].bytes()));
+    }
+}
+
+TEST(OffscreenTexture, AsyncReadbackOnDestruction) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    auto& context = backend.getContext();
+
+    PremultipliedImage expected;
+    optional<PremultipliedImage> actual;
+
+    {
+        OffscreenView view(context, { 512, 256 });
+        view.bind();
+        context.clear(Color::red(), {}, {});
+
+        expected = view.readStillImage();
+        view.readStillImage([&](PremultipliedImage image) {
+            actual = std::move(image);
+        });
+
+        // The view goes away without a flush.
+    }
+
+    ASSERT_TRUE(bool(actual));
+    ASSERT_EQ(expected.size, actual->size);
+    EXPECT_EQ(0, std::memcmp(expected.data.get(), actual->data.get(), expected.bytes()));
+}
+
 struct Shader {
     Shader(const GLchar* vertex, const GLchar* fragment) {
         program = MBGL_CHECK_ERROR(glCreateProgram());
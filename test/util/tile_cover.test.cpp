@@ -2,6 +2,9 @@
 #include <mbgl/util/geo.hpp>
 #include <mbgl/map/transform.hpp>
 
+#include <algorithm>
+#include <set>
+
 #include <gtest/gtest.h>
 
 using namespace mbgl;
@@ -83,3 +86,57 @@ TEST(TileCover, SanFranciscoZ0Wrapped) {
     EXPECT_EQ((std::vector<UnwrappedTileID>{ { 0, 1, 0 } }),
               util::tileCover(sanFranciscoWrapped, 0));
 }
+
+static std::vector<UnwrappedTileID> tileRange(const LatLngBounds& bounds, uint8_t z) {
+    util::TileRange range(bounds, z);
+    std::vector<UnwrappedTileID> result;
+    for (uint64_t i = 0; i < range.size(); ++i) {
+        result.push_back(range[i]);
+    }
+    return result;
+}
+
+TEST(TileRange, Empty) {
+    EXPECT_EQ(0u, util::TileRange(LatLngBounds::empty(), 0).size());
+    EXPECT_EQ(0u, util::TileRange(LatLngBounds::singleton({ 0, 0 }), 1).size());
+    EXPECT_EQ(0u, util::TileRange(LatLngBounds::hull({ 86, -180 }, { 90, 180 }), 0).size());
+}
+
+TEST(TileRange, World) {
+    EXPECT_EQ((std::vector<UnwrappedTileID>{ { 0, 0, 0 } }), tileRange(LatLngBounds::world(), 0));
+    EXPECT_EQ((std::vector<UnwrappedTileID>{ { 1, 0, 0 }, { 1, 0, 1 }, { 1, 1, 0 }, { 1, 1, 1 } }),
+              tileRange(LatLngBounds::world(), 1));
+    EXPECT_EQ(1u << 20, util::TileRange(LatLngBounds::world(), 10).size());
+}
+
+TEST(TileRange, SanFranciscoZ10) {
+    EXPECT_EQ((std::vector<UnwrappedTileID>{
+                  { 10, 163, 395 }, { 10, 163, 396 }, { 10, 164, 395 }, { 10, 164, 396 },
+              }),
+              tileRange(sanFrancisco, 10));
+}
+
+TEST(TileRange, SanFranciscoZ0Wrapped) {
+    EXPECT_EQ((std::vector<UnwrappedTileID>{ { 0, 1, 0 } }), tileRange(sanFranciscoWrapped, 0));
+}
+
+TEST(TileRange, MatchesTileCover) {
+    const std::vector<LatLngBounds> regions = {
+        sanFrancisco,
+        sanFranciscoWrapped,
+        LatLngBounds::hull({ -33.9, 151.1 }, { -33.8, 151.3 }),
+        LatLngBounds::hull({ 35, -12 }, { 72, 40 }),
+        LatLngBounds::hull({ -60, 100 }, { 10, 200 }),
+    };
+
+    for (const auto& bounds : regions) {
+        for (uint8_t z = 0; z <= 12; ++z) {
+            const auto cover = util::tileCover(bounds, z);
+            const auto range = tileRange(bounds, z);
+            EXPECT_EQ(cover.size(), range.size());
+            EXPECT_EQ(std::set<UnwrappedTileID>(cover.begin(), cover.end()),
+                      std::set<UnwrappedTileID>(range.begin(), range.end()));
+            EXPECT_TRUE(std::is_sorted(range.begin(), range.end()));
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/tracing.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <thread>
+
+using namespace mbgl;
+
+TEST(Tracing, DisabledByDefault) {
+    EXPECT_FALSE(tracing::isEnabled());
+
+    {
+        tracing::Scope scope("test", "ignored");
+    }
+
+    tracing::start();
+    JSDocument document;
+    document.Parse<0>(tracing::stop().c_str());
+    ASSERT_FALSE(document.HasParseError());
+    EXPECT_EQ(0u, document["traceEvents"].Size());
+}
+
+TEST(Tracing, RecordsEventsFromAllThreads) {
+    tracing::start();
+    EXPECT_TRUE(tracing::isEnabled());
+
+    {
+        tracing::Scope scope("test", "main");
+    }
+
+    std::thread thread([] {
+        tracing::Scope scope("test", "other");
+    });
+    thread.join();
+
+    const TimePoint now = Clock::now();
+    tracing::record("test", "explicit", now, now + Milliseconds(2));
+
+    const std::string json = tracing::stop();
+    EXPECT_FALSE(tracing::isEnabled());
+
+    JSDocument document;
+    document.Parse<0>(json.c_str());
+    ASSERT_FALSE(document.HasParseError());
+
+    const JSValue& events = document["traceEvents"];
+    ASSERT_EQ(3u, events.Size());
+
+    EXPECT_STREQ("main", events[0]["name"].GetString());
+    EXPECT_STREQ("other", events[1]["name"].GetString());
+    EXPECT_STREQ("explicit", events[2]["name"].GetString());
+    EXPECT_STREQ("X", events[2]["ph"].GetString());
+    EXPECT_STREQ("test", events[2]["cat"].GetString());
+    EXPECT_DOUBLE_EQ(2000, events[2]["dur"].GetDouble());
+
+    EXPECT_EQ(1u, events[0]["tid"].GetUint64());
+    EXPECT_EQ(2u, events[1]["tid"].GetUint64());
+    EXPECT_EQ(1u, events[2]["tid"].GetUint64());
+}